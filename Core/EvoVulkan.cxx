@@ -16,13 +16,23 @@
 #include "src/EvoVulkan/Types/Texture.cpp"
 #include "src/EvoVulkan/Types/Image.cpp"
 #include "src/EvoVulkan/Types/VmaBuffer.cpp"
+#include "src/EvoVulkan/Types/UploadBatch.cpp"
 
 #include "src/EvoVulkan/Tools/VulkanTools.cpp"
 #include "src/EvoVulkan/Tools/VulkanDebug.cpp"
 #include "src/EvoVulkan/Tools/DeviceTools.cpp"
+#include "src/EvoVulkan/Tools/MipChain.cpp"
 
 #include "src/EvoVulkan/Memory/Allocator.cpp"
+#include "src/EvoVulkan/Memory/DeletionQueue.cpp"
+#include "src/EvoVulkan/Memory/LinearArena.cpp"
+#include "src/EvoVulkan/Memory/StagingRing.cpp"
+#include "src/EvoVulkan/Memory/UniformRing.cpp"
 
 #include "src/EvoVulkan/Complexes/Framebuffer.cpp"
 #include "src/EvoVulkan/Complexes/Shader.cpp"
-#include "src/EvoVulkan/Complexes/Mesh.cpp"
\ No newline at end of file
+#include "src/EvoVulkan/Complexes/Mesh.cpp"
+#include "src/EvoVulkan/Complexes/PresentTarget.cpp"
+#include "src/EvoVulkan/Complexes/TextureStreamer.cpp"
+#include "src/EvoVulkan/Complexes/MipGenerator.cpp"
+#include "src/EvoVulkan/Complexes/Readback.cpp"
\ No newline at end of file
@@ -68,6 +68,13 @@ namespace EvoVulkan::Complexes {
 
     //!=================================================================================================================
 
+    /**
+     * @brief Offscreen render target with a command buffer per frame in flight
+     *
+     * @note Attachments are shared by frames in flight. Frames are submitted to one queue and the external
+     *       dependency of the render pass waits for all commands submitted before (BOTTOM_OF_PIPE as source),
+     *       so the next frame doesn't write attachments while the previous one is still sampling them.
+     */
     class FrameBuffer {
     private:
         uint32_t                  m_width             = 0,
@@ -103,6 +110,8 @@ namespace EvoVulkan::Complexes {
         std::vector<VkClearValue> m_clearValues       = {};
         uint32_t                  m_countClearValues  = 0;
 
+        std::vector<VkCommandBuffer> m_frameCmdBuffs  = {};
+
         bool                      m_depthEnabled      = true;
     public:
         /// \Warn Unsafe access! But it's fast.
@@ -110,6 +119,7 @@ namespace EvoVulkan::Complexes {
 
         VkSemaphore               m_semaphore         = VK_NULL_HANDLE;
 
+        /// command buffer of the frame selected by SetFrame()
         VkCommandBuffer           m_cmdBuff           = VK_NULL_HANDLE;
     public:
         operator VkFramebuffer() const { return m_framebuffer; }
@@ -132,6 +142,8 @@ namespace EvoVulkan::Complexes {
         [[nodiscard]] inline Types::RenderPass GetRenderPass() const noexcept { return m_renderPass; }
         [[nodiscard]] inline VkRect2D GetRenderPassArea()      const noexcept { return { VkOffset2D(), { m_width, m_height } }; }
         [[nodiscard]] inline VkCommandBuffer GetCmd()          const noexcept { return m_cmdBuff; }
+        [[nodiscard]] inline VkCommandBuffer GetCmd(uint32_t frame) const noexcept { return m_frameCmdBuffs[frame % m_frameCmdBuffs.size()]; }
+        [[nodiscard]] inline uint32_t GetCountFrames()         const noexcept { return static_cast<uint32_t>(m_frameCmdBuffs.size()); }
         [[nodiscard]] inline VkSemaphore GetSemaphore()        const noexcept { return m_semaphore; }
         [[nodiscard]] inline VkCommandBuffer* GetCmdRef()      noexcept { return &m_cmdBuff; }
         [[nodiscard]] inline VkSemaphore* GetSemaphoreRef()    noexcept { return &m_semaphore; }
@@ -143,6 +155,11 @@ namespace EvoVulkan::Complexes {
         bool CreateFramebuffer();
         bool CreateSampler();
     public:
+        /// pointers from GetCmdRef() stay valid, they point to the command buffer of the selected frame
+        inline void SetFrame(uint32_t frame) noexcept {
+            m_cmdBuff = GetCmd(frame);
+        }
+
         inline void BeginCmd() {
             vkBeginCommandBuffer(m_cmdBuff, &m_cmdBufInfo);
         }
@@ -173,7 +190,10 @@ namespace EvoVulkan::Complexes {
         void Free();
         bool ReCreate(uint32_t width, uint32_t height);
     public:
-        // depth will be auto added to end array of attachments
+        /**
+         * depth will be auto added to end array of attachments
+         * @param countFrames Frames in flight of the kernel, see VulkanKernel::GetFramesInFlight()
+         */
         static FrameBuffer* Create(
                 Types::Device* device,
                 EvoVulkan::Memory::Allocator* allocator,
@@ -182,7 +202,8 @@ namespace EvoVulkan::Complexes {
                 Types::CmdPool* pool,
                 const std::vector<VkFormat>& colorAttachments,
                 uint32_t width, uint32_t height,
-                float scale = 1.f);
+                float scale = 1.f,
+                uint32_t countFrames = 1);
     };
 }
 
@@ -0,0 +1,105 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_MIPGENERATOR_H
+#define EVOVULKAN_MIPGENERATOR_H
+
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/DescriptorManager.h>
+
+#include <string>
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+}
+
+namespace EvoVulkan::Types {
+    class UploadBatch;
+    struct VmaBuffer;
+}
+
+namespace EvoVulkan::Complexes {
+    /**
+     * @brief Generates the whole mip chain of an image by one compute dispatch (Resources/Shaders/mipmaps.comp)
+     *        instead of a blit and two barriers per level
+     *
+     * @note Images need VK_IMAGE_USAGE_STORAGE_BIT and GetImageFlags(). Formats are written by their UNORM or float
+     *       storage views, so sRGB textures are averaged in linear space and formats without linear blitting are
+     *       supported too. Up to MaxSize texels, render thread only.
+     */
+    class MipGenerator : public Tools::NonCopyable {
+        /// storage format and pipeline compiled for it
+        struct Variant {
+            VkFormat    m_format   = VK_FORMAT_UNDEFINED;
+            const char* m_glsl     = nullptr;
+            VkPipeline  m_pipeline = VK_NULL_HANDLE;
+        };
+
+        struct Constants {
+            int32_t  m_width  = 0;
+            int32_t  m_height = 0;
+            uint32_t m_levels = 0;
+            uint32_t m_groups = 0;
+            uint32_t m_srgb   = 0;
+        };
+    public:
+        static constexpr uint32_t MaxLevels = 13;
+        //! level 6 of the largest image is reduced by one work group
+        static constexpr uint32_t MaxSize   = 4096;
+        static constexpr uint32_t MaxLayers = 6;
+    private:
+        MipGenerator()  = default;
+        ~MipGenerator() = default;
+    public:
+        /**
+         * @param source Path to mipmaps.comp, it's compiled by the glsl compiler of Shader into the cache
+         * @param cache Directory of compiled shaders
+         */
+        static MipGenerator* Create(
+                Types::Device* device,
+                Memory::Allocator* allocator,
+                const std::string& source,
+                const std::string& cache,
+                VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+
+        void Destroy();
+        void Free();
+    public:
+        [[nodiscard]] bool IsSupported(VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount = 1) const;
+
+        /**
+         * @brief Create flags of images which are generated by Record(), usage has to include VK_IMAGE_USAGE_STORAGE_BIT
+         *
+         * @note sRGB images are created with the extended usage, their sampled views must exclude the storage
+         *       usage by VkImageViewUsageCreateInfo
+         */
+        [[nodiscard]] static VkImageCreateFlags GetImageFlags(VkFormat format);
+
+        /**
+         * @brief All levels are in the transfer dst layout before (Types::UploadBatch::CopyToImage()) and in the
+         *        shader read only layout after. Views and the descriptor set are released on completion of the batch
+         */
+        bool Record(Types::UploadBatch* batch, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount = 1);
+    private:
+        [[nodiscard]] const Variant* FindVariant(VkFormat format) const;
+        Core::DescriptorSet AllocateSet();
+        void FreeSet(const Core::DescriptorSet& set);
+    private:
+        Types::Device*                       m_device         = nullptr;
+        Memory::Allocator*                   m_allocator      = nullptr;
+
+        VkDescriptorSetLayout                m_setLayout      = VK_NULL_HANDLE;
+        VkPipelineLayout                     m_pipelineLayout = VK_NULL_HANDLE;
+        std::vector<Variant>                 m_variants       = {};
+
+        //! sets are kept until batches are completed, a new pool is created when all are used
+        std::vector<Core::DescriptorPool*>   m_pools          = {};
+
+        //! completed work groups of every layer, cleared before each dispatch
+        Types::VmaBuffer*                    m_counters       = nullptr;
+
+    };
+}
+
+#endif //EVOVULKAN_MIPGENERATOR_H
@@ -0,0 +1,138 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_PRESENTTARGET_H
+#define EVOVULKAN_PRESENTTARGET_H
+
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Types/Surface.h>
+#include <EvoVulkan/Types/Swapchain.h>
+#include <EvoVulkan/Types/RenderPass.h>
+#include <EvoVulkan/Types/CmdPool.h>
+#include <EvoVulkan/Types/Synchronization.h>
+#include <EvoVulkan/Types/MultisampleTarget.h>
+
+#include <atomic>
+#include <vector>
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+}
+
+namespace EvoVulkan::Complexes {
+    /**
+     * @brief Additional window of the kernel: own surface, swapchain and framebuffers of the kernel render pass
+     *
+     * @note Device, allocator, pipelines and descriptors are shared with the main window. The image is
+     *       acquired in VulkanKernel::PrepareFrame(), the draw command buffer is submitted and presented
+     *       together with the main swapchain in VulkanKernel::SubmitFrame().
+     */
+    class PresentTarget : public Types::IVkObject {
+    public:
+        PresentTarget(const PresentTarget&) = delete;
+    private:
+        PresentTarget()  = default;
+        ~PresentTarget() = default;
+    private:
+        Types::Device*              m_device         = nullptr;
+        Memory::Allocator*          m_allocator      = nullptr;
+        Types::CmdPool*             m_cmdPool        = nullptr;
+        Types::Surface*             m_surface        = nullptr;
+        Types::Swapchain*           m_swapchain      = nullptr;
+        Types::MultisampleTarget*   m_multisample    = nullptr;
+        //! owned by the kernel
+        Types::RenderPass           m_renderPass     = { };
+        bool                        m_multisampling  = false;
+
+        std::vector<VkFramebuffer>  m_frameBuffers   = {};
+        VkCommandBuffer*            m_drawCmdBuffs   = nullptr;
+        uint32_t                    m_countDCB       = 0;
+
+        //! per frame in flight
+        std::vector<Types::Synchronization> m_frameSyncs = {};
+        //! per swapchain image, frame fence of the kernel which is using this image now
+        std::vector<VkFence>        m_imagesInFlight = {};
+
+        Types::Synchronization      m_syncs          = {};
+        VkSubmitInfo                m_submitInfo     = {};
+        VkPipelineStageFlags        m_waitStage      = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+        uint32_t                    m_currentBuffer  = 0;
+        //! image of the current frame is acquired and has to be presented
+        bool                        m_acquired       = false;
+
+        //! frame counter of the kernel at the moment of the last re-setup
+        uint64_t                    m_retireFrame    = 0;
+
+        //! set from the window thread, surface extent is used if it's defined
+        std::atomic<bool>           m_outOfDate      = false;
+        std::atomic<uint32_t>       m_newWidth       = 0;
+        std::atomic<uint32_t>       m_newHeight      = 0;
+    private:
+        bool ReCreateFrameBuffers();
+        void DestroyFrameBuffers();
+    public:
+        /**
+         * @param surface Initialized surface, the target owns it even if creation fails
+         * @param renderPass Render pass of the kernel, color format of the surface must be compatible
+         */
+        static PresentTarget* Create(
+                const VkInstance& instance,
+                Types::Device* device,
+                Memory::Allocator* allocator,
+                Types::CmdPool* cmdPool,
+                Types::Surface* surface,
+                const Types::RenderPass& renderPass,
+                VkFormat colorFormat,
+                bool multisampling,
+                bool vsync,
+                VkPresentModeKHR presentMode,
+                uint32_t countImages,
+                uint8_t framesInFlight,
+                uint32_t width,
+                uint32_t height);
+    public:
+        /// any thread, the swapchain is re-created at the next frame
+        void SetSize(uint32_t width, uint32_t height);
+
+        /// result of the combined present of the kernel, out of date swapchain is re-created at the next frame
+        void MarkPresented(VkResult result) {
+            if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+                m_outOfDate = true;
+            m_acquired = false;
+        }
+
+        [[nodiscard]] bool IsOutOfDate() const { return m_outOfDate; }
+        [[nodiscard]] bool IsAcquired()  const { return m_acquired;  }
+
+        /// waits images in flight, then re-creates the swapchain and framebuffers. Draw command buffers have to be rebuilt
+        bool ReSetup(uint64_t frameCounter);
+
+        /// skips the frame if the surface is collapsed or out of date, see IsAcquired()
+        VkResult Acquire(uint32_t frameIndex, VkFence frameFence, uint64_t frameCounter, uint8_t framesInFlight);
+
+        /// submit of the draw command buffer of the acquired image, valid until the next Acquire()
+        [[nodiscard]] const VkSubmitInfo& GetSubmitInfo() const { return m_submitInfo; }
+        [[nodiscard]] VkSemaphore GetRenderComplete() const { return m_syncs.m_renderComplete; }
+
+        [[nodiscard]] Types::Swapchain* GetSwapchain() const { return m_swapchain; }
+        [[nodiscard]] Types::Surface* GetSurface() const { return m_surface; }
+        [[nodiscard]] VkCommandBuffer* GetDrawCmdBuffs() const { return m_drawCmdBuffs; }
+        [[nodiscard]] VkFramebuffer* GetFrameBuffers() { return m_frameBuffers.data(); }
+        [[nodiscard]] uint32_t GetCountDrawCmdBuffs() const { return m_countDCB; }
+        [[nodiscard]] uint32_t GetCurrentBuffer() const { return m_currentBuffer; }
+        [[nodiscard]] uint32_t GetWidth()  const { return m_swapchain->GetSurfaceWidth();  }
+        [[nodiscard]] uint32_t GetHeight() const { return m_swapchain->GetSurfaceHeight(); }
+
+        [[nodiscard]] VkViewport GetViewport() const;
+        [[nodiscard]] VkRect2D GetScissor() const;
+
+        [[nodiscard]] bool IsReady() const override;
+
+        void Destroy() override;
+        void Free() override;
+    };
+}
+
+#endif //EVOVULKAN_PRESENTTARGET_H
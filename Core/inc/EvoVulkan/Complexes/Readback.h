@@ -0,0 +1,131 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_READBACK_H
+#define EVOVULKAN_READBACK_H
+
+#include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <thread>
+#include <deque>
+
+namespace EvoVulkan::Complexes {
+    class FrameBuffer;
+
+    /// tightly packed rows of the image, m_pixels is empty on failure
+    struct ReadbackResult {
+        std::vector<uint8_t> m_pixels  = {};
+        VkFormat             m_format  = VK_FORMAT_UNDEFINED;
+        uint32_t             m_width   = 0;
+        uint32_t             m_height  = 0;
+        bool                 m_success = false;
+    };
+
+    /// called on a worker thread before the callback, may change pixels and format
+    typedef std::function<void(ReadbackResult& result)> ReadbackConvert;
+    /// called on a worker thread, also with a failed result if the readback is destroyed before completion
+    typedef std::function<void(ReadbackResult&& result)> ReadbackCallback;
+
+    /// color image with VK_IMAGE_USAGE_TRANSFER_SRC_BIT, sizes are sizes of the mip level
+    struct ReadbackRequest {
+        VkImage         m_image    = VK_NULL_HANDLE;
+        VkFormat        m_format   = VK_FORMAT_UNDEFINED;
+        uint32_t        m_width    = 0;
+        uint32_t        m_height   = 0;
+        /// layout of the image when the copy starts, it is restored after the copy
+        VkImageLayout   m_layout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        uint32_t        m_mipLevel = 0;
+        uint32_t        m_layer    = 0;
+        ReadbackConvert m_convert  = ReadbackConvert();
+
+        /// color attachment of the framebuffer, it must be rendered by the frame of the readback
+        static ReadbackRequest Attachment(const FrameBuffer* frameBuffer, uint32_t id);
+    };
+
+    /// swaps red and blue channels of B8G8R8A8 images (swapchain formats), other formats stay as is
+    void ConvertBGRAToRGBA(ReadbackResult& result);
+
+    /**
+     * @brief Copies images to host cached memory without waiting for the queue, the pixels are
+     *        given to a callback or a future frames in flight later
+     *
+     * @note Record() and Update() are called from the render thread. The copy is recorded into a command
+     *       buffer of the frame, which must run after the work that writes the image. Update() passes
+     *       completed copies to worker threads, they invalidate and convert the pixels.
+     */
+    class Readback : public Tools::NonCopyable {
+        struct Staging {
+            VkBuffer      m_buffer     = VK_NULL_HANDLE;
+            VmaAllocation m_allocation = VK_NULL_HANDLE;
+            uint8_t*      m_mapped     = nullptr;
+            VkDeviceSize  m_size       = 0;
+        };
+
+        struct Job {
+            uint64_t         m_frame    = 0;
+            //! tightly packed bytes of the copy, the staging buffer may be larger
+            VkDeviceSize     m_size     = 0;
+            Staging          m_staging  = {};
+            ReadbackResult   m_result   = {};
+            ReadbackConvert  m_convert  = ReadbackConvert();
+            ReadbackCallback m_callback = ReadbackCallback();
+        };
+    private:
+        Readback()  = default;
+        ~Readback() = default;
+    public:
+        /// @param countThreads Conversion threads, at least one
+        static Readback* Create(Types::Device* device, Memory::Allocator* allocator, uint32_t countThreads = 1);
+
+        /// GPU must be idle, pending requests are completed with a failed result
+        void Destroy();
+        void Free();
+    public:
+        /**
+         * @param cmd Command buffer in the recording state
+         * @param frame Frame of the submit, the request is completed by Update() with this frame or later
+         */
+        bool Record(VkCommandBuffer cmd, uint64_t frame, const ReadbackRequest& request, ReadbackCallback&& callback);
+        std::future<ReadbackResult> Record(VkCommandBuffer cmd, uint64_t frame, const ReadbackRequest& request);
+
+        /// copies of all frames up to completed frame inclusive are given to the workers
+        void Update(uint64_t completedFrame);
+
+        /// copies of the frame whose command buffer won't be submitted, they are completed with a failed result
+        void Discard(uint64_t frame);
+
+        /// staging buffers kept for the next requests
+        void SetMaxFreeBuffers(uint32_t count) { m_maxFreeBuffers = count; }
+
+        [[nodiscard]] uint32_t GetCountPending() const { return static_cast<uint32_t>(m_recorded.size()); }
+    private:
+        void WorkerLoop();
+        bool AcquireStaging(VkDeviceSize size, Staging& staging);
+        void ReleaseStaging(Staging& staging);
+        void DestroyStaging(Staging& staging);
+    private:
+        Types::Device*          m_device         = nullptr;
+        Memory::Allocator*      m_allocator      = nullptr;
+
+        uint32_t                m_maxFreeBuffers = 4;
+
+        //! render thread only, in the order of frames
+        std::deque<Job>         m_recorded       = {};
+
+        std::vector<std::thread> m_workers       = {};
+        std::mutex              m_mutex          = std::mutex();
+        std::condition_variable m_condition      = std::condition_variable();
+        bool                    m_stop           = false;
+        //! guarded by m_mutex
+        std::deque<Job>         m_completed      = {};
+        std::vector<Staging>    m_freeBuffers    = {};
+
+    };
+}
+
+#endif //EVOVULKAN_READBACK_H
@@ -89,6 +89,10 @@ namespace EvoVulkan::Complexes {
         static void SetGlslCompiler(const std::string& glslc) {
             g_glslc = glslc;
         }
+
+        [[nodiscard]] static const std::string& GetGlslCompiler() {
+            return g_glslc;
+        }
     public:
         operator VkPipeline() const {
             return m_pipeline;
@@ -0,0 +1,212 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_TEXTURESTREAMER_H
+#define EVOVULKAN_TEXTURESTREAMER_H
+
+#include <EvoVulkan/Types/Texture.h>
+#include <EvoVulkan/Types/UploadBatch.h>
+#include <EvoVulkan/Memory/DeletionQueue.h>
+
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <deque>
+
+namespace EvoVulkan::Types {
+    class CmdPool;
+}
+
+namespace EvoVulkan::Complexes {
+    class TextureStreamer;
+    class MipGenerator;
+
+    /**
+     * @brief Result of a decoder: either pixels in its own memory, or texels written into MapStaging()
+     *
+     * @note Set format and sizes before MapStaging(), the span is sized for them. Staged texels are used
+     *       instead of m_pixels if both are given.
+     */
+    struct StreamImage {
+        friend class TextureStreamer;
+    public:
+        /// Tools::GetImageSize() bytes of upload memory, nullptr on failure. May wait for space in the staging ring
+        uint8_t* MapStaging();
+    public:
+        const uint8_t*                      m_pixels      = nullptr;
+        /// called when the pixels are staged (e.g. stbi_image_free), nullptr - pixels aren't owned by the image
+        std::function<void(const uint8_t*)> m_release     = std::function<void(const uint8_t*)>();
+
+        VkFormat                            m_format      = VK_FORMAT_R8G8B8A8_UNORM;
+        uint32_t                            m_width       = 0;
+        uint32_t                            m_height      = 0;
+        /// 0 - full chain
+        uint32_t                            m_mipLevels   = 1;
+        VkFilter                            m_filter      = VK_FILTER_LINEAR;
+        /// mips are generated by the mip generator of the streamer (SetMipGenerator()) instead of blits
+        bool                                m_computeMips = false;
+    private:
+        Memory::Allocator*                  m_allocator   = nullptr;
+        Types::UploadBatch::DetachedStaging m_staging     = {};
+    };
+
+    /// called on a worker thread, returns false if the image can't be decoded
+    typedef std::function<bool(StreamImage& image)> StreamDecoder;
+
+    /**
+     * @brief Handle of a streamed texture, it samples the placeholder until the image is uploaded
+     *
+     * @note Owned by the streamer, release it with TextureStreamer::Release(). Render thread only.
+     */
+    class StreamedTexture : public Tools::NonCopyable {
+        friend class TextureStreamer;
+    public:
+        enum class State : uint8_t {
+            Decoding = 0, Decoded = 1, Uploading = 2, Ready = 3, Failed = 4
+        };
+    private:
+        StreamedTexture()  = default;
+        ~StreamedTexture() = default;
+    private:
+        TextureStreamer*      m_streamer      = nullptr;
+        StreamDecoder         m_decoder       = StreamDecoder();
+        StreamImage           m_image         = StreamImage();
+
+        std::atomic<State>    m_state         = State::Decoding;
+        //! released by the owner while the decoder or the upload is running
+        std::atomic<bool>     m_released      = false;
+
+        Types::Texture*       m_texture       = nullptr;
+        //! placeholder until the texture is ready
+        VkDescriptorImageInfo m_descriptor    = {};
+        Core::DescriptorSet   m_descriptorSet = {};
+        uint32_t              m_binding       = 0;
+        //! incremented when the descriptor is swapped
+        uint32_t              m_version       = 0;
+
+        std::function<void(StreamedTexture*)> m_onComplete = std::function<void(StreamedTexture*)>();
+    public:
+        [[nodiscard]] State GetState() const { return m_state; }
+        [[nodiscard]] bool IsReady() const { return m_state == State::Ready; }
+        [[nodiscard]] bool IsFailed() const { return m_state == State::Failed; }
+
+        /// nullptr until the texture is ready
+        [[nodiscard]] Types::Texture* GetTexture() const { return m_texture; }
+        [[nodiscard]] VkDescriptorImageInfo* GetDescriptorRef() { return &m_descriptor; }
+
+        /// command buffers and descriptor sets written with an older version have to be rebuilt
+        [[nodiscard]] uint32_t GetVersion() const { return m_version; }
+
+        /**
+         * @brief Set with a combined image sampler at the binding, it's re-allocated when the descriptor is
+         *        swapped, the old set is freed when frames which could use it are completed
+         */
+        Core::DescriptorSet GetDescriptorSet(VkDescriptorSetLayout layout, uint32_t binding = 0);
+    };
+
+    /**
+     * @brief Decodes images on worker threads and uploads them in the background, a handle is returned at once
+     *
+     * @note Load(), Update() and Release() are called from the render thread. Update() records decoded images
+     *       into upload batches within the budget and submits them without waiting, completed batches swap
+     *       descriptors of their handles. Copies are done on the dedicated transfer queue if there is one.
+     */
+    class TextureStreamer : public Tools::NonCopyable {
+        friend class StreamedTexture;
+
+        /// upload batch and textures which are uploaded by it, they are given to the handles on completion
+        struct Upload {
+            Types::UploadBatch*                                       m_batch    = nullptr;
+            std::vector<std::pair<StreamedTexture*, Types::Texture*>> m_textures = {};
+        };
+    private:
+        TextureStreamer()  = default;
+        ~TextureStreamer() = default;
+    public:
+        /**
+         * @param framesInFlight Frames which can use a released texture or descriptor set
+         * @param countThreads Decoding threads, 0 - hardware concurrency - 1
+         * @param placeholder Sampled until textures are ready, owned by the caller. nullptr - 1x1 grey texture
+         */
+        static TextureStreamer* Create(
+                Types::Device* device,
+                Memory::Allocator* allocator,
+                Core::DescriptorManager* manager,
+                Types::CmdPool* pool,
+                Types::CmdPool* transferPool,
+                uint8_t framesInFlight,
+                uint32_t countThreads = 0,
+                Types::Texture* placeholder = nullptr);
+
+        /// GPU must be idle, all handles are destroyed
+        void Destroy();
+        void Free();
+    public:
+        /// @param onComplete Called by Update() when the texture is ready or has failed, optional
+        StreamedTexture* Load(StreamDecoder&& decoder, std::function<void(StreamedTexture*)>&& onComplete = nullptr);
+
+        /// the texture is destroyed when frames which could use it are completed
+        void Release(StreamedTexture* handle);
+
+        /**
+         * @brief Once per frame after the frame fence is waited (VulkanKernel::PrepareFrame()),
+         *        completes finished uploads and submits decoded images
+         */
+        void Update();
+
+        /// max bytes of pixels staged by one Update(), at least one image is staged anyway
+        void SetUploadBudget(VkDeviceSize bytes) { m_budget = bytes; }
+
+        /// used by images with StreamImage::m_computeMips, owned by the caller
+        void SetMipGenerator(MipGenerator* generator) { m_mipGenerator = generator; }
+
+        [[nodiscard]] Types::Texture* GetPlaceholder() const { return m_placeholder; }
+        [[nodiscard]] uint32_t GetCountPending() const { return m_countPending; }
+    private:
+        void WorkerLoop();
+        bool SubmitDecoded();
+        void CompleteUploads();
+        void Complete(StreamedTexture* handle, Types::Texture* texture);
+        /// handle, its texture and descriptor set are destroyed frames in flight later
+        void Delete(StreamedTexture* handle);
+        void DeferredFree(Types::Texture* texture);
+        static void ReleaseImage(StreamedTexture* handle);
+    private:
+        Types::Device*                m_device         = nullptr;
+        Memory::Allocator*            m_allocator      = nullptr;
+        Core::DescriptorManager*      m_manager        = nullptr;
+        Types::CmdPool*               m_pool           = nullptr;
+        Types::CmdPool*               m_transferPool   = nullptr;
+
+        Types::Texture*               m_placeholder    = nullptr;
+        MipGenerator*                 m_mipGenerator   = nullptr;
+        bool                          m_ownPlaceholder = false;
+
+        uint8_t                       m_framesInFlight = 2;
+        VkDeviceSize                  m_budget         = 16 * 1024 * 1024;
+        //! loaded handles which aren't completed yet
+        uint32_t                      m_countPending   = 0;
+
+        std::vector<std::thread>      m_workers        = {};
+        std::mutex                    m_mutex          = std::mutex();
+        std::condition_variable       m_condition      = std::condition_variable();
+        bool                          m_stop           = false;
+        //! guarded by m_mutex
+        std::deque<StreamedTexture*>  m_jobs           = {};
+        std::deque<StreamedTexture*>  m_decoded        = {};
+
+        std::vector<Upload>           m_uploads        = {};
+        //! completed batches, reused by the next uploads
+        std::vector<Types::UploadBatch*> m_freeBatches = {};
+        std::vector<StreamedTexture*> m_handles        = {};
+
+        //! count of Update() calls, released objects are destroyed frames in flight later
+        uint64_t                      m_updateCounter  = 0;
+        Memory::DeletionQueue         m_deletionQueue  = {};
+
+    };
+}
+
+#endif //EVOVULKAN_TEXTURESTREAMER_H
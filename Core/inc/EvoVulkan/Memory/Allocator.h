@@ -10,12 +10,16 @@
 #include <EvoVulkan/Tools/NonCopyable.h>
 #include <EvoVulkan/Types/Image.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace EvoVulkan::Types {
     class Device;
 }
 
 namespace EvoVulkan::Memory {
     class Allocator;
+    class StagingRing;
 
     struct Buffer {
         VkBuffer m_buffer;
@@ -41,6 +45,11 @@ namespace EvoVulkan::Memory {
     };
 
     class Allocator : public Tools::NonCopyable {
+    public:
+        /// buffers up to this size are sub-allocated from pools of small buffers
+        static constexpr VkDeviceSize SmallBufferSize      = 64 * 1024;
+        static constexpr VkDeviceSize SmallBufferBlockSize = 4 * 1024 * 1024;
+
     private:
         explicit Allocator(Types::Device* device)
             : m_device(device)
@@ -63,9 +72,22 @@ namespace EvoVulkan::Memory {
         Types::Image AllocImage(const VkImageCreateInfo& info, bool CPUUsage);
         void FreeImage(Types::Image& image);
 
+        /**
+         * @brief Pool of small uniform or vertex/index buffers of the memory type, created on the first use.
+         *        nullptr - the buffer is large or of another usage, it goes to default VMA blocks
+         *
+         * @note Thread safe. Small buffers of one kind share blocks of SmallBufferBlockSize, so they don't
+         *       fragment large blocks and their count isn't limited by maxMemoryAllocationCount
+         */
+        VmaPool GetSmallBufferPool(const VkBufferCreateInfo& info, VkMemoryPropertyFlags flags);
+
         RawMemory AllocateMemory(VkMemoryAllocateInfo memoryAllocateInfo);
         bool FreeMemory(RawMemory* memory);
 
+        /// persistent upload memory shared by upload batches, nullptr if it isn't created
+        bool CreateStagingRing(VkDeviceSize capacity);
+        [[nodiscard]] StagingRing* GetStagingRing() const { return m_stagingRing; }
+
         [[nodiscard]] uint64_t GetGPUMemoryUsage() const;
         [[nodiscard]] uint64_t GetCPUMemoryUsage() const;
         [[nodiscard]] uint64_t GetAllocatedMemorySize() const { return m_deviceMemoryAllocSize; }
@@ -77,6 +99,11 @@ namespace EvoVulkan::Memory {
     private:
         Types::Device* m_device       = nullptr;
         VmaAllocator   m_vmaAllocator = VK_NULL_HANDLE;
+        StagingRing*   m_stagingRing  = nullptr;
+
+        //! memory type and kind of buffers -> pool
+        std::unordered_map<uint32_t, VmaPool> m_smallBufferPools = {};
+        std::mutex                            m_poolsMutex       = std::mutex();
 
         uint64_t       m_deviceMemoryAllocSize   = 0;
         uint32_t       m_allocHeapsCount         = 0;
@@ -0,0 +1,54 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_DELETIONQUEUE_H
+#define EVOVULKAN_DELETIONQUEUE_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+#include <functional>
+#include <vector>
+#include <mutex>
+
+namespace EvoVulkan::Memory {
+    /**
+     * @brief Destroys objects only after the GPU has passed the frame of their last use
+     *
+     * @note Frames are values of a monotonic counter (kernel frame counter or timeline value)
+     */
+    class DeletionQueue : public Tools::NonCopyable {
+    public:
+        typedef std::function<void()> Deleter;
+
+        struct Entry {
+            uint64_t m_frame   = 0;
+            Deleter  m_deleter = Deleter();
+        };
+
+    public:
+        DeletionQueue() = default;
+        ~DeletionQueue() = default;
+
+    public:
+        /// thread safe, object will be destroyed when the frame is completed
+        void Push(uint64_t frame, Deleter&& deleter);
+
+        /// destroys objects of all frames up to completed frame inclusive
+        void Collect(uint64_t completedFrame);
+
+        /// destroys everything, GPU must be idle
+        void Flush();
+
+        [[nodiscard]] size_t GetCount() const;
+
+    private:
+        mutable std::mutex m_mutex     = std::mutex();
+        std::vector<Entry> m_entries   = {};
+        /// collecting thread only
+        std::vector<Entry> m_collected = {};
+
+    };
+}
+
+#endif //EVOVULKAN_DELETIONQUEUE_H
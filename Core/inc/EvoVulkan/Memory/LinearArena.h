@@ -0,0 +1,62 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_LINEARARENA_H
+#define EVOVULKAN_LINEARARENA_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace EvoVulkan::Memory {
+    /**
+     * @brief Bump allocator for transient CPU data of one frame
+     *
+     * @note Memory is released all at once by Reset(). If a frame doesn't fit, the rest goes to
+     *       separate blocks and the arena grows on the next Reset(), so a steady state doesn't touch the heap.
+     */
+    class LinearArena : public Tools::NonCopyable {
+    private:
+        explicit LinearArena(size_t capacity)
+            : m_capacity(capacity)
+        { }
+
+        ~LinearArena() = default;
+
+    public:
+        static LinearArena* Create(size_t capacity);
+
+    public:
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /// uninitialized storage, destructors are never called
+        template<typename T> T* Allocate(size_t count = 1) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena doesn't call destructors!");
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /// all pointers of the arena become invalid
+        void Reset();
+
+        [[nodiscard]] size_t GetCapacity() const { return m_capacity; }
+        [[nodiscard]] size_t GetUsed()     const { return m_required; }
+
+        void Destroy();
+        void Free();
+
+    private:
+        uint8_t*           m_data     = nullptr;
+        size_t             m_capacity = 0;
+        size_t             m_offset   = 0;
+        /// total size requested since the last reset, including overflow blocks
+        size_t             m_required = 0;
+        std::vector<void*> m_overflow = {};
+
+    };
+}
+
+#endif //EVOVULKAN_LINEARARENA_H
@@ -0,0 +1,124 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_STAGINGRING_H
+#define EVOVULKAN_STAGINGRING_H
+
+#include <EvoVulkan/macros.h>
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+#include <deque>
+#include <mutex>
+
+namespace EvoVulkan::Types {
+    class Device;
+}
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+
+    /**
+     * @brief Persistently mapped upload buffer, sub-allocated as a ring and retired by a timeline semaphore
+     *
+     * @note Allocations of an owner (an upload batch) are closed together by Submit(), which gives them the
+     *       next value of the timeline, the submit of the owner must signal it. Memory is reused when the value
+     *       is reached, if the ring is full Allocate() waits for the oldest submitted owner.
+     */
+    class StagingRing : public Tools::NonCopyable {
+    public:
+        struct Allocation {
+            VkBuffer     m_buffer = VK_NULL_HANDLE;
+            VkDeviceSize m_offset = 0;
+            void*        m_data   = nullptr;
+
+            [[nodiscard]] bool Valid() const { return m_data; }
+        };
+
+    private:
+        struct Region {
+            //! nullptr - cancelled, can be reused at once
+            const void*  m_owner = nullptr;
+            VkDeviceSize m_begin = 0;
+            //! head of the ring after this allocation
+            VkDeviceSize m_end   = 0;
+            //! 0 - not submitted yet
+            uint64_t     m_value = 0;
+        };
+
+    private:
+        StagingRing() = default;
+        ~StagingRing() = default;
+
+    public:
+        /// requires timeline semaphores
+        static StagingRing* Create(Types::Device* device, Allocator* allocator, VkDeviceSize capacity);
+
+        void Destroy();
+        void Free();
+
+    public:
+        /**
+         * @brief Thread safe. Fails if the size is larger than the ring, or it is occupied by owners which
+         *        aren't submitted yet, or the wait is timed out. The caller falls back to a dedicated buffer.
+         */
+        Allocation Allocate(const void* owner, VkDeviceSize size, VkDeviceSize alignment = 16, uint64_t timeout = UINT64_MAX);
+
+        /**
+         * @brief Closes allocations of the owner and calls submit(timeline, value) under the lock, so values
+         *        are signaled in increasing order. Non-coherent memory is flushed before it.
+         */
+        template<typename Submit> VkResult Submit(const void* owner, const Submit& submit) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const uint64_t value = m_value + 1;
+            if (!Close(owner, value))
+                return submit(VkSemaphore(VK_NULL_HANDLE), uint64_t(0));
+
+            auto result = submit(m_timeline, value);
+            if (result == VK_SUCCESS)
+                m_value = value;
+            else
+                Discard(value);
+
+            return result;
+        }
+
+        /// allocations of an owner which has failed before its submit
+        void Cancel(const void* owner);
+
+        /// allocations of an owner are given to another one, e.g. memory filled by a decoder to the batch uploading it
+        void Transfer(const void* from, const void* to);
+
+        [[nodiscard]] VkDeviceSize GetCapacity() const { return m_capacity; }
+        [[nodiscard]] VkBuffer GetBuffer() const { return m_buffer; }
+
+    private:
+        bool Close(const void* owner, uint64_t value);
+        void Discard(uint64_t value);
+        void Reclaim();
+        [[nodiscard]] bool TryAllocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) const;
+
+    private:
+        Types::Device*     m_device     = nullptr;
+        Allocator*         m_allocator  = nullptr;
+
+        VkBuffer           m_buffer     = VK_NULL_HANDLE;
+        VmaAllocation      m_allocation = VK_NULL_HANDLE;
+        uint8_t*           m_mapped     = nullptr;
+        VkDeviceSize       m_capacity   = 0;
+        bool               m_coherent   = true;
+
+        VkSemaphore        m_timeline   = VK_NULL_HANDLE;
+        //! last submitted value
+        uint64_t           m_value      = 0;
+
+        //! in order of allocation, the front begins the used part of the ring, the back ends it
+        std::deque<Region> m_regions    = {};
+
+        mutable std::mutex m_mutex      = std::mutex();
+
+    };
+}
+
+#endif //EVOVULKAN_STAGINGRING_H
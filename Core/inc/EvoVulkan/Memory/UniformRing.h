@@ -0,0 +1,90 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_UNIFORMRING_H
+#define EVOVULKAN_UNIFORMRING_H
+
+#include <EvoVulkan/macros.h>
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+#include <atomic>
+#include <cstring>
+
+namespace EvoVulkan::Types {
+    class Device;
+}
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+
+    /**
+     * @brief Persistently mapped uniform memory of frames in flight, bound by one VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+     *        descriptor. Objects write their uniforms every frame and pass the offset to vkCmdBindDescriptorSets()
+     *
+     * @note Every frame in flight owns a segment, BeginFrame() rewinds it after the fence of the frame is waited.
+     *       Memory is host coherent, there is nothing to flush. Allocate() is lock-free, recording workers can use it.
+     */
+    class UniformRing : public Tools::NonCopyable {
+    public:
+        struct Allocation {
+            //! dynamic offset of the descriptor, from the beginning of the buffer
+            uint32_t m_offset = 0;
+            void*    m_data   = nullptr;
+
+            [[nodiscard]] bool Valid() const { return m_data; }
+        };
+
+    private:
+        UniformRing() = default;
+        ~UniformRing() = default;
+
+    public:
+        /// @param frameSize Bytes of uniforms per frame, the buffer is frameSize * countFrames
+        static UniformRing* Create(Types::Device* device, Allocator* allocator, VkDeviceSize frameSize, uint32_t countFrames);
+
+        void Destroy();
+        void Free();
+
+    public:
+        /// the previous use of the segment is completed by the GPU
+        void BeginFrame(uint32_t frame);
+
+        /// aligned to minUniformBufferOffsetAlignment, invalid if the segment of the frame is full
+        Allocation Allocate(VkDeviceSize size);
+
+        template<typename T> Allocation Push(const T& value) {
+            Allocation allocation = Allocate(sizeof(T));
+            if (allocation.Valid())
+                memcpy(allocation.m_data, &value, sizeof(T));
+            return allocation;
+        }
+
+        /// range is the largest uniform block read through the descriptor, up to maxUniformBufferRange
+        [[nodiscard]] VkDescriptorBufferInfo GetDescriptorInfo(VkDeviceSize range) const { return { m_buffer, 0, range }; }
+
+        [[nodiscard]] VkBuffer GetBuffer() const { return m_buffer; }
+        [[nodiscard]] VkDeviceSize GetFrameSize() const { return m_frameSize; }
+        [[nodiscard]] VkDeviceSize GetUsed() const { return m_head.load(std::memory_order_relaxed); }
+
+    private:
+        Types::Device*            m_device      = nullptr;
+        Allocator*                m_allocator   = nullptr;
+
+        VkBuffer                  m_buffer      = VK_NULL_HANDLE;
+        VmaAllocation             m_allocation  = VK_NULL_HANDLE;
+        uint8_t*                  m_mapped      = nullptr;
+
+        VkDeviceSize              m_frameSize   = 0;
+        VkDeviceSize              m_alignment   = 256;
+        uint32_t                  m_countFrames = 0;
+
+        //! beginning of the segment of the current frame
+        VkDeviceSize              m_base        = 0;
+        //! used bytes of the segment, may exceed the frame size after a failed allocation
+        std::atomic<VkDeviceSize> m_head        = 0;
+
+    };
+}
+
+#endif //EVOVULKAN_UNIFORMRING_H
@@ -16,6 +16,17 @@ namespace EvoVulkan::Tools {
             const std::vector<const char*>& extensions);
 
     bool IsBetterThan(const VkPhysicalDevice& _new, const VkPhysicalDevice& _old);
+
+    bool IsTimelineSemaphoreSupported(const VkPhysicalDevice& physicalDevice);
+
+    /// core since vulkan 1.2, but still optional
+    bool IsBufferDeviceAddressSupported(const VkPhysicalDevice& physicalDevice);
+
+    /// VK_KHR_present_id and VK_KHR_present_wait extensions and features
+    bool IsPresentWaitSupported(const VkPhysicalDevice& physicalDevice);
+
+    /// VK_EXT_host_image_copy with its dependencies (VK_KHR_copy_commands2, VK_KHR_format_feature_flags2) and feature
+    bool IsHostImageCopySupported(const VkPhysicalDevice& physicalDevice);
 }
 
 #endif //EVOVULKAN_DEVICETOOLS_H
@@ -0,0 +1,126 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_HEAPGUARD_H
+#define EVOVULKAN_HEAPGUARD_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+namespace EvoVulkan::Tools {
+    /**
+     * @brief Counter of global heap allocations of the guarded threads
+     *
+     * @note Counts only if the application has replaced global operators new with
+     *       EVK_HEAP_GUARD_OPERATORS, see VulkanKernel::SetHeapGuard(). All forms are counted:
+     *       scalar, array, aligned and nothrow. Threads are guarded by SetGuarded(), the kernel
+     *       guards the thread which renders frames, recording workers and readback workers.
+     */
+    class HeapGuard {
+    public:
+        HeapGuard()                 = delete;
+        HeapGuard(const HeapGuard&) = delete;
+        ~HeapGuard()                = delete;
+    public:
+        /// shared by all guarded threads, a frame compares it before and after rendering
+        static inline std::atomic<uint64_t> Allocations = 0;
+        static inline thread_local bool     Guarded     = false;
+
+    public:
+        static void SetGuarded(bool guarded) noexcept { Guarded = guarded; }
+
+        static void* Allocate(std::size_t size) noexcept {
+            if (Guarded)
+                Allocations.fetch_add(1, std::memory_order_relaxed);
+
+            return std::malloc(size ? size : 1);
+        }
+
+        static void* AllocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+            if (Guarded)
+                Allocations.fetch_add(1, std::memory_order_relaxed);
+
+            const auto align = static_cast<std::size_t>(alignment);
+        #ifdef _WIN32
+            return _aligned_malloc(size ? size : 1, align);
+        #else
+            /// size of aligned_alloc must be a multiple of the alignment
+            return std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+        #endif
+        }
+
+        static void Free(void* memory) noexcept { std::free(memory); }
+
+        static void FreeAligned(void* memory) noexcept {
+        #ifdef _WIN32
+            _aligned_free(memory);
+        #else
+            std::free(memory);
+        #endif
+        }
+    };
+}
+
+/// must be placed in exactly one translation unit of the application
+#define EVK_HEAP_GUARD_OPERATORS                                                                                            \
+    void* operator new(std::size_t size) {                                                                                  \
+        if (void* memory = EvoVulkan::Tools::HeapGuard::Allocate(size))                                                     \
+            return memory;                                                                                                  \
+        throw std::bad_alloc();                                                                                             \
+    }                                                                                                                       \
+    void* operator new[](std::size_t size) {                                                                                \
+        if (void* memory = EvoVulkan::Tools::HeapGuard::Allocate(size))                                                     \
+            return memory;                                                                                                  \
+        throw std::bad_alloc();                                                                                             \
+    }                                                                                                                       \
+    void* operator new(std::size_t size, std::align_val_t alignment) {                                                      \
+        if (void* memory = EvoVulkan::Tools::HeapGuard::AllocateAligned(size, alignment))                                   \
+            return memory;                                                                                                  \
+        throw std::bad_alloc();                                                                                             \
+    }                                                                                                                       \
+    void* operator new[](std::size_t size, std::align_val_t alignment) {                                                    \
+        if (void* memory = EvoVulkan::Tools::HeapGuard::AllocateAligned(size, alignment))                                   \
+            return memory;                                                                                                  \
+        throw std::bad_alloc();                                                                                             \
+    }                                                                                                                       \
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept {                                                  \
+        return EvoVulkan::Tools::HeapGuard::Allocate(size);                                                                 \
+    }                                                                                                                       \
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {                                                \
+        return EvoVulkan::Tools::HeapGuard::Allocate(size);                                                                 \
+    }                                                                                                                       \
+    void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {                      \
+        return EvoVulkan::Tools::HeapGuard::AllocateAligned(size, alignment);                                               \
+    }                                                                                                                       \
+    void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {                    \
+        return EvoVulkan::Tools::HeapGuard::AllocateAligned(size, alignment);                                               \
+    }                                                                                                                       \
+    void operator delete(void* memory) noexcept { EvoVulkan::Tools::HeapGuard::Free(memory); }                              \
+    void operator delete[](void* memory) noexcept { EvoVulkan::Tools::HeapGuard::Free(memory); }                            \
+    void operator delete(void* memory, std::size_t) noexcept { EvoVulkan::Tools::HeapGuard::Free(memory); }                 \
+    void operator delete[](void* memory, std::size_t) noexcept { EvoVulkan::Tools::HeapGuard::Free(memory); }               \
+    void operator delete(void* memory, const std::nothrow_t&) noexcept { EvoVulkan::Tools::HeapGuard::Free(memory); }       \
+    void operator delete[](void* memory, const std::nothrow_t&) noexcept { EvoVulkan::Tools::HeapGuard::Free(memory); }     \
+    void operator delete(void* memory, std::align_val_t) noexcept { EvoVulkan::Tools::HeapGuard::FreeAligned(memory); }     \
+    void operator delete[](void* memory, std::align_val_t) noexcept { EvoVulkan::Tools::HeapGuard::FreeAligned(memory); }   \
+    void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {                                            \
+        EvoVulkan::Tools::HeapGuard::FreeAligned(memory);                                                                   \
+    }                                                                                                                       \
+    void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {                                          \
+        EvoVulkan::Tools::HeapGuard::FreeAligned(memory);                                                                   \
+    }                                                                                                                       \
+    void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {                                  \
+        EvoVulkan::Tools::HeapGuard::FreeAligned(memory);                                                                   \
+    }                                                                                                                       \
+    void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {                                \
+        EvoVulkan::Tools::HeapGuard::FreeAligned(memory);                                                                   \
+    }                                                                                                                       \
+
+#endif //EVOVULKAN_HEAPGUARD_H
@@ -0,0 +1,63 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_MIPCHAIN_H
+#define EVOVULKAN_MIPCHAIN_H
+
+#include <EvoVulkan/macros.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace EvoVulkan::Tools {
+    enum class MipFilter : uint8_t {
+        /// 2x2 average, the same as a linear blit
+        Box = 0,
+        /// 6x6 Kaiser windowed sinc, sharper levels without aliasing
+        Kaiser = 1
+    };
+
+    struct MipChainInfo {
+        MipFilter m_filter       = MipFilter::Box;
+        /// texels are averaged in linear space and encoded back
+        bool      m_srgb         = false;
+        /// > 0 - alpha of every level is scaled to keep the coverage of alpha tested level 0 (foliage, fences)
+        float     m_alphaCutoff  = 0.f;
+        /// 0 - full chain
+        uint32_t  m_mipLevels    = 0;
+        /// 0 - hardware concurrency, small levels are always generated by the calling thread
+        uint32_t  m_countThreads = 0;
+    };
+
+    /// level of tightly packed texels, the offset is relative to the data of the chain
+    struct MipLevel {
+        uint32_t     m_width  = 0;
+        uint32_t     m_height = 0;
+        VkDeviceSize m_offset = 0;
+        VkDeviceSize m_size   = 0;
+    };
+
+    /// RGBA8 levels one after another, level 0 is a copy of the source
+    struct MipChain {
+        std::vector<uint8_t>  m_data   = {};
+        std::vector<MipLevel> m_levels = {};
+
+        [[nodiscard]] const uint8_t* GetLevelData(uint32_t level) const { return m_data.data() + m_levels[level].m_offset; }
+        [[nodiscard]] bool Valid() const { return !m_levels.empty(); }
+    };
+
+    /**
+     * @brief Generates mip levels of RGBA8 pixels on the CPU, for textures whose format can't be blitted on the GPU
+     *        (BCn) and for offline baking. The result feeds a compressor level by level or Texture::LoadLevels().
+     *
+     * @note Kernels use AVX2 if the CPU supports it, otherwise SSE2 (scalar on other architectures).
+     *       Rows of large levels are split between worker threads.
+     */
+    bool GenerateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, const MipChainInfo& info, MipChain& chain);
+
+    /// true if the AVX2 kernels are used, for logs and benchmarks
+    bool IsMipChainAVX2();
+}
+
+#endif //EVOVULKAN_MIPCHAIN_H
@@ -0,0 +1,80 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_SPSCQUEUE_H
+#define EVOVULKAN_SPSCQUEUE_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+namespace EvoVulkan::Tools {
+    /**
+     * @brief Lock-free ring for one producer thread and one consumer thread
+     *
+     * @note Capacity must be a power of two, one slot is always kept free
+     */
+    template<typename T, uint32_t Capacity> class SPSCQueue : public NonCopyable {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two!");
+    public:
+        SPSCQueue() = default;
+        ~SPSCQueue() = default;
+
+    public:
+        /// producer side, returns false if the queue is full
+        bool Push(T&& value) {
+            const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            const uint32_t next = (tail + 1) & (Capacity - 1);
+
+            if (next == m_head.load(std::memory_order_acquire))
+                return false;
+
+            m_data[tail] = std::move(value);
+            m_tail.store(next, std::memory_order_release);
+            m_tail.notify_one();
+
+            return true;
+        }
+
+        /// consumer side, returns false if the queue is empty
+        bool Pop(T& value) {
+            const uint32_t head = m_head.load(std::memory_order_relaxed);
+
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            value = std::move(m_data[head]);
+            m_head.store((head + 1) & (Capacity - 1), std::memory_order_release);
+
+            return true;
+        }
+
+        /// consumer side, blocks while the queue is empty
+        void Wait() const {
+            m_tail.wait(m_head.load(std::memory_order_relaxed), std::memory_order_acquire);
+        }
+
+        /// producer side
+        [[nodiscard]] bool Full() const {
+            const uint32_t next = (m_tail.load(std::memory_order_relaxed) + 1) & (Capacity - 1);
+            return next == m_head.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool Empty() const {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        /// head and tail are written by different threads, keep them in different cache lines
+        alignas(64) std::atomic<uint32_t> m_head = 0;
+        alignas(64) std::atomic<uint32_t> m_tail = 0;
+
+        std::array<T, Capacity>           m_data = {};
+
+    };
+}
+
+#endif //EVOVULKAN_SPSCQUEUE_H
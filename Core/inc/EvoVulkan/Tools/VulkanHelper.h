@@ -11,6 +11,7 @@
 
 #include <cstring>
 #include <cmath>
+#include <algorithm>
 
 #include <EvoVulkan/Tools/VulkanInitializers.h>
 #include <EvoVulkan/Tools/VulkanConverter.h>
@@ -173,6 +174,36 @@ namespace EvoVulkan::Tools {
             func(instance, debugMessenger, pAllocator);
     }
 
+    /// preferred mode if it is supported, otherwise the closest one by latency and tearing. FIFO is always supported
+    static VkPresentModeKHR GetPresentMode(const VkPhysicalDevice& physicalDevice, const VkSurfaceKHR& surface, VkPresentModeKHR preferred) {
+        uint32_t presentModeCount = 0;
+        if (vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, NULL) != VK_SUCCESS) {
+            Tools::VkDebug::Error("VulkanTools::GetPresentMode() : failed get physical device surface present modes! (count)");
+            return VK_PRESENT_MODE_MAX_ENUM_KHR;
+        }
+
+        std::vector<VkPresentModeKHR> presentModes(presentModeCount);
+        if (vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, &presentModes[0]) != VK_SUCCESS) {
+            Tools::VkDebug::Error("VulkanTools::GetPresentMode() : failed get physical device surface present modes! (data)");
+            return VK_PRESENT_MODE_MAX_ENUM_KHR;
+        }
+
+        std::vector<VkPresentModeKHR> fallbacks;
+        switch (preferred) {
+            case VK_PRESENT_MODE_MAILBOX_KHR:      fallbacks = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR };      break;
+            case VK_PRESENT_MODE_IMMEDIATE_KHR:    fallbacks = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR };      break;
+            case VK_PRESENT_MODE_FIFO_RELAXED_KHR: fallbacks = { VK_PRESENT_MODE_FIFO_RELAXED_KHR };                                break;
+            default:
+                break;
+        }
+
+        for (auto&& mode : fallbacks)
+            if (std::find(presentModes.begin(), presentModes.end(), mode) != presentModes.end())
+                return mode;
+
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
     static VkPresentModeKHR GetPresentMode(const VkPhysicalDevice& physicalDevice, const VkSurfaceKHR& surface, bool vsync) {
         uint32_t presentModeCount = 0;
         if (vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, NULL) != VK_SUCCESS) {
@@ -383,6 +383,19 @@ namespace EvoVulkan::Tools::Initializers {
         return cmdBufferBeginInfo;
     }
 
+    static VkCommandBufferInheritanceInfo CommandBufferInheritanceInfo(
+            VkRenderPass renderPass,
+            uint32_t subpass,
+            VkFramebuffer framebuffer)
+    {
+        VkCommandBufferInheritanceInfo inheritanceInfo {};
+        inheritanceInfo.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass  = renderPass;
+        inheritanceInfo.subpass     = subpass;
+        inheritanceInfo.framebuffer = framebuffer;
+        return inheritanceInfo;
+    }
+
     static VkPipelineColorBlendStateCreateInfo PipelineColorBlendStateCreateInfo(
             uint32_t attachmentCount,
             const VkPipelineColorBlendAttachmentState * pAttachments)
@@ -57,6 +57,76 @@ namespace EvoVulkan::Tools::Insert {
                 0, nullptr,
                 1, &barrier);
     }
+
+    /**
+     * @brief Half of a queue family ownership transfer, the same barrier has to be recorded on both queues
+     *
+     * @note Release (on the source queue) ignores dst_access_mask and dst_stage_mask, acquire (on the
+     *       destination queue) ignores the source ones. Layouts must match in both halves.
+     */
+    static void ImageOwnershipBarrier(
+            VkCommandBuffer command_buffer,
+            VkImage image,
+            uint32_t src_queue_family,
+            uint32_t dst_queue_family,
+            VkAccessFlags src_access_mask,
+            VkAccessFlags dst_access_mask,
+            VkImageLayout old_layout,
+            VkImageLayout new_layout,
+            VkPipelineStageFlags src_stage_mask,
+            VkPipelineStageFlags dst_stage_mask,
+            VkImageSubresourceRange subresource_range) {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = src_queue_family;
+        barrier.dstQueueFamilyIndex = dst_queue_family;
+        barrier.srcAccessMask = src_access_mask;
+        barrier.dstAccessMask = dst_access_mask;
+        barrier.oldLayout = old_layout;
+        barrier.newLayout = new_layout;
+        barrier.image = image;
+        barrier.subresourceRange = subresource_range;
+
+        vkCmdPipelineBarrier(
+                command_buffer,
+                src_stage_mask,
+                dst_stage_mask,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier);
+    }
+
+    static void BufferOwnershipBarrier(
+            VkCommandBuffer command_buffer,
+            VkBuffer buffer,
+            uint32_t src_queue_family,
+            uint32_t dst_queue_family,
+            VkAccessFlags src_access_mask,
+            VkAccessFlags dst_access_mask,
+            VkPipelineStageFlags src_stage_mask,
+            VkPipelineStageFlags dst_stage_mask,
+            VkDeviceSize offset = 0,
+            VkDeviceSize size = VK_WHOLE_SIZE) {
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = src_queue_family;
+        barrier.dstQueueFamilyIndex = dst_queue_family;
+        barrier.srcAccessMask = src_access_mask;
+        barrier.dstAccessMask = dst_access_mask;
+        barrier.buffer = buffer;
+        barrier.offset = offset;
+        barrier.size = size;
+
+        vkCmdPipelineBarrier(
+                command_buffer,
+                src_stage_mask,
+                dst_stage_mask,
+                0,
+                0, nullptr,
+                1, &barrier,
+                0, nullptr);
+    }
 }
 
 #endif //EVOVULKAN_VULKANINSERT_H
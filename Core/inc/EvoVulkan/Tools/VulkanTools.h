@@ -17,12 +17,15 @@
 
 #include <EvoVulkan/Tools/VulkanInitializers.h>
 #include <EvoVulkan/Tools/VulkanHelper.h>
+#include <EvoVulkan/Tools/VulkanInsert.h>
 
 #include <vulkan/vulkan.h>
 #include <string>
 #include <vector>
 #include <array>
 #include <mutex>
+#include <numeric>
+#include <algorithm>
 
 #include <EvoVulkan/Tools/VulkanConverter.h>
 
@@ -98,6 +101,8 @@ namespace EvoVulkan::Tools {
 
     Types::Synchronization CreateSynchronization(const VkDevice& device);
 
+    VkSemaphore CreateTimelineSemaphore(const VkDevice& device, uint64_t initialValue = 0);
+
     static VkResult CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDebugUtilsMessengerEXT* pDebugMessenger) {
         auto func = (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
         if (func != nullptr) {
@@ -149,7 +154,7 @@ namespace EvoVulkan::Tools {
         Tools::VkDebug::Graph("VulkanTools::CreateLogicalDevice() : create vulkan logical device...");
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-        std::set<uint32_t> uniqueQueueFamilies = { pQueues->GetGraphicsIndex(), pQueues->GetPresentIndex() };
+        std::set<uint32_t> uniqueQueueFamilies = { pQueues->GetGraphicsIndex(), pQueues->GetPresentIndex(), pQueues->GetComputeIndex(), pQueues->GetTransferIndex() };
 
         std::vector<float_t> queuePriorities = { 1.0f }; //, 1.0f
         for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -174,9 +179,51 @@ namespace EvoVulkan::Tools {
 
         //!==========
 
+        /// timeline semaphores are core since vulkan 1.2, but still optional
+        VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {};
+        timelineFeatures.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timelineFeatures.timelineSemaphore = Tools::IsTimelineSemaphoreSupported(physicalDevice);
+
+        /// VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, the allocator allocates memory for it if it's enabled
+        VkPhysicalDeviceBufferDeviceAddressFeatures addressFeatures = {};
+        addressFeatures.sType               = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+        addressFeatures.bufferDeviceAddress = Tools::IsBufferDeviceAddressSupported(physicalDevice);
+
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        /// enabled only if CreateDevice() has added the extensions
+        VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+        presentWaitFeatures.sType       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        presentWaitFeatures.presentWait = VK_TRUE;
+
+        VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+        presentIdFeatures.sType     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        presentIdFeatures.presentId = VK_TRUE;
+        presentIdFeatures.pNext     = &presentWaitFeatures;
+
+        for (auto&& extension : extensions)
+            if (std::string(extension) == VK_KHR_PRESENT_WAIT_EXTENSION_NAME)
+                addressFeatures.pNext = &presentIdFeatures;
+#endif
+
+        timelineFeatures.pNext = &addressFeatures;
+
         VkDeviceCreateInfo createInfo      = {};
         createInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         //createInfo.pNext                   = (void*)&deviceFeatures2;
+        createInfo.pNext                   = &timelineFeatures;
+
+#ifdef VK_EXT_host_image_copy
+        /// enabled only if CreateDevice() has added the extension
+        VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures = {};
+        hostImageCopyFeatures.sType         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+        hostImageCopyFeatures.hostImageCopy = VK_TRUE;
+
+        for (auto&& extension : extensions)
+            if (std::string(extension) == VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME) {
+                hostImageCopyFeatures.pNext = createInfo.pNext;
+                createInfo.pNext = &hostImageCopyFeatures;
+            }
+#endif
 
         createInfo.queueCreateInfoCount    = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos       = queueCreateInfos.data();
@@ -288,15 +335,177 @@ namespace EvoVulkan::Tools {
         return results;
     }
 
+    /// bytes of a texel or of a 4x4 block of compressed formats, 0 - unknown format
+    static VkDeviceSize GetFormatBlockSize(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_R8_UNORM:
+            case VK_FORMAT_R8_SNORM:
+            case VK_FORMAT_R8_UINT:
+            case VK_FORMAT_R8_SINT:
+            case VK_FORMAT_R8_SRGB:
+            case VK_FORMAT_S8_UINT:
+                return 1;
+
+            case VK_FORMAT_R8G8_UNORM:
+            case VK_FORMAT_R8G8_SNORM:
+            case VK_FORMAT_R8G8_UINT:
+            case VK_FORMAT_R8G8_SINT:
+            case VK_FORMAT_R8G8_SRGB:
+            case VK_FORMAT_R16_UNORM:
+            case VK_FORMAT_R16_SNORM:
+            case VK_FORMAT_R16_UINT:
+            case VK_FORMAT_R16_SINT:
+            case VK_FORMAT_R16_SFLOAT:
+            case VK_FORMAT_R5G6B5_UNORM_PACK16:
+            case VK_FORMAT_B5G6R5_UNORM_PACK16:
+            case VK_FORMAT_R4G4B4A4_UNORM_PACK16:
+            case VK_FORMAT_B4G4R4A4_UNORM_PACK16:
+            case VK_FORMAT_R5G5B5A1_UNORM_PACK16:
+            case VK_FORMAT_B5G5R5A1_UNORM_PACK16:
+            case VK_FORMAT_A1R5G5B5_UNORM_PACK16:
+            case VK_FORMAT_D16_UNORM:
+                return 2;
+
+            case VK_FORMAT_R8G8B8_UNORM:
+            case VK_FORMAT_R8G8B8_SNORM:
+            case VK_FORMAT_R8G8B8_UINT:
+            case VK_FORMAT_R8G8B8_SINT:
+            case VK_FORMAT_R8G8B8_SRGB:
+            case VK_FORMAT_B8G8R8_UNORM:
+            case VK_FORMAT_B8G8R8_SNORM:
+            case VK_FORMAT_B8G8R8_UINT:
+            case VK_FORMAT_B8G8R8_SINT:
+            case VK_FORMAT_B8G8R8_SRGB:
+                return 3;
+
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SNORM:
+            case VK_FORMAT_R8G8B8A8_UINT:
+            case VK_FORMAT_R8G8B8A8_SINT:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SNORM:
+            case VK_FORMAT_B8G8R8A8_UINT:
+            case VK_FORMAT_B8G8R8A8_SINT:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+            case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+            case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+            case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+            case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+            case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+            case VK_FORMAT_R16G16_UNORM:
+            case VK_FORMAT_R16G16_SNORM:
+            case VK_FORMAT_R16G16_UINT:
+            case VK_FORMAT_R16G16_SINT:
+            case VK_FORMAT_R16G16_SFLOAT:
+            case VK_FORMAT_R32_UINT:
+            case VK_FORMAT_R32_SINT:
+            case VK_FORMAT_R32_SFLOAT:
+            case VK_FORMAT_X8_D24_UNORM_PACK32:
+            case VK_FORMAT_D32_SFLOAT:
+                return 4;
+
+            case VK_FORMAT_R16G16B16_UNORM:
+            case VK_FORMAT_R16G16B16_SNORM:
+            case VK_FORMAT_R16G16B16_UINT:
+            case VK_FORMAT_R16G16B16_SINT:
+            case VK_FORMAT_R16G16B16_SFLOAT:
+                return 6;
+
+            case VK_FORMAT_R16G16B16A16_UNORM:
+            case VK_FORMAT_R16G16B16A16_SNORM:
+            case VK_FORMAT_R16G16B16A16_UINT:
+            case VK_FORMAT_R16G16B16A16_SINT:
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+            case VK_FORMAT_R32G32_UINT:
+            case VK_FORMAT_R32G32_SINT:
+            case VK_FORMAT_R32G32_SFLOAT:
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+            case VK_FORMAT_BC4_SNORM_BLOCK:
+            case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+            case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+            case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+            case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+            case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+            case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+                return 8;
+
+            case VK_FORMAT_R32G32B32_UINT:
+            case VK_FORMAT_R32G32B32_SINT:
+            case VK_FORMAT_R32G32B32_SFLOAT:
+                return 12;
+
+            case VK_FORMAT_R32G32B32A32_UINT:
+            case VK_FORMAT_R32G32B32A32_SINT:
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+            case VK_FORMAT_BC2_UNORM_BLOCK:
+            case VK_FORMAT_BC2_SRGB_BLOCK:
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+            case VK_FORMAT_BC5_SNORM_BLOCK:
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+            case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+            case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+            case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+            case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+            case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+            case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+                return 16;
+
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * @brief Offset alignment of buffer to image copies of the format: vkCmdCopyBufferToImage requires
+     *        a multiple of the texel (block) size and of 4, optimalBufferCopyOffsetAlignment is the fast path
+     */
+    static VkDeviceSize GetStagingAlignment(const Types::Device* device, VkFormat format) {
+        VkDeviceSize blockSize = GetFormatBlockSize(format);
+        if (blockSize == 0)
+            blockSize = 16;
+
+        const VkDeviceSize alignment = std::lcm(blockSize, VkDeviceSize(4));
+
+        return device ? std::lcm(alignment, std::max<VkDeviceSize>(device->GetCopyOffsetAlignment(), 1)) : alignment;
+    }
+
+    /// bytes of one level of one layer, tightly packed, 0 - unknown format (see GetFormatBlockSize())
+    static VkDeviceSize GetImageSize(VkFormat format, uint32_t width, uint32_t height) {
+        const VkDeviceSize blockSize = GetFormatBlockSize(format);
+
+        /// compressed formats of the table have 4x4 blocks
+        if (format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_ASTC_4x4_SRGB_BLOCK)
+            return VkDeviceSize((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+
+        return VkDeviceSize(width) * height * blockSize;
+    }
+
     static VkImageView CreateImageView(
             const VkDevice& device,
             VkImage image,
             VkFormat format,
             uint32_t mipLevels,
             VkImageAspectFlags imageAspectFlags,
-            bool cubeMap = false) {
+            bool cubeMap = false,
+            VkImageUsageFlags usage = 0) {
         VkImageView view = VK_NULL_HANDLE;
 
+        /// 0 - the usage of the image, images with VK_IMAGE_CREATE_EXTENDED_USAGE_BIT need the usage of the format
+        VkImageViewUsageCreateInfo usageCI = {};
+        usageCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO;
+        usageCI.usage = usage;
+
         VkImageViewCreateInfo viewCI           = Tools::Initializers::ImageViewCreateInfo();
         viewCI.image                           = image;
         viewCI.viewType                        = cubeMap ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_2D;
@@ -308,6 +517,7 @@ namespace EvoVulkan::Tools {
         viewCI.subresourceRange.baseArrayLayer = 0;
         viewCI.subresourceRange.layerCount     = cubeMap ? 6 : 1;
         viewCI.subresourceRange.levelCount     = mipLevels;
+        viewCI.pNext                           = usage ? &usageCI : nullptr;
 
         if (vkCreateImageView(device, &viewCI, nullptr, &view) != VK_SUCCESS) {
             VK_ERROR("Tools::CreateImageView() : failed to create image view!");
@@ -389,17 +599,15 @@ namespace EvoVulkan::Tools {
         return image;
     }*/
 
-    static bool TransitionImageLayout(
-            Types::CmdBuffer* copyCmd,
+    /// records the barrier only, the command buffer must be in the recording state
+    static bool RecordTransitionImageLayout(
+            VkCommandBuffer cmd,
             VkImage image,
             VkImageLayout oldLayout,
             VkImageLayout newLayout,
             uint32_t mipLevels,
             uint32_t layerCount = 1)
     {
-        if (!copyCmd->IsBegin())
-            copyCmd->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-
         VkImageMemoryBarrier barrier = {};
         barrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.oldLayout            = oldLayout;
@@ -449,7 +657,7 @@ namespace EvoVulkan::Tools {
         }
 
         vkCmdPipelineBarrier(
-                *copyCmd,
+                cmd,
                 sourceStage, destinationStage,
                 0,
                 0, nullptr,
@@ -457,9 +665,103 @@ namespace EvoVulkan::Tools {
                 1, &barrier
         );
 
+        return true;
+    }
+
+    static bool TransitionImageLayout(
+            Types::CmdBuffer* copyCmd,
+            VkImage image,
+            VkImageLayout oldLayout,
+            VkImageLayout newLayout,
+            uint32_t mipLevels,
+            uint32_t layerCount = 1)
+    {
+        if (!copyCmd->IsBegin())
+            copyCmd->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+        if (!RecordTransitionImageLayout(*copyCmd, image, oldLayout, newLayout, mipLevels, layerCount))
+            return false;
+
         return copyCmd->End();
     }
 
+    /**
+     * @brief Records blits of the whole mip chain, all levels are in the transfer dst layout before
+     *        and in the shader read only layout after
+     *
+     * @note Format must support linear blitting, the queue must support graphics
+     */
+    static void RecordGenerateMipmaps(
+            VkCommandBuffer cmd,
+            VkImage image,
+            int32_t width,
+            int32_t height,
+            uint32_t mipLevels,
+            uint32_t layerCount = 1)
+    {
+        VkImageSubresourceRange subresourceRange = {
+                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel   = 0,
+                .levelCount     = 1,
+                .baseArrayLayer = 0,
+                .layerCount     = layerCount
+        };
+
+        for (uint32_t i = 1; i < mipLevels; i++) {
+            subresourceRange.baseMipLevel = i - 1;
+
+            Tools::Insert::ImageMemoryBarrier(
+                    cmd,
+                    image,
+                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    subresourceRange);
+
+            {
+                VkImageBlit blit{};
+                blit.srcOffsets[0] = {0, 0, 0};
+                blit.srcOffsets[1] = {width, height, 1};
+                blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                blit.srcSubresource.mipLevel = i - 1;
+                blit.srcSubresource.baseArrayLayer = 0;
+                blit.srcSubresource.layerCount = layerCount;
+                blit.dstOffsets[0] = {0, 0, 0};
+                blit.dstOffsets[1] = { width > 1 ? width / 2 : 1, height > 1 ? height / 2 : 1, 1 };
+                blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                blit.dstSubresource.mipLevel = i;
+                blit.dstSubresource.baseArrayLayer = 0;
+                blit.dstSubresource.layerCount = layerCount;
+
+                vkCmdBlitImage(cmd,
+                               image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1, &blit,
+                               VK_FILTER_LINEAR);
+            }
+
+            Tools::Insert::ImageMemoryBarrier(
+                    cmd,
+                    image,
+                    VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                    subresourceRange);
+
+            if (width > 1)  width  /= 2;
+            if (height > 1) height /= 2;
+        }
+
+        subresourceRange.baseMipLevel = mipLevels - 1;
+        Tools::Insert::ImageMemoryBarrier(
+                cmd,
+                image,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                subresourceRange);
+    }
+
     static Types::Device* CreateDevice(
             Types::Instance* instance, const Types::Surface* surface,
             const std::vector<const char*>& extensions,
@@ -487,7 +789,8 @@ namespace EvoVulkan::Tools {
             Tools::VkDebug::Log("VulkanTools::CreateDevice() : found device - " + Tools::GetDeviceName(device));
 
         for (auto physDev : devices) {
-            if (Tools::IsDeviceSuitable(physDev, (*surface), extensions)) {
+            /// surface is nullptr in headless mode
+            if (Tools::IsDeviceSuitable(physDev, surface ? (VkSurfaceKHR)(*surface) : VK_NULL_HANDLE, extensions)) {
                 if (physicalDevice == VK_NULL_HANDLE) {
                     physicalDevice = physDev;
                     continue;
@@ -515,6 +818,29 @@ namespace EvoVulkan::Tools {
         else
             Tools::VkDebug::Log("VulkanTools::CreateDevice() : select \"" + Tools::GetDeviceName(physicalDevice) + "\" device.");
 
+        /// present wait is optional, it is used for frame latency limit
+        auto deviceExtensions = extensions;
+        bool presentWait      = false;
+        bool hostImageCopy    = false;
+
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+        if (surface && Tools::IsPresentWaitSupported(physicalDevice)) {
+            deviceExtensions.emplace_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+            deviceExtensions.emplace_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+            presentWait = true;
+        }
+#endif
+
+#ifdef VK_EXT_host_image_copy
+        /// optional, small textures are uploaded by the CPU without staging and submission
+        if (Tools::IsHostImageCopySupported(physicalDevice)) {
+            deviceExtensions.emplace_back(VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME);
+            deviceExtensions.emplace_back(VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME);
+            deviceExtensions.emplace_back(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME);
+            hostImageCopy = true;
+        }
+#endif
+
         queues = Types::FamilyQueues::Find(physicalDevice, surface);
         if (!queues->IsComplete()) {
             Tools::VkDebug::Error("VulkanTools::CreateDevice() : family queues isn't complete!");
@@ -533,7 +859,7 @@ namespace EvoVulkan::Tools {
         logicalDevice = Tools::CreateLogicalDevice(
                 physicalDevice,
                 queues,
-                extensions,
+                deviceExtensions,
                 validationLayers,
                 deviceFeatures);
 
@@ -552,6 +878,20 @@ namespace EvoVulkan::Tools {
 
             queues->SetQueue(graphics);
             //queues->SetPresentQueue(present);
+
+            VkQueue compute = VK_NULL_HANDLE;
+            vkGetDeviceQueue(logicalDevice, queues->GetComputeIndex(), 0, &compute);
+            queues->SetComputeQueue(compute);
+
+            if (queues->IsComputeDedicated())
+                Tools::VkDebug::Log("VulkanTools::CreateDevice() : found dedicated compute queue family " + std::to_string(queues->GetComputeIndex()));
+
+            VkQueue transfer = VK_NULL_HANDLE;
+            vkGetDeviceQueue(logicalDevice, queues->GetTransferIndex(), 0, &transfer);
+            queues->SetTransferQueue(transfer);
+
+            if (queues->IsTransferDedicated())
+                Tools::VkDebug::Log("VulkanTools::CreateDevice() : found dedicated transfer queue family " + std::to_string(queues->GetTransferIndex()));
         }
 
         Types::EvoDeviceCreateInfo createInfo = {
@@ -561,7 +901,9 @@ namespace EvoVulkan::Tools {
                 queues,
                 enableSampleShading,
                 multisampling,
-                static_cast<int32_t>(sampleCount)
+                static_cast<int32_t>(sampleCount),
+                presentWait,
+                hostImageCopy
         };
 
         if (auto finallyDevice = Types::Device::Create(createInfo)) {
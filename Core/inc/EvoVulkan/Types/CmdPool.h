@@ -19,13 +19,24 @@ namespace EvoVulkan::Types {
         CmdPool()  = default;
         ~CmdPool() = default;
     private:
-        VkCommandPool m_pool   = VK_NULL_HANDLE;
-        Device*       m_device = nullptr;
+        VkCommandPool            m_pool   = VK_NULL_HANDLE;
+        Device*                  m_device = nullptr;
+        VkCommandPoolCreateFlags m_flags  = 0;
+        uint32_t                 m_family = 0;
     public:
         static CmdPool* Create(Device* device);
+        static CmdPool* Create(Device* device, VkCommandPoolCreateFlags flags);
+        /// command buffers of the pool can be submitted only to queues of this family
+        static CmdPool* Create(Device* device, VkCommandPoolCreateFlags flags, uint32_t queueFamilyIndex);
     public:
         operator VkCommandPool() const { return m_pool; }
     public:
+        [[nodiscard]] bool IsTransient() const { return m_flags & VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; }
+        [[nodiscard]] uint32_t GetQueueFamilyIndex() const { return m_family; }
+
+        /// resets all command buffers of the pool at once, they must not be in use by the GPU
+        bool Reset(bool releaseResources = false);
+
         [[nodiscard]] bool IsReady() const override;
         void Destroy() override;
         void Free()    override;
@@ -30,6 +30,8 @@ namespace EvoVulkan::Types {
         bool enableSampleShading;
         bool multisampling;
         int32_t sampleCount;
+        bool presentWait = false;
+        bool hostImageCopy = false;
     };
 
     class Device : public Tools::NonCopyable {
@@ -53,14 +55,33 @@ namespace EvoVulkan::Types {
         [[nodiscard]] EVK_INLINE float GetMaxSamplerAnisotropy() const noexcept { return m_maxSamplerAnisotropy;    }
         [[nodiscard]] EVK_INLINE VkQueue GetGraphicsQueue()  const noexcept { return m_familyQueues->m_graphicsQueue;  }
         [[nodiscard]] EVK_INLINE VkQueue GetPresentQueue()  const noexcept { return m_familyQueues->m_presentQueue;  }
+        [[nodiscard]] EVK_INLINE VkQueue GetComputeQueue()  const noexcept { return m_familyQueues->m_computeQueue;  }
+        [[nodiscard]] EVK_INLINE VkQueue GetTransferQueue() const noexcept { return m_familyQueues->m_transferQueue; }
         [[nodiscard]] EVK_INLINE bool MultisampleEnabled()  const noexcept { return m_maxCountMSAASamples != VK_SAMPLE_COUNT_1_BIT;  }
+        [[nodiscard]] EVK_INLINE bool IsTimelineSemaphoreSupported() const noexcept { return m_timelineSemaphores; }
+        [[nodiscard]] EVK_INLINE bool IsBufferDeviceAddressEnabled() const noexcept { return m_bufferDeviceAddress; }
+        [[nodiscard]] EVK_INLINE bool IsPresentWaitEnabled() const noexcept { return m_presentWait; }
+        [[nodiscard]] EVK_INLINE bool IsHostImageCopyEnabled() const noexcept { return m_copyMemoryToImage != nullptr; }
+        [[nodiscard]] EVK_INLINE VkImageLayout GetHostCopyLayout() const noexcept { return m_hostCopyLayout; }
+        [[nodiscard]] EVK_INLINE VkDeviceSize GetHostImageCopyLimit() const noexcept { return m_hostImageCopyLimit; }
         [[nodiscard]] EVK_INLINE Instance* GetInstance() const { return m_instance; }
         [[nodiscard]] EVK_INLINE VkSampleCountFlagBits GetMSAASamples() const { return (VkSampleCountFlagBits)m_maxCountMSAASamples; }
         [[nodiscard]] EVK_INLINE VkPhysicalDeviceMemoryProperties GetMemoryProperties() const { return m_memoryProperties; }
+        [[nodiscard]] EVK_INLINE VkDeviceSize GetUniformBufferAlignment() const noexcept { return m_uniformBufferAlignment; }
+        [[nodiscard]] EVK_INLINE uint32_t GetMaxUniformBufferRange() const noexcept { return m_maxUniformBufferRange; }
+        [[nodiscard]] EVK_INLINE VkDeviceSize GetCopyOffsetAlignment() const noexcept { return m_copyOffsetAlignment; }
 
         [[nodiscard]] FamilyQueues* GetQueues() const;
         [[nodiscard]] bool IsReady() const;
         [[nodiscard]] bool IsSupportLinearBlitting(const VkFormat& imageFormat) const;
+        [[nodiscard]] bool IsSupportHostImageCopy(VkFormat format, VkImageTiling tiling) const;
+
+        /// textures up to this size are uploaded by the CPU if host image copy is enabled, 0 - only CPU usage textures
+        void SetHostImageCopyLimit(VkDeviceSize bytes) { m_hostImageCopyLimit = bytes; }
+
+        /// vkTransitionImageLayoutEXT from undefined and vkCopyMemoryToImageEXT, see IsHostImageCopyEnabled()
+        VkResult TransitionImageLayoutOnHost(VkImage image, VkImageLayout newLayout, const VkImageSubresourceRange& range) const;
+        VkResult CopyMemoryToImage(VkImage image, VkImageLayout layout, const void* const* pixels, const VkBufferImageCopy* regions, uint32_t countRegions) const;
 
         bool Destroy();
 
@@ -78,6 +99,12 @@ namespace EvoVulkan::Types {
 
         VkPhysicalDeviceMemoryProperties m_memoryProperties        = {};
 
+        //! minUniformBufferOffsetAlignment, dynamic offsets are multiples of it
+        VkDeviceSize                     m_uniformBufferAlignment  = 256;
+        uint32_t                         m_maxUniformBufferRange   = 16384;
+        //! optimalBufferCopyOffsetAlignment
+        VkDeviceSize                     m_copyOffsetAlignment     = 1;
+
         std::string                      m_deviceName              = "Unknown";
 
         //! don't use for VkAttachmentDescription
@@ -87,6 +114,20 @@ namespace EvoVulkan::Types {
         //! for deviceFeatures and multisampling
         bool                             m_enableSampleShading     = false;
 
+        //! enabled at logical device creation if supported
+        bool                             m_timelineSemaphores      = false;
+        bool                             m_bufferDeviceAddress     = false;
+        //! VK_KHR_present_id and VK_KHR_present_wait
+        bool                             m_presentWait             = false;
+
+        //! VK_EXT_host_image_copy, nullptr if it isn't enabled
+        PFN_vkVoidFunction               m_copyMemoryToImage       = nullptr;
+        PFN_vkVoidFunction               m_transitionImageLayout   = nullptr;
+        //! layout of textures written by the host, it's sampled in it
+        VkImageLayout                    m_hostCopyLayout          = VK_IMAGE_LAYOUT_UNDEFINED;
+        //! 256x256 RGBA8
+        VkDeviceSize                     m_hostImageCopyLimit      = 256 * 1024;
+
     };
 }
 
@@ -22,9 +22,15 @@ namespace EvoVulkan::Types {
     private:
         int m_iGraphics = -1;
         int m_iPresent  = -1;
+        //! dedicated compute family if there is one, otherwise graphics
+        int m_iCompute  = -1;
+        //! dedicated transfer (DMA) family if there is one, otherwise graphics
+        int m_iTransfer = -1;
     public:
         VkQueue m_graphicsQueue = VK_NULL_HANDLE;
         VkQueue m_presentQueue  = VK_NULL_HANDLE;
+        VkQueue m_computeQueue  = VK_NULL_HANDLE;
+        VkQueue m_transferQueue = VK_NULL_HANDLE;
     public:
         [[nodiscard]] bool IsComplete() const override;
         [[nodiscard]] bool IsReady()    const override;
@@ -37,8 +43,27 @@ namespace EvoVulkan::Types {
             this->m_presentQueue = graphics;
         }
 
+        void SetComputeQueue(const VkQueue& compute) {
+            this->m_computeQueue = compute;
+        }
+
+        void SetTransferQueue(const VkQueue& transfer) {
+            this->m_transferQueue = transfer;
+        }
+
         [[nodiscard]] uint32_t GetGraphicsIndex() const noexcept { return (unsigned int)m_iGraphics; }
         [[nodiscard]] uint32_t GetPresentIndex()  const noexcept { return (unsigned int)m_iPresent;  }
+        [[nodiscard]] uint32_t GetComputeIndex()  const noexcept { return (unsigned int)m_iCompute;  }
+        [[nodiscard]] uint32_t GetTransferIndex() const noexcept { return (unsigned int)m_iTransfer; }
+
+        /// compute work can overlap with rasterization on a separate queue
+        [[nodiscard]] bool IsComputeDedicated() const noexcept { return m_iCompute != m_iGraphics; }
+
+        /// resources written by the transfer queue need a queue family ownership transfer before graphics use
+        [[nodiscard]] bool IsTransferDedicated() const noexcept { return m_iTransfer != m_iGraphics; }
+
+        /// queue of the family, command buffers of a pool are submitted to the queue of its family
+        [[nodiscard]] VkQueue GetQueue(uint32_t familyIndex) const noexcept;
     public:
         static FamilyQueues* Find(const VkPhysicalDevice& device, const Surface* surface);
 
@@ -57,7 +57,7 @@ namespace EvoVulkan::Types {
             attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            attachments[0].finalLayout = swapchain->GetPresentLayout();
 
             if (multisampling) {
                 // This is the frame buffer attachment to where the multisampled image
@@ -69,7 +69,7 @@ namespace EvoVulkan::Types {
                 attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
                 attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
                 attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-                attachments[1].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+                attachments[1].finalLayout = swapchain->GetPresentLayout();
 
                 // Multisampled depth attachment we render to
                 attachments[2].format = swapchain->GetDepthFormat();
@@ -9,6 +9,11 @@
 #include <vector>
 
 #include <EvoVulkan/Types/Base/VulkanObject.h>
+#include <EvoVulkan/Types/Image.h>
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+}
 
 namespace EvoVulkan::Types {
     class Device;
@@ -20,6 +25,14 @@ namespace EvoVulkan::Types {
         VkImageView m_view;
     } SwapChainBuffer;
 
+    /// objects of a previous setup, the presentation engine and frames in flight can still use them
+    struct RetiredSetup {
+        VkSwapchainKHR            m_swapchain = VK_NULL_HANDLE;
+        std::vector<VkImageView>  m_views     = {};
+        /// headless mode
+        std::vector<Types::Image> m_images    = {};
+    };
+
     class Swapchain : public IVkObject {
     public:
         Swapchain(const Swapchain&) = delete;
@@ -34,6 +47,8 @@ namespace EvoVulkan::Types {
         VkFormat         m_depthFormat     = {};
         VkFormat         m_colorFormat     = VK_FORMAT_UNDEFINED;
         VkColorSpaceKHR  m_colorSpace      = VkColorSpaceKHR::VK_COLOR_SPACE_MAX_ENUM_KHR;
+        //! transfer usages are added only if the surface supports them
+        VkImageUsageFlags m_imageUsage     = 0;
 
         //! note: images will be automatic destroyed after destroying swapchain
         VkImage*         m_swapchainImages = nullptr;
@@ -45,23 +60,60 @@ namespace EvoVulkan::Types {
         uint32_t         m_surfaceHeight   = 0;
 
         bool             m_vsync           = false;
+
+        //! applied at the next re-setup, VK_PRESENT_MODE_MAX_ENUM_KHR - choose by vsync
+        VkPresentModeKHR m_requestedPresentMode = VK_PRESENT_MODE_MAX_ENUM_KHR;
+        //! 0 - minimal count + 1
+        uint32_t         m_requestedCountImages = 0;
+
+        //! VK_KHR_present_id, id of the last queued present
+        mutable uint64_t   m_presentId      = 0;
+        //! presents with smaller ids have been queued to the retired swapchains
+        uint64_t           m_firstPresentId = 1;
+        PFN_vkVoidFunction m_waitForPresent = nullptr;
+
+        //! old swapchains, views and headless images after re-setup, frames in flight can still use them
+        std::vector<RetiredSetup> m_retired = {};
+
+        //! headless mode: there are no surface and vulkan swapchain, images are owned by the allocator
+        Memory::Allocator*        m_allocator       = nullptr;
+        std::vector<Types::Image> m_headlessImages  = {};
+        mutable uint32_t          m_headlessCurrent = 0;
     private:
         bool InitFormats();
 
         bool CreateBuffers();
         void DestroyBuffers();
+        /// views are moved to the retired setup instead of being destroyed
+        void RetireBuffers(RetiredSetup& retired);
 
         bool CreateImages();
+        bool CreateHeadlessImages();
+        void DestroyHeadlessImages();
+
+        VkResult AcquireHeadlessImage(VkSemaphore presentCompleteSemaphore, uint32_t *imageIndex) const;
+        VkResult PresentHeadlessImage(VkQueue queue, VkSemaphore waitSemaphore) const;
     private:
         Swapchain()  = default;
         ~Swapchain() = default;
     public:
+        operator VkSwapchainKHR() const { return m_swapchain; }
+
         [[nodiscard]] bool IsReady() const override;
 
         bool SurfaceIsAvailable();
+        /// current size of the surface, zero if it's undefined (the size is chosen by the swapchain)
+        [[nodiscard]] VkExtent2D GetCurrentExtent() const;
 
         bool ReSetup(uint32_t width, uint32_t height);
 
+        [[nodiscard]] bool HasRetired() const { return !m_retired.empty(); }
+        /// call only when all frames which used retired swapchains are completed
+        void DestroyRetired();
+        /// the owner destroys them with DestroyRetired(retired) when frames which used them are completed
+        std::vector<RetiredSetup> TakeRetired();
+        void DestroyRetired(RetiredSetup& retired) const;
+
         [[nodiscard]] SwapChainBuffer* GetBuffers()   const { return m_buffers;       }
         [[nodiscard]] uint32_t GetSurfaceWidth()      const { return m_surfaceWidth;  }
         [[nodiscard]] uint32_t GetSurfaceHeight()     const { return m_surfaceHeight; }
@@ -69,6 +121,27 @@ namespace EvoVulkan::Types {
         [[nodiscard]] VkFormat GetColorFormat()       const { return m_colorFormat;   }
         [[nodiscard]] VkColorSpaceKHR GetColorSpace() const { return m_colorSpace;    }
         [[nodiscard]] uint32_t GetCountImages()       const { return m_countImages;   }
+        [[nodiscard]] bool IsHeadless()               const { return m_allocator;     }
+        [[nodiscard]] VkPresentModeKHR GetPresentMode() const { return m_presentMode; }
+        [[nodiscard]] VkImageUsageFlags GetImageUsage() const { return m_imageUsage; }
+
+        /// takes effect at the next re-setup
+        void SetPresentMode(VkPresentModeKHR presentMode) { m_requestedPresentMode = presentMode; }
+        void SetCountImages(uint32_t countImages)         { m_requestedCountImages = countImages; }
+
+        [[nodiscard]] bool IsPresentWaitEnabled() const { return m_waitForPresent; }
+        [[nodiscard]] uint64_t GetLastPresentId() const { return m_presentId;      }
+
+        /// id for VkPresentIdKHR of the present being queued, 0 - present wait isn't enabled
+        uint64_t NextPresentId() const { return IsPresentWaitEnabled() ? ++m_presentId : 0; }
+
+        /// blocks until the present with this id has been displayed, see VK_KHR_present_wait
+        VkResult WaitForPresent(uint64_t presentId, uint64_t timeout = UINT64_MAX) const;
+
+        /// final layout of the swapchain images, headless images are ready to be copied to host
+        [[nodiscard]] VkImageLayout GetPresentLayout() const {
+            return IsHeadless() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        }
     public:
         /**
         * Acquires the next image in the swap chain
@@ -92,6 +165,9 @@ namespace EvoVulkan::Types {
         * @return VkResult of the queue presentation
         */
         inline VkResult QueuePresent(VkQueue queue, uint32_t imageIndex, VkSemaphore waitSemaphore) const {
+            if (IsHeadless())
+                return PresentHeadlessImage(queue, waitSemaphore);
+
             VkPresentInfoKHR presentInfo = {};
             presentInfo.sType            = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
             presentInfo.pNext            = NULL;
@@ -105,6 +181,18 @@ namespace EvoVulkan::Types {
                 presentInfo.waitSemaphoreCount = 1;
             }
 
+#ifdef VK_KHR_present_id
+            const uint64_t presentId = NextPresentId();
+
+            VkPresentIdKHR presentIdInfo = {};
+            presentIdInfo.sType          = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+            presentIdInfo.swapchainCount = 1;
+            presentIdInfo.pPresentIds    = &presentId;
+
+            if (presentId != 0)
+                presentInfo.pNext = &presentIdInfo;
+#endif
+
             try {
                 return vkQueuePresentKHR(queue, &presentInfo);
             }
@@ -120,6 +208,21 @@ namespace EvoVulkan::Types {
                 Device* device,
                 bool vsync,
                 unsigned int width,
+                unsigned int height,
+                VkPresentModeKHR presentMode = VK_PRESENT_MODE_MAX_ENUM_KHR,
+                uint32_t countImages = 0);
+
+        /**
+         * @brief Ring of offscreen images instead of a presentable swapchain
+         *
+         * @note Acquire and present only signal and consume semaphores on the queue
+         */
+        static Swapchain* CreateHeadless(
+                Device* device,
+                Memory::Allocator* allocator,
+                VkFormat colorFormat,
+                uint32_t countImages,
+                unsigned int width,
                 unsigned int height);
 
         void Destroy() override;
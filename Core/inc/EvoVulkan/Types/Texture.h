@@ -9,9 +9,11 @@
 #include <EvoVulkan/Tools/VulkanInsert.h>
 #include <EvoVulkan/Tools/VulkanDebug.h>
 #include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/MipChain.h>
 #include <EvoVulkan/DescriptorManager.h>
 #include <EvoVulkan/Types/Image.h>
 #include <EvoVulkan/Types/VmaBuffer.h>
+#include <EvoVulkan/Memory/StagingRing.h>
 #include "Device.h"
 
 namespace EvoVulkan::Memory {
@@ -20,11 +22,17 @@ namespace EvoVulkan::Memory {
 
 namespace EvoVulkan::Complexes {
     class FrameBuffer;
+    class MipGenerator;
 }
 
 namespace EvoVulkan::Types {
+    class UploadBatch;
+
     struct Texture {
         friend class EvoVulkan::Complexes::FrameBuffer;
+    public:
+        /// writes texels of the first level into mapped staging memory of Tools::GetImageSize() bytes
+        typedef std::function<bool(uint8_t* data, VkDeviceSize size)> PixelWriter;
     private:
         Texture() = default;
         ~Texture() = default;
@@ -44,6 +52,8 @@ namespace EvoVulkan::Types {
         uint32_t           m_width          = 0,
                            m_height         = 0;
         uint32_t           m_mipLevels      = 0;
+        //! 0 - usage of the image
+        VkImageUsageFlags  m_viewUsage      = 0;
 
         uint32_t           m_seed           = 0;
 
@@ -72,7 +82,28 @@ namespace EvoVulkan::Types {
         [[nodiscard]] inline uint32_t GetHeight() const { return m_height; }
         [[nodiscard]] inline uint32_t GetSeed() const { return m_seed; }
     private:
-        bool Create(VmaBuffer* stagingBuffer);
+        /// without generateMipmaps every level is given by the regions and only transitioned
+        bool Create(UploadBatch* batch, const Memory::StagingRing::Allocation& staging, const VkBufferImageCopy* regions, uint32_t countRegions, uint32_t layerCount, bool generateMipmaps = true);
+        /// pixels are written by the CPU (VK_EXT_host_image_copy), there are no staging memory and commands
+        bool CreateOnHost(const void* const* pixels, const VkBufferImageCopy* regions, uint32_t countRegions, uint32_t layerCount);
+        /// view, sampler and descriptor of the created image
+        bool CreateView();
+
+        /// small single level textures are cheaper to copy by the CPU than to record and submit
+        static bool IsHostCopyPreferred(Device* device, VkFormat format, uint32_t width, uint32_t height, uint32_t layerCount, uint32_t mipLevels, bool cpuUsage);
+
+        /// 6 layers - cube map
+        static Texture* LoadOnHost(
+                Device* device,
+                Memory::Allocator* allocator,
+                Core::DescriptorManager* manager,
+                CmdPool* pool,
+                const void* const* layers,
+                uint32_t layerCount,
+                VkFormat format,
+                uint32_t width, uint32_t height,
+                VkFilter filter,
+                bool cpuUsage);
     public:
         Core::DescriptorSet GetDescriptorSet(VkDescriptorSetLayout layout);
 
@@ -85,8 +116,65 @@ namespace EvoVulkan::Types {
             delete this;
         }
 
-        static bool GenerateMipmaps(Texture* texture, Types::CmdBuffer* singleBuffer);
+        /**
+         * @brief Records mip generation of the texture into the batch, the first level is in the transfer dst layout
+         *
+         * @note Doesn't wait for anything, the mips are ready when the batch is completed
+         */
+        static bool GenerateMipmaps(Texture* texture, UploadBatch* batch);
+
+        /// records the upload into the batch, the texture can be sampled after the batch is completed
+        static Texture* LoadCubeMap(
+                UploadBatch* batch,
+                VkFormat format,
+                uint32_t width,
+                uint32_t height,
+                const std::array<uint8_t*, 6>& sides,
+                uint32_t mipLevels = 0,
+                bool cpuUsage = false);
+
+        static Texture* Load(
+                UploadBatch* batch,
+                Core::DescriptorManager* manager,
+                const unsigned char *pixels,
+                VkFormat format,
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, VkFilter filter,
+                bool cpuUsage = false);
+
+        /// texels are already in the staging memory of the batch (UploadBatch::MapStaging() or Adopt())
+        static Texture* Load(
+                UploadBatch* batch,
+                Core::DescriptorManager* manager,
+                const Memory::StagingRing::Allocation& staging,
+                VkFormat format,
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, VkFilter filter,
+                bool cpuUsage = false);
+
+        /// the writer (decoder) fills staging memory in place, there is no intermediate copy of pixels
+        static Texture* Decode(
+                UploadBatch* batch,
+                Core::DescriptorManager* manager,
+                VkFormat format,
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, VkFilter filter,
+                const PixelWriter& write,
+                bool cpuUsage = false);
+
+        /// every level is given (Tools::GenerateMipChain() or precompressed BCn levels), one region per level.
+        /// Offsets and sizes of the levels are relative to the data, all of them are staged by one allocation
+        static Texture* LoadLevels(
+                UploadBatch* batch,
+                Core::DescriptorManager* manager,
+                const uint8_t* data,
+                const std::vector<Tools::MipLevel>& levels,
+                VkFormat format,
+                VkFilter filter,
+                bool cpuUsage = false);
 
+        /// uploads with one submit and waits for it. With the transfer pool (VulkanKernel::GetTransferCmdPool())
+        /// pixels are copied by the dedicated transfer queue, with the mip generator mips are generated by compute
         static Texture* LoadCubeMap(
                 Device* device,
                 Memory::Allocator *allocator,
@@ -96,7 +184,9 @@ namespace EvoVulkan::Types {
                 uint32_t height,
                 const std::array<uint8_t*, 6>& sides,
                 uint32_t mipLevels = 0,
-                bool cpuUsage = false);
+                bool cpuUsage = false,
+                CmdPool* transferPool = nullptr,
+                Complexes::MipGenerator* mipGenerator = nullptr);
 
         static Texture* Load(
                 Device *device,
@@ -107,7 +197,34 @@ namespace EvoVulkan::Types {
                 VkFormat format,
                 uint32_t width, uint32_t height,
                 uint32_t mipLevels, VkFilter,
-                bool cpuUsage = false);
+                bool cpuUsage = false,
+                CmdPool* transferPool = nullptr,
+                Complexes::MipGenerator* mipGenerator = nullptr);
+
+        static Texture* Decode(
+                Device *device,
+                Memory::Allocator *allocator,
+                Core::DescriptorManager* manager,
+                CmdPool *pool,
+                VkFormat format,
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, VkFilter filter,
+                const PixelWriter& write,
+                bool cpuUsage = false,
+                CmdPool* transferPool = nullptr,
+                Complexes::MipGenerator* mipGenerator = nullptr);
+
+        static Texture* LoadLevels(
+                Device *device,
+                Memory::Allocator *allocator,
+                Core::DescriptorManager* manager,
+                CmdPool *pool,
+                const uint8_t* data,
+                const std::vector<Tools::MipLevel>& levels,
+                VkFormat format,
+                VkFilter filter,
+                bool cpuUsage = false,
+                CmdPool* transferPool = nullptr);
 
         static Texture* LoadAutoMip(
                 Device *device,
@@ -118,14 +235,16 @@ namespace EvoVulkan::Types {
                 VkFormat format,
                 uint32_t width,
                 uint32_t height, VkFilter filter,
-                bool cpuUsage = false)
+                bool cpuUsage = false,
+                CmdPool* transferPool = nullptr,
+                Complexes::MipGenerator* mipGenerator = nullptr)
         {
 #ifdef max
             return Load(device, allocator, manager, pool, pixels, format, width, height,
-                        static_cast<uint32_t>(std::floor(std::log2(max(width, height)))) + 1, filter, cpuUsage);
+                        static_cast<uint32_t>(std::floor(std::log2(max(width, height)))) + 1, filter, cpuUsage, transferPool, mipGenerator);
 #else
             return Load(device, allocator, manager, pool, pixels, format, width, height,
-                        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1, filter, cpuUsage);
+                        static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1, filter, cpuUsage, transferPool, mipGenerator);
 #endif
         }
 
@@ -137,9 +256,10 @@ namespace EvoVulkan::Types {
                 const unsigned char *pixels,
                 VkFormat format,
                 uint32_t width, uint32_t height, VkFilter filter,
-                bool cpuUsage = false)
+                bool cpuUsage = false,
+                CmdPool* transferPool = nullptr)
         {
-            return Load(device, allocator, manager, pool, pixels, format, width, height, 1, filter, cpuUsage);
+            return Load(device, allocator, manager, pool, pixels, format, width, height, 1, filter, cpuUsage, transferPool);
         }
     };
 }
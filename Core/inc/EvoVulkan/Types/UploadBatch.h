@@ -0,0 +1,159 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#ifndef EVOVULKAN_UPLOADBATCH_H
+#define EVOVULKAN_UPLOADBATCH_H
+
+#include <vulkan/vulkan.h>
+
+#include <EvoVulkan/Types/Base/VulkanObject.h>
+#include <EvoVulkan/Memory/StagingRing.h>
+
+#include <functional>
+#include <vector>
+
+namespace EvoVulkan::Complexes {
+    class MipGenerator;
+}
+
+namespace EvoVulkan::Types {
+    class Device;
+    class CmdPool;
+    struct VmaBuffer;
+
+    /**
+     * @brief Records many uploads, layout transitions and mip generations and submits them at once
+     *
+     * @note Begin() -> Upload*() / TransitionImage() / GenerateMipmaps() -> Submit() -> Wait() or IsComplete().
+     *       With a pool of the dedicated transfer family copies are done on the transfer queue, the graphics
+     *       command buffer acquires the ownership and waits for them on a semaphore, there are no host waits.
+     *       Staging memory is taken from the staging ring of the allocator if there is one, otherwise (or if
+     *       the ring is full) from dedicated buffers, and is kept until the submit is completed.
+     */
+    class UploadBatch : public IVkObject {
+    public:
+        /// staging memory of an upload, regions of copies are relative to its offset
+        using Staging = Memory::StagingRing::Allocation;
+
+        /// staging memory which is filled by any thread (e.g. a decoder) before a batch takes it with Adopt()
+        struct DetachedStaging {
+            Staging     m_staging = {};
+            //! dedicated buffer if the ring is full or absent
+            VmaBuffer*  m_buffer  = nullptr;
+            //! owner of the ring allocation
+            const void* m_owner   = nullptr;
+
+            [[nodiscard]] bool Valid() const { return m_staging.Valid(); }
+        };
+    public:
+        UploadBatch(const UploadBatch&) = delete;
+    private:
+        UploadBatch()  = default;
+        ~UploadBatch() = default;
+    private:
+        Device*                  m_device        = nullptr;
+        Memory::Allocator*       m_allocator     = nullptr;
+        CmdPool*                 m_pool          = nullptr;
+        CmdPool*                 m_transferPool  = nullptr;
+
+        //! transitions, mip generations and acquire barriers
+        VkCommandBuffer          m_cmd           = VK_NULL_HANDLE;
+        //! copies and release barriers, the same as m_cmd if the transfer family isn't dedicated
+        VkCommandBuffer          m_transferCmd   = VK_NULL_HANDLE;
+        VkSemaphore              m_transferDone  = VK_NULL_HANDLE;
+        VkPipelineStageFlags     m_acquireStages = 0;
+        VkFence                  m_fence         = VK_NULL_HANDLE;
+
+        std::vector<VmaBuffer*>  m_staging       = {};
+        //! resources of recorded commands, released when the submit is completed
+        std::vector<std::function<void()>> m_deferred = {};
+        //! textures generate mips by it instead of blits, nullptr - blits
+        Complexes::MipGenerator* m_mipGenerator  = nullptr;
+        //! scratch for regions shifted by the staging offset
+        std::vector<VkBufferImageCopy> m_regions = {};
+        bool                     m_ringUsed      = false;
+
+        uint32_t                 m_countUploads  = 0;
+        bool                     m_recording     = false;
+        bool                     m_submitted     = false;
+    private:
+        [[nodiscard]] bool IsTransferQueued() const { return m_transferCmd != m_cmd; }
+        void ReleaseStaging();
+        /// ring memory of the batch which will never be submitted
+        void CancelRing();
+        /// waits for the submitted copies whose graphics submit has failed
+        void AbandonTransfer();
+    public:
+        /// @param transferPool Pool of VulkanKernel::GetTransferCmdPool(), can be nullptr
+        static UploadBatch* Create(Device* device, Memory::Allocator* allocator, CmdPool* pool, CmdPool* transferPool = nullptr);
+    public:
+        /// waits for the previous submit if it's in flight
+        bool Begin();
+
+        /**
+         * @brief Staging memory which is filled by the caller until Submit()
+         *
+         * @param alignment Offset alignment in the ring, copies to images need Tools::GetStagingAlignment()
+         */
+        Staging MapStaging(VkDeviceSize size, VkDeviceSize alignment = 16);
+        Staging Stage(const void* data, VkDeviceSize size, VkDeviceSize alignment = 16);
+
+        /**
+         * @brief Any thread, the memory is written in place and then given to a batch, so pixels are never
+         *        copied on the CPU. May wait for space in the ring.
+         *
+         * @param owner Unique per allocation until it's adopted or released
+         */
+        static DetachedStaging MapDetached(Memory::Allocator* allocator, const void* owner, VkDeviceSize size, VkDeviceSize alignment = 16);
+        /// memory which is never adopted
+        static void ReleaseDetached(Memory::Allocator* allocator, DetachedStaging& staging);
+        /// the batch owns the memory until its submit is completed, the detached staging is reset
+        Staging Adopt(DetachedStaging& staging);
+
+        /// all levels and layers of the image are left in the transfer dst layout
+        bool CopyToImage(const Staging& staging, VkImage image, const VkBufferImageCopy* regions, uint32_t countRegions, uint32_t mipLevels, uint32_t layerCount = 1);
+        bool UploadImage(VkImage image, VkFormat format, const void* data, VkDeviceSize size, const VkBufferImageCopy* regions, uint32_t countRegions, uint32_t mipLevels, uint32_t layerCount = 1);
+
+        /// the buffer becomes visible to dstAccess at dstStage of the following graphics work
+        bool UploadBuffer(
+                VkBuffer buffer,
+                const void* data,
+                VkDeviceSize size,
+                VkDeviceSize offset = 0,
+                VkAccessFlags dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT,
+                VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+        bool TransitionImage(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount = 1);
+        /// transfer dst -> shader read only
+        bool GenerateMipmaps(VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount = 1);
+
+        /// called when the submit is completed (or the batch is destroyed), e.g. frees views used by the commands
+        void Defer(std::function<void()>&& release) { m_deferred.emplace_back(std::move(release)); }
+
+        /// textures recorded after it generate mips by the compute generator if it supports their format
+        void SetMipGenerator(Complexes::MipGenerator* generator) { m_mipGenerator = generator; }
+        [[nodiscard]] Complexes::MipGenerator* GetMipGenerator() const { return m_mipGenerator; }
+
+        /// @param signalTimeline Timeline semaphore which gets signalValue on completion, optional
+        bool Submit(VkSemaphore signalTimeline = VK_NULL_HANDLE, uint64_t signalValue = 0);
+        /// releases staging memory of the completed submit
+        bool Wait(uint64_t timeout = UINT64_MAX);
+        [[nodiscard]] bool IsComplete() const;
+
+        [[nodiscard]] uint32_t GetCountUploads() const { return m_countUploads; }
+        [[nodiscard]] bool IsRecording() const { return m_recording; }
+        [[nodiscard]] Device* GetDevice() const { return m_device; }
+        [[nodiscard]] Memory::Allocator* GetAllocator() const { return m_allocator; }
+        [[nodiscard]] CmdPool* GetCmdPool() const { return m_pool; }
+        /// graphics command buffer for custom commands, valid between Begin() and Submit()
+        [[nodiscard]] VkCommandBuffer GetCmd() const { return m_cmd; }
+
+        [[nodiscard]] bool IsReady() const override;
+
+        void Destroy() override;
+        void Free() override;
+    };
+}
+
+#endif //EVOVULKAN_UPLOADBATCH_H
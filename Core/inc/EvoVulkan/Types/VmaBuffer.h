@@ -44,6 +44,8 @@ namespace EvoVulkan::Types {
         void SetupDescriptor(VkDeviceSize offset = 0);
 
         VkResult Flush();
+        /// makes device writes visible to the host, for non-coherent readback memory
+        VkResult Invalidate();
         VkResult Bind();
         VkResult Map();
         void* MapData();
@@ -12,7 +12,8 @@ namespace EvoVulkan::Types {
     class Device;
     /**
     * @brief Encapsulates access to a Vulkan buffer backed up by device memory
-    * @note To be filled by an external source like the VulkanDevice
+    * @note Memory is sub-allocated by VMA, small uniform and vertex/index buffers come from pools of the allocator.
+    *       Host visible buffers are mapped persistently
     */
     struct Buffer : Tools::NonCopyable {
     private:
@@ -33,6 +34,7 @@ namespace EvoVulkan::Types {
 
     public:
         VkResult Map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+        /// memory is bound by VMA on creation
         VkResult Bind(VkDeviceSize offset = 0) const;
         VkResult Flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
         VkResult Invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
@@ -46,7 +48,8 @@ namespace EvoVulkan::Types {
         void SetupDescriptor(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 
         void CopyTo(void *data, VkDeviceSize size);
-        void CopyToDevice(void *data, VkDeviceSize size) const;
+        /// @param offset Byte offset from beginning, e.g. the slot of a frame in flight
+        void CopyToDevice(void *data, VkDeviceSize size, VkDeviceSize offset = 0) const;
 
         void Destroy();
         void Free();
@@ -55,7 +58,10 @@ namespace EvoVulkan::Types {
         Types::Device*         m_device              = nullptr;
         Memory::Allocator*     m_allocator           = nullptr;
         VkBuffer               m_buffer              = VK_NULL_HANDLE;
-        Memory::RawMemory      m_memory              = {};
+        VmaAllocation          m_allocation          = VK_NULL_HANDLE;
+        //! whole buffer, nullptr if the memory isn't host visible
+        uint8_t*               m_persistent          = nullptr;
+        bool                   m_coherent            = true;
         VkDescriptorBufferInfo m_descriptor          = {};
         VkDeviceSize           m_size                = 0;
         VkDeviceSize           m_alignment           = 0;
@@ -21,9 +21,23 @@
 #include <EvoVulkan/DescriptorManager.h>
 #include <EvoVulkan/Types/RenderPass.h>
 #include <EvoVulkan/Complexes/Framebuffer.h>
+#include <EvoVulkan/Complexes/PresentTarget.h>
+#include <EvoVulkan/Complexes/TextureStreamer.h>
+#include <EvoVulkan/Complexes/MipGenerator.h>
+#include <EvoVulkan/Complexes/Readback.h>
 
 #include <EvoVulkan/Types/MultisampleTarget.h>
+#include <EvoVulkan/Types/UploadBatch.h>
 #include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Memory/DeletionQueue.h>
+#include <EvoVulkan/Memory/LinearArena.h>
+#include <EvoVulkan/Memory/UniformRing.h>
+#include <EvoVulkan/Tools/HeapGuard.h>
+#include <EvoVulkan/Tools/SPSCQueue.h>
+
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 
 namespace EvoVulkan::Core {
     enum class FrameResult : uint8_t {
@@ -34,6 +48,53 @@ namespace EvoVulkan::Core {
         Success = 0, Fatal = 1, Error = 2
     };
 
+    /// unit of work for the render thread, see VulkanKernel::PushFramePacket()
+    struct FramePacket {
+        /// executed on the render thread before the frame (uniform data, draw lists and etc.)
+        std::function<void()> m_update  = std::function<void()>();
+        /// new window sizes, -1 if the window has not been resized
+        int32_t               m_width   = -1;
+        int32_t               m_height  = -1;
+        /// false for packets which only carry events
+        bool                  m_present = true;
+    };
+
+    /// records draw items [first, last) into a secondary command buffer of the pass,
+    /// index is the swapchain image or the frame in flight for offscreen passes
+    typedef std::function<void(VkCommandBuffer cmd, uint32_t imageIndex, uint32_t first, uint32_t last)> SecondaryRecordFn;
+
+    /// cached secondary command buffers of a part of the scene, see VulkanKernel::AddRecordPass()
+    struct RecordPass {
+        SecondaryRecordFn            m_record     = SecondaryRecordFn();
+        uint32_t                     m_countItems = 0;
+        /// nullptr - swapchain render pass
+        Complexes::FrameBuffer*      m_target     = nullptr;
+        /// [image * count workers + worker]
+        std::vector<VkCommandBuffer> m_cmdBuffs   = {};
+        /// per swapchain image, offscreen passes have one per frame in flight of the target
+        std::vector<bool>            m_dirty      = {};
+        /// re-recorded by the application every frame, it's a part of the steady state of the heap guard
+        bool                         m_everyFrame = false;
+    };
+
+    /// task of a recording worker, the context is the callable given to VulkanKernel::RunRecordingWorkers()
+    typedef bool (*RecordingTaskFn)(const void* context, uint32_t worker);
+
+    /// wait semaphores of a graphics submit after a timeline, kept to not allocate every frame
+    struct TimelineWaits {
+        std::vector<VkSemaphore>          m_semaphores = {};
+        std::vector<VkPipelineStageFlags> m_stages     = {};
+        std::vector<uint64_t>             m_values     = {};
+    };
+
+    /// transient command pool of a frame in flight, see VulkanKernel::AllocateFrameCmdBuffer()
+    struct FrameCmdPool {
+        Types::CmdPool*                             m_pool     = nullptr;
+        /// [level] buffers allocated from the pool, they are reused after the pool reset
+        std::array<std::vector<VkCommandBuffer>, 2> m_cmdBuffs = {};
+        std::array<uint32_t, 2>                     m_used     = {};
+    };
+
     class VulkanKernel {
     public:
         VulkanKernel(const VulkanKernel&) = delete;
@@ -50,6 +111,25 @@ namespace EvoVulkan::Core {
         VkDebugUtilsMessengerEXT   m_debugMessenger       = VK_NULL_HANDLE;
 
         bool                       m_validationEnabled    = false;
+        /// render without a surface into a ring of offscreen images
+        bool                       m_headless             = false;
+        uint32_t                   m_headlessCountImages  = 3;
+        VkFormat                   m_headlessFormat       = VK_FORMAT_R8G8B8A8_UNORM;
+
+        /// VK_PRESENT_MODE_MAX_ENUM_KHR - choose by vsync, 0 images - minimal count + 1
+        VkPresentModeKHR           m_presentMode          = VK_PRESENT_MODE_MAX_ENUM_KHR;
+        uint32_t                   m_countSwapchainImages = 0;
+        bool                       m_vsync                = false;
+
+        /// 0 - unlimited. Latency is limited only if present wait is supported
+        uint32_t                   m_maxFrameLatency      = 0;
+        std::chrono::nanoseconds   m_minFrameTime         = std::chrono::nanoseconds(0);
+        std::chrono::steady_clock::time_point m_nextFrameTime = std::chrono::steady_clock::time_point();
+
+        /// frames from m_heapGuardFrom must not allocate, UINT64_MAX - disabled
+        uint64_t                   m_heapGuardFrom        = UINT64_MAX;
+        uint32_t                   m_heapGuardWarmup      = 0;
+        uint64_t                   m_heapGuardViolations  = 0;
 
         bool                       m_isPreInitialized     = false;
         bool                       m_isInitialized        = false;
@@ -85,36 +165,199 @@ namespace EvoVulkan::Core {
 
         /// optional. Maybe nullptr
         VkSemaphore                m_waitSemaphore        = VK_NULL_HANDLE;
+        /// synchronizations of the current frame in flight, m_submitInfo points to it
         Types::Synchronization     m_syncs                = {};
         VkSubmitInfo               m_submitInfo           = {};
 
+        uint8_t                    m_maxFramesInFlight    = 2;
+        uint32_t                   m_currentFrame         = 0;
+        /// count of submitted frames
+        uint64_t                   m_frameCounter         = 0;
+        /// suboptimal swapchain is presented until the window reports its new size, out of date one can't be
+        bool                       m_swapchainSuboptimal  = false;
+        bool                       m_swapchainOutOfDate   = false;
+
+        /// clear values of the swapchain pass, ResizeWindow() re-records the passes with them
+        std::vector<VkClearValue>  m_passClearValues      = {};
+
+        /// per frame in flight
+        std::vector<Types::Synchronization> m_frameSyncs  = std::vector<Types::Synchronization>();
         std::vector<VkFence>       m_waitFences           = std::vector<VkFence>();
+        /// per swapchain image, fence of the frame which is using this image now
+        std::vector<VkFence>       m_imagesInFlight       = std::vector<VkFence>();
+        /// per frame in flight, reset in bulk when the frame fence is signaled
+        std::vector<FrameCmdPool>  m_frameCmdPools        = std::vector<FrameCmdPool>();
+        /// objects released during a frame, collected when the frame is completed
+        Memory::DeletionQueue      m_deletionQueue        = {};
+        /// additional windows, presented together with the main swapchain
+        std::vector<Complexes::PresentTarget*> m_presentTargets = std::vector<Complexes::PresentTarget*>();
+        /// storage of the combined submit and present, reserved when targets are added
+        std::vector<VkSubmitInfo>   m_targetSubmits       = std::vector<VkSubmitInfo>();
+        std::vector<VkSwapchainKHR> m_presentSwapchains   = std::vector<VkSwapchainKHR>();
+        std::vector<uint32_t>       m_presentIndices      = std::vector<uint32_t>();
+        std::vector<VkSemaphore>    m_presentWaits        = std::vector<VkSemaphore>();
+        std::vector<VkResult>       m_presentResults      = std::vector<VkResult>();
+        std::vector<uint64_t>       m_presentIds          = std::vector<uint64_t>();
+
+        /// per frame in flight, transient CPU data of the frame
+        std::vector<Memory::LinearArena*> m_frameArenas   = std::vector<Memory::LinearArena*>();
+        /// per object uniforms of frames in flight, bound by dynamic offsets
+        Memory::UniformRing*       m_uniformRing          = nullptr;
+        /// bytes of the ring per frame, 0 - there is no ring
+        VkDeviceSize               m_uniformRingSize      = 1024 * 1024;
+
+        /// copies to the host, created on the first ReadbackImage()
+        Complexes::Readback*       m_readback             = nullptr;
+        /// frame command buffer with copies of this frame, submitted after the render complete semaphore
+        VkCommandBuffer            m_readbackCmd          = VK_NULL_HANDLE;
+        /// per frame in flight, signaled by the copies and waited by the present instead of render complete
+        std::vector<VkSemaphore>   m_readbackSemaphores   = std::vector<VkSemaphore>();
+
+        /// input-to-present latency, time points are nanoseconds of the steady clock
+        std::atomic<int64_t>       m_inputSampleTime      = 0;
+        int64_t                    m_latchedInputTime     = 0;
+        double                     m_inputLatency         = 0.0;
+        double                     m_averageInputLatency  = 0.0;
+
         uint32_t                   m_currentBuffer        = 0;
 
         std::vector<VkSubmitInfo>  m_framebuffersQueue    = {};
+        /// PrepareFrame() selects command buffers of the current frame in these framebuffers
+        std::vector<Complexes::FrameBuffer*> m_queueFramebuffers = {};
 
         VkPipelineStageFlags       m_submitPipelineStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
+        /// timeline submission of the framebuffers chain, see SetTimelineFramebuffersQueue()
+        VkSemaphore                m_timeline             = VK_NULL_HANDLE;
+        uint64_t                   m_timelineValue        = 0;
+        uint32_t                   m_countTimelinePasses  = 0;
+
+        std::vector<VkSubmitInfo>                  m_timelineSubmits      = {};
+        std::vector<VkTimelineSemaphoreSubmitInfo> m_timelineSubmitInfos  = {};
+        std::vector<VkCommandBuffer>               m_timelineCmdBuffs     = {};
+        std::vector<Complexes::FrameBuffer*>       m_timelineFramebuffers = {};
+        std::vector<VkPipelineStageFlags>          m_timelineWaitStages   = {};
+        std::vector<uint64_t>                      m_timelineWaitValues   = {};
+        std::vector<uint64_t>                      m_timelineSignalValues = {};
+        /// swapchain pass: { timeline, present complete } -> { timeline, render complete }
+        std::array<VkSemaphore, 2>                 m_timelineFinalWaits   = {};
+        std::array<VkSemaphore, 2>                 m_timelineFinalSignals = {};
+
+        /// async compute, the timeline value is the count of compute submits, see SubmitCompute()
+        Types::CmdPool*                            m_computeCmdPool       = nullptr;
+        VkSemaphore                                m_computeTimeline      = VK_NULL_HANDLE;
+        uint64_t                                   m_computeValue         = 0;
+        /// scratch of SubmitAfterCompute()
+        TimelineWaits                              m_computeWaits         = {};
+
+        /// uploads on the dedicated transfer queue, the timeline value is the count of transfer submits
+        Types::CmdPool*                            m_transferCmdPool      = nullptr;
+        VkSemaphore                                m_transferTimeline     = VK_NULL_HANDLE;
+        uint64_t                                   m_transferValue        = 0;
+        /// guards the transfer queue and the timeline value
+        std::mutex                                 m_transferMutex        = std::mutex();
+        /// scratch of SubmitAfterTransfer(), it isn't shared with compute
+        TimelineWaits                              m_transferWaits        = {};
+        /// upload memory of batches, 0 - batches use dedicated staging buffers
+        VkDeviceSize                               m_stagingRingSize      = 64 * 1024 * 1024;
+
         bool                       m_GUIEnabled           = false;
+
+        /// produced by the window thread, consumed by the render thread
+        Tools::SPSCQueue<FramePacket, 8> m_framePackets   = {};
+        std::thread                m_renderThread         = std::thread();
+        std::atomic<bool>          m_renderThreadActive   = false;
+        /// signaled by the render thread when it takes a packet, the producer waits for a free slot with it
+        std::mutex                 m_packetMutex          = std::mutex();
+        std::condition_variable    m_packetSlotFreed      = std::condition_variable();
+
+        /// parallel recording, a command pool per worker thread
+        std::vector<Types::CmdPool*> m_workerPools        = {};
+        /// incremented when the pools are destroyed, retired buffers of older pools are freed with them
+        uint64_t                     m_workerPoolsGeneration = 0;
+        /// persistent workers of all pools except the last one, it belongs to the calling thread
+        std::vector<std::thread>     m_recordingThreads   = {};
+        std::mutex                   m_recordingMutex     = std::mutex();
+        std::condition_variable      m_recordingStart     = std::condition_variable();
+        std::condition_variable      m_recordingDone      = std::condition_variable();
+        /// incremented by every batch, workers run the task once per batch
+        uint64_t                     m_recordingBatch     = 0;
+        uint32_t                     m_recordingPending   = 0;
+        bool                         m_recordingSuccess   = true;
+        bool                         m_recordingStop      = false;
+        /// task of the current batch, the context is alive until all workers are done
+        RecordingTaskFn              m_recordingTask      = nullptr;
+        const void*                  m_recordingContext   = nullptr;
+        /// [image * count workers + worker]
+        std::vector<VkCommandBuffer> m_secondaryCmdBuffs  = {};
+        std::vector<RecordPass>      m_recordPasses       = {};
     public:
         uint8_t                    m_countDCB             = 0;
         VkCommandBuffer*           m_drawCmdBuffs         = nullptr;
         std::vector<VkFramebuffer> m_frameBuffers         = std::vector<VkFramebuffer>();
     private:
+        /// re-allocates draw command buffers and secondaries if count images of the swapchain has been changed
         bool ReCreateFrameBuffers();
         void DestroyFrameBuffers();
+        /// frame rate limiter and max frame latency
+        void PaceFrame();
+        void RestartHeapGuardWarmup();
+        /// one vkQueuePresentKHR for the main swapchain and acquired present targets
+        VkResult QueuePresentAll(VkSemaphore renderComplete);
+        /// readback and the command buffer of the current frame
+        bool BeginReadback();
+        /// graphics submit which additionally waits for the value of the timeline, semaphores are gathered in the scratch
+        VkResult SubmitAfterTimeline(const VkSubmitInfo& submitInfo, VkSemaphore timeline, uint64_t value, VkPipelineStageFlags stage, VkFence fence, TimelineWaits& scratch);
+
+        /// @param deferred Pools are destroyed when frames in flight are completed
+        void DestroyWorkerPools(bool deferred = false);
+        bool AllocateSecondaryCmdBuffs(std::vector<VkCommandBuffer>& cmdBuffs, uint32_t countImages);
+        /// buffers which can be executed by frames in flight are freed when the frames are completed
+        void RetireSecondaryCmdBuffs(std::vector<VkCommandBuffer>& cmdBuffs);
+        /// runs the task of every worker on the persistent threads and the calling thread, waits for all of them
+        bool RunRecordingWorkers(RecordingTaskFn task, const void* context);
+        /// the callable isn't converted to std::function, re-recording every frame doesn't allocate
+        template<typename Task> bool RunRecordingWorkers(const Task& task) {
+            return RunRecordingWorkers([](const void* context, uint32_t worker) -> bool {
+                return (*static_cast<const Task*>(context))(worker);
+            }, &task);
+        }
+        void RecordingThreadLoop(uint32_t worker, uint64_t batch);
+        static bool RecordSecondary(
+                VkCommandBuffer cmd,
+                const VkCommandBufferInheritanceInfo& inheritanceInfo,
+                const VkViewport& viewport,
+                const VkRect2D& scissor,
+                const SecondaryRecordFn& record,
+                uint32_t imageIndex, uint32_t first, uint32_t last);
+
+        void ApplySize(int32_t width, int32_t height);
+        bool HasNewSize();
+        void ApplyFramePacket(FramePacket& packet, bool present);
+        void RenderThreadLoop();
     public:
         FrameResult PrepareFrame();
         RenderResult NextFrame();
         FrameResult SubmitFrame();
+        /// calls OnLateLatch() right before the submission of the frame, submitting methods of the kernel call it themselves
+        void LateLatch();
     protected:
         virtual RenderResult Render() { return RenderResult::Fatal; /* nothing */ }
+
+        /// write camera and view uniforms into the slot of the frame in flight as late as possible
+        virtual void OnLateLatch(uint32_t frameIndex) { }
     public:
         virtual bool BuildCmdBuffers() = 0;
+        /// records draw command buffers of an additional window, called after its creation and re-creation
+        virtual bool BuildTargetCmdBuffers(Complexes::PresentTarget* target) { return true; }
     public:
         [[nodiscard]] inline uint32_t GetCountBuildIterations() noexcept { return 3; }
         [[nodiscard]] inline VkPipelineCache GetPipelineCache() const noexcept { return m_pipelineCache; }
 
+        /// use for indexing per-frame resources (uniform buffers and etc.)
+        [[nodiscard]] inline uint32_t GetCurrentFrameIndex() const noexcept { return m_currentFrame; }
+        [[nodiscard]] inline uint8_t GetFramesInFlight() const noexcept { return m_maxFramesInFlight; }
+
         [[nodiscard]] inline VkCommandBuffer* GetDrawCmdBuffs() const { return m_drawCmdBuffs; }
         [[nodiscard]] inline Types::Device* GetDevice() const { return m_device; }
         [[nodiscard]] inline Memory::Allocator* GetAllocator() const { return m_allocator; }
@@ -126,6 +369,16 @@ namespace EvoVulkan::Core {
 
         [[nodiscard]] inline bool HasErrors() const noexcept { return m_hasErrors; }
 
+        /// call when the input is sampled (e.g. after polling window events), any thread
+        inline void MarkInputSample() noexcept {
+            m_inputSampleTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /// milliseconds from the input sample latched by the last frame to its present
+        [[nodiscard]] inline double GetInputLatency() const noexcept { return m_inputLatency; }
+        [[nodiscard]] inline double GetAverageInputLatency() const noexcept { return m_averageInputLatency; }
+
         //inline bool SetRenderFunction(KernelRenderFunction drawFunction) {
         //    this->m_renderFunction = drawFunction;
         //    return true;
@@ -149,7 +402,9 @@ namespace EvoVulkan::Core {
         }
 
         void SetFramebuffersQueue(const std::vector<Complexes::FrameBuffer*>& queue) {
-            auto newQueue = std::vector<VkSubmitInfo>();
+            /// keeps the capacity, setting a queue of the same size every frame doesn't allocate
+            this->m_framebuffersQueue.clear();
+            this->m_queueFramebuffers.clear();
 
             VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
             submitInfo.commandBufferCount   = 1;
@@ -158,6 +413,10 @@ namespace EvoVulkan::Core {
             submitInfo.pWaitDstStageMask    = &m_submitPipelineStages;
 
             for (uint32_t i = 0; i < queue.size(); i++) {
+                /// points to the command buffer of the frame selected by PrepareFrame()
+                queue[i]->SetFrame(m_currentFrame);
+                m_queueFramebuffers.push_back(queue[i]);
+
                 submitInfo.pCommandBuffers   = queue[i]->GetCmdRef();
                 submitInfo.pSignalSemaphores = queue[i]->GetSemaphoreRef();
 
@@ -166,21 +425,213 @@ namespace EvoVulkan::Core {
                 else
                     submitInfo.pWaitSemaphores = queue[i - 1]->GetSemaphoreRef();
 
-                newQueue.push_back(submitInfo);
+                m_framebuffersQueue.push_back(submitInfo);
             }
 
             if (!queue.empty())
                 m_waitSemaphore = queue[queue.size() - 1]->GetSemaphore();
             else
                 m_waitSemaphore = VK_NULL_HANDLE;
+        }
+
+        /**
+         * @brief Chain of offscreen passes and the swapchain pass in one vkQueueSubmit
+         *
+         * @param queue Offscreen framebuffers in execution order, each one with a stage mask at which
+         *              it waits for the previous pass (e.g. FRAGMENT_SHADER if it only samples it)
+         * @param swapchainWaitStage Stage at which the swapchain pass waits for the last offscreen pass
+         *
+         * @note Requires timeline semaphores support. Submit with SubmitTimelineQueue() between
+         *       PrepareFrame() and SubmitFrame().
+         */
+        bool SetTimelineFramebuffersQueue(
+                const std::vector<std::pair<Complexes::FrameBuffer*, VkPipelineStageFlags>>& queue,
+                VkPipelineStageFlags swapchainWaitStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+        /// submits the timeline queue with the current draw command buffer as swapchain pass
+        VkResult SubmitTimelineQueue();
+
+        /// command buffers for SubmitCompute() are allocated from it
+        [[nodiscard]] inline Types::CmdPool* GetComputeCmdPool() const noexcept { return m_computeCmdPool; }
+
+        /**
+         * @brief Submits work to the compute queue, it overlaps with rasterization if the family is dedicated
+         *
+         * @param waitTimelineValue Value of the framebuffers timeline to wait before the work, 0 - don't wait
+         *
+         * @return Value of the compute timeline which is signaled on completion, 0 - error
+         *
+         * @note Requires timeline semaphores. Resources with exclusive sharing mode have to be transferred
+         *       between the compute and graphics families.
+         */
+        uint64_t SubmitCompute(
+                const VkCommandBuffer* cmdBuffs,
+                uint32_t count,
+                uint64_t waitTimelineValue = 0,
+                VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+        /**
+         * @brief Graphics submit which waits for the compute work at the stage consuming its results
+         *
+         * @note Submit info must not have pNext, binary semaphores of it are kept
+         */
+        VkResult SubmitAfterCompute(const VkSubmitInfo& submitInfo, uint64_t computeValue, VkPipelineStageFlags stage, VkFence fence = VK_NULL_HANDLE);
+
+        [[nodiscard]] bool IsComputeComplete(uint64_t computeValue) const;
+        bool WaitCompute(uint64_t computeValue, uint64_t timeout = UINT64_MAX) const;
+
+        /**
+         * @brief Pool of the dedicated transfer family, or the graphics one if the device hasn't it
+         *
+         * @note Buffers and images with exclusive sharing mode written by it are released with
+         *       Tools::Insert::ImageOwnershipBarrier() / BufferOwnershipBarrier() from GetTransferIndex()
+         *       to GetGraphicsIndex(), the graphics command buffer records the matching acquire barrier.
+         */
+        [[nodiscard]] inline Types::CmdPool* GetTransferCmdPool() const noexcept { return m_transferCmdPool; }
+
+        /// batch of the kernel pools, copies go to the dedicated transfer queue if there is one
+        [[nodiscard]] Types::UploadBatch* CreateUploadBatch() const {
+            return Types::UploadBatch::Create(m_device, m_allocator, m_cmdPool, m_transferCmdPool);
+        }
+
+        /**
+         * @brief Streamer of the kernel pools, call its Update() on the render thread after PrepareFrame()
+         *
+         * @note Destroy it before the kernel, after the device is idle
+         */
+        [[nodiscard]] Complexes::TextureStreamer* CreateTextureStreamer(uint32_t countThreads = 0, Types::Texture* placeholder = nullptr) const {
+            return Complexes::TextureStreamer::Create(
+                    m_device, m_allocator, m_descriptorManager, m_cmdPool, m_transferCmdPool, m_maxFramesInFlight, countThreads, placeholder);
+        }
 
-            this->m_framebuffersQueue = newQueue;
+        /**
+         * @brief Compute mip generator, given to upload batches, textures and the streamer
+         *
+         * @param source Path to Resources/Shaders/mipmaps.comp
+         * @note Destroy it before the kernel, after batches which have used it are completed
+         */
+        [[nodiscard]] Complexes::MipGenerator* CreateMipGenerator(const std::string& source, const std::string& cache) const {
+            return Complexes::MipGenerator::Create(m_device, m_allocator, source, cache, m_pipelineCache);
         }
 
+        /**
+         * @brief Submits uploads to the transfer queue, they run on the copy engine concurrently with rendering
+         *
+         * @return Value of the transfer timeline which is signaled on completion, 0 - error
+         *
+         * @note Any thread if the transfer family is dedicated, otherwise it's the graphics queue and only the
+         *       render thread can submit. Command buffers must be recorded from a pool of the transfer family.
+         */
+        uint64_t SubmitTransfer(const VkCommandBuffer* cmdBuffs, uint32_t count);
+
+        /**
+         * @brief Graphics submit with the acquire barriers, waits for the upload at the stage consuming it
+         *
+         * @note Render thread, the same restrictions as for SubmitAfterCompute()
+         */
+        VkResult SubmitAfterTransfer(const VkSubmitInfo& submitInfo, uint64_t transferValue, VkPipelineStageFlags stage, VkFence fence = VK_NULL_HANDLE);
+
+        [[nodiscard]] bool IsTransferComplete(uint64_t transferValue) const;
+        bool WaitTransfer(uint64_t transferValue, uint64_t timeout = UINT64_MAX) const;
+
         void SetMultisampling(const uint32_t& sampleCount);
 
         void SetGUIEnabled(bool enabled) { this->m_GUIEnabled = enabled; }
 
+        inline bool SetFramesInFlight(uint8_t count) {
+            if (m_isPostInitialized) {
+                Tools::VkDebug::Error("VulkanKernel::SetFramesInFlight() : at this stage it is not possible to set this parameter!");
+                return false;
+            }
+
+            if (count == 0) {
+                Tools::VkDebug::Error("VulkanKernel::SetFramesInFlight() : count frames in flight is zero!");
+                return false;
+            }
+
+            this->m_maxFramesInFlight = count;
+
+            return true;
+        }
+
+        /// call before PostInit(), 0 disables the staging ring of the allocator
+        inline bool SetStagingRingSize(VkDeviceSize size) {
+            if (m_isPostInitialized) {
+                Tools::VkDebug::Error("VulkanKernel::SetStagingRingSize() : at this stage it is not possible to set this parameter!");
+                return false;
+            }
+
+            this->m_stagingRingSize = size;
+
+            return true;
+        }
+
+        /// call before PostInit(), bytes of uniforms per frame, 0 disables the uniform ring
+        inline bool SetUniformRingSize(VkDeviceSize size) {
+            if (m_isPostInitialized) {
+                Tools::VkDebug::Error("VulkanKernel::SetUniformRingSize() : at this stage it is not possible to set this parameter!");
+                return false;
+            }
+
+            this->m_uniformRingSize = size;
+
+            return true;
+        }
+
+        /**
+         * @brief Surfaceless kernel, the swapchain is a ring of offscreen images
+         *
+         * @note Call before PreInit(). Init() ignores platform callback and window handle,
+         *       device extensions should not require VK_KHR_swapchain.
+         */
+        inline bool SetHeadless(bool value, uint32_t countImages = 3, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM) {
+            if (m_isPreInitialized) {
+                Tools::VkDebug::Error("VulkanKernel::SetHeadless() : at this stage it is not possible to set this parameter!");
+                return false;
+            }
+
+            this->m_headless            = value;
+            this->m_headlessCountImages = countImages;
+            this->m_headlessFormat      = format;
+
+            return true;
+        }
+
+        [[nodiscard]] inline bool IsHeadless() const noexcept { return m_headless; }
+
+        /**
+         * @brief Copies the swapchain image to the host, tightly packed rows of texels of the headless format
+         *
+         * @note Only for headless mode, call it between frames. Blocks until the frame which uses the image
+         *       is completed. Images which haven't been rendered since the last re-setup are rejected.
+         */
+        bool ReadPixels(uint32_t imageIndex, std::vector<uint8_t>& pixels);
+
+        /// last presented image, see ReadPixels()
+        [[nodiscard]] inline uint32_t GetPresentedImageIndex() const noexcept { return m_currentBuffer; }
+
+        /**
+         * @brief Copies the image to the host after the frame is rendered, without waiting for the queue.
+         *        The callback or the future is resolved on a worker thread when the frame fence is waited
+         *
+         * @note Call between PrepareFrame() and SubmitFrame(), render thread only. The copy waits for the
+         *       render complete semaphore, so the image must be written by the frame before it is signaled.
+         */
+        bool ReadbackImage(const Complexes::ReadbackRequest& request, Complexes::ReadbackCallback&& callback);
+        std::future<Complexes::ReadbackResult> ReadbackImage(const Complexes::ReadbackRequest& request);
+
+        /// image of the swapchain rendered this frame, converted to RGBA8. Empty if the surface doesn't support transfer source usage
+        [[nodiscard]] Complexes::ReadbackRequest GetSwapchainReadback() const;
+
+        /// FIFO, FIFO_RELAXED, MAILBOX or IMMEDIATE. After Init() it takes effect at the next swapchain re-setup
+        void SetPresentMode(VkPresentModeKHR presentMode);
+        /// 0 - minimal count + 1. After Init() it takes effect at the next swapchain re-setup
+        void SetSwapchainImages(uint32_t countImages);
+        /// max count of queued presents which have not been displayed yet, 0 - unlimited
+        void SetMaxFrameLatency(uint32_t frames) { m_maxFrameLatency = frames; }
+        /// CPU-side limiter, 0 - unlimited
+        void SetFrameRateLimit(double fps);
+
         inline bool SetValidationLayersEnabled(const bool& value) {
             if (m_isPreInitialized) {
                 Tools::VkDebug::Error("VulkanKernel::SetValidationLayersEnabled() : at this stage it is not possible to set this parameter!");
@@ -192,10 +643,159 @@ namespace EvoVulkan::Core {
             return true;
         }
         void SetSize(uint32_t width, uint32_t height);
+
+        /**
+         * @brief Re-creates the swapchain with the size reported by SetSize()
+         *
+         * @note Doesn't wait for the size. Until it arrives a suboptimal swapchain is still presented,
+         *       an out of date one is re-created with the current size of the surface. Frames in flight
+         *       aren't waited for either, the old swapchain, its framebuffers and command buffers are
+         *       destroyed by the deletion queue when the frames are completed.
+         */
         bool ResizeWindow();
+
+        /**
+         * @brief Kernel-owned thread which renders a frame per packet
+         *
+         * @note Packets and sizes must be pushed from one thread only (single producer)
+         */
+        bool StartRenderThread();
+        void StopRenderThread();
+        /// returns false if the render thread is behind and the queue is full
+        bool PushFramePacket(FramePacket&& packet);
+        /**
+         * @brief Blocks the producer until the render thread takes a packet from the full queue
+         *
+         * @return false if the render thread isn't running or the timeout has expired
+         */
+        bool WaitFramePacketSlot(std::chrono::milliseconds timeout);
+
+        [[nodiscard]] inline bool IsRenderThreadActive() const noexcept { return m_renderThreadActive; }
+
+        /**
+         * @brief Command buffer which is valid until the same frame slot comes again
+         *
+         * @note Never free it, the pool of the frame is reset in PrepareFrame(). Render thread only.
+         */
+        VkCommandBuffer AllocateFrameCmdBuffer(VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        /**
+         * @brief Destroys the object when frames which could use it are completed
+         *
+         * @note Render thread. Works with any object with Destroy() and Free() (Texture, VmaBuffer, FrameBuffer, Shader...)
+         */
+        template<typename T> void DeferredFree(T* object) {
+            if (!object)
+                return;
+
+            m_deletionQueue.Push(m_frameCounter, [object]() {
+                object->Destroy();
+                object->Free();
+            });
+        }
+
+        /// same as DeferredFree(), but for raw handles and custom deleters
+        void DeferredDestroy(Memory::DeletionQueue::Deleter&& deleter) {
+            m_deletionQueue.Push(m_frameCounter, std::move(deleter));
+        }
+
+        /// creates a command pool per worker and persistent threads for all of them but one, 0 - hardware concurrency
+        bool SetRecordingThreads(uint32_t countThreads = 0);
+
+        /**
+         * @brief Records draw command buffers with secondary buffers on worker threads
+         *
+         * @param countItems Draw items are split into contiguous ranges, one per worker
+         * @param record Called on worker threads, viewport and scissor are already set
+         *
+         * @note Draw command buffers must not be in use by the GPU (e.g. from BuildCmdBuffers())
+         */
+        bool RecordCmdBuffersParallel(uint32_t countItems, const SecondaryRecordFn& record, const std::vector<VkClearValue>& clearValues);
+
+        /**
+         * @brief Pass with cached secondary command buffers, re-recorded only when it is marked dirty
+         *
+         * @param target Offscreen framebuffer or nullptr for the swapchain render pass.
+         *               Passes of one target are executed in the order of adding.
+         * @param everyFrame The pass is marked dirty and re-recorded every frame (e.g. dynamic offsets of the
+         *                   uniform ring), its recording doesn't restart the warmup of the heap guard
+         * @return index of the pass or -1
+         */
+        int32_t AddRecordPass(Complexes::FrameBuffer* target, uint32_t countItems, const SecondaryRecordFn& record, bool everyFrame = false);
+        void MarkPassDirty(uint32_t pass);
+        /// @param imageIndex Swapchain image, or frame in flight if the pass has a target
+        void MarkPassDirty(uint32_t pass, uint32_t imageIndex);
+        /**
+         * @brief Moves the pass to another offscreen framebuffer, e.g. re-created by OnResize(), and marks it dirty
+         *
+         * @note The old target may be still used by frames in flight, release it with DeferredFree()
+         */
+        void SetPassTarget(uint32_t pass, Complexes::FrameBuffer* target);
+        /// marks the pass dirty if count has been changed
+        void SetPassCountItems(uint32_t pass, uint32_t countItems);
+        void MarkAllPassesDirty();
+
+        /**
+         * @brief Re-records dirty passes on worker threads and primary buffers which execute them
+         *
+         * @param clearValues Clear values of the swapchain pass, ResizeWindow() re-records with them
+         *
+         * @note Passes own draw command buffers and command buffers of their targets.
+         *       Affected command buffers must not be in use by the GPU.
+         */
+        bool RecordDirtyPasses(const std::vector<VkClearValue>& clearValues);
     public:
+        /**
+         * @brief Linear allocator of the current frame in flight
+         *
+         * @note Reset in PrepareFrame() when the same slot comes again. Render thread only.
+         */
+        [[nodiscard]] inline Memory::LinearArena* GetFrameArena() const { return m_frameArenas[m_currentFrame]; }
+
+        /**
+         * @brief Uniforms written this frame, nullptr if the ring is disabled
+         *
+         * @note Rewound in PrepareFrame() with the frame arena. Offsets are passed as dynamic offsets of a
+         *       VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC binding, the descriptor is written once.
+         */
+        [[nodiscard]] inline Memory::UniformRing* GetUniformRing() const { return m_uniformRing; }
+
+        /**
+         * @brief Reports frames of NextFrame() which have allocated from the global heap
+         *
+         * @param warmupFrames Frames after enabling, resize or re-recording which are not a steady state
+         *
+         * @note Requires EVK_HEAP_GUARD_OPERATORS in the application, see Tools/HeapGuard.h. Allocations of
+         *       recording and readback workers made while a frame is rendered are counted for this frame.
+         */
+        void SetHeapGuard(bool enabled, uint32_t warmupFrames = 16);
+        [[nodiscard]] inline uint64_t GetHeapGuardViolations() const noexcept { return m_heapGuardViolations; }
+
+        /**
+         * @brief Additional window which shares device, allocator, pipelines and descriptors with the main one
+         *
+         * @note After PostInit(), render thread only. Surface format must match the main swapchain.
+         */
+        Complexes::PresentTarget* AddPresentTarget(
+                const std::function<VkSurfaceKHR(const VkInstance&)>& platformCreate,
+                void* windowHandle,
+                uint32_t width,
+                uint32_t height);
+
+        /// the target is destroyed when frames which could use it are completed, call between frames
+        void RemovePresentTarget(Complexes::PresentTarget* target);
+
+        [[nodiscard]] inline const std::vector<Complexes::PresentTarget*>& GetPresentTargets() const noexcept { return m_presentTargets; }
+
         //static VulkanKernel* Create();
         virtual bool Destroy();
+        /**
+         * @brief Called after the swapchain re-setup, before the passes are re-recorded
+         *
+         * @note Frames in flight aren't waited for. Resources they use (offscreen framebuffers, descriptor sets
+         *       bound by recorded passes) must be re-created and the old ones released with DeferredFree()
+         *       or DeferredDestroy(), instead of being changed in place.
+         */
         virtual bool OnResize() = 0;
         virtual bool OnComplete() { return true; }
     public:
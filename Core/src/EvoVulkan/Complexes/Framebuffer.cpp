@@ -62,10 +62,12 @@ void EvoVulkan::Complexes::FrameBuffer::Free()  {
         m_semaphore = VK_NULL_HANDLE;
     }
 
-    if (m_cmdBuff != VK_NULL_HANDLE) {
-        vkFreeCommandBuffers(*m_device, *m_cmdPool, 1, &m_cmdBuff);
-        m_cmdBuff = VK_NULL_HANDLE;
-    }
+    for (auto&& cmdBuff : m_frameCmdBuffs)
+        if (cmdBuff != VK_NULL_HANDLE)
+            vkFreeCommandBuffers(*m_device, *m_cmdPool, 1, &cmdBuff);
+
+    m_frameCmdBuffs.clear();
+    m_cmdBuff = VK_NULL_HANDLE;
 
     if (m_renderPass.Ready())
         Types::DestroyRenderPass(m_device, &m_renderPass);
@@ -98,13 +100,19 @@ EvoVulkan::Complexes::FrameBuffer *EvoVulkan::Complexes::FrameBuffer::Create(
         const std::vector<VkFormat> &colorAttachments,
         uint32_t width,
         uint32_t height,
-        float scale)
+        float scale,
+        uint32_t countFrames)
 {
     if (scale <= 0.f) {
         VK_ERROR("Framebuffer::Create() : scale <= zero!");
         return nullptr;
     }
 
+    if (countFrames == 0) {
+        VK_ERROR("Framebuffer::Create() : count frames is zero!");
+        return nullptr;
+    }
+
     auto fbo = new FrameBuffer();
     {
         fbo->m_scale             = scale;
@@ -124,7 +132,17 @@ EvoVulkan::Complexes::FrameBuffer *EvoVulkan::Complexes::FrameBuffer::Create(
         return nullptr;
     }
 
-    fbo->m_cmdBuff    = Types::CmdBuffer::CreateSimple(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    /// a frame in flight may still execute its command buffer while the next one is submitted
+    for (uint32_t i = 0; i < countFrames; ++i) {
+        fbo->m_frameCmdBuffs.emplace_back(Types::CmdBuffer::CreateSimple(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+
+        if (fbo->m_frameCmdBuffs.back() == VK_NULL_HANDLE) {
+            VK_ERROR("Framebuffer::Create() : failed to create command buffer!");
+            return nullptr;
+        }
+    }
+
+    fbo->m_cmdBuff    = fbo->m_frameCmdBuffs.front();
     fbo->m_cmdBufInfo = Tools::Initializers::CommandBufferBeginInfo();
 
     if (!fbo->CreateRenderPass()) {
@@ -325,7 +343,7 @@ bool EvoVulkan::Complexes::FrameBuffer::CreateAttachments()  {
                 m_device,
                 m_allocator,
                 m_attachFormats[i],
-                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
                 { m_width, m_height });
 
         //auto copyCmd = Types::CmdBuffer::BeginSingleTime(m_device, m_cmdPool);
@@ -0,0 +1,394 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Complexes/MipGenerator.h>
+#include <EvoVulkan/Complexes/Shader.h>
+
+#include <EvoVulkan/Types/UploadBatch.h>
+#include <EvoVulkan/Types/VmaBuffer.h>
+#include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/VulkanInsert.h>
+#include <EvoVulkan/Tools/StringUtils.h>
+#include <EvoVulkan/Tools/FileSystem.h>
+
+#include <array>
+
+/// sets of a descriptor pool, every set has MaxLevels storage images
+static constexpr uint32_t g_mipSetsPerPool = 16;
+
+static bool IsSRGB(VkFormat format) {
+    return format == VK_FORMAT_R8G8B8A8_SRGB;
+}
+
+/// format of the storage views, VK_FORMAT_UNDEFINED - unsupported
+static VkFormat GetStorageFormat(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return VK_FORMAT_R32G32B32A32_SFLOAT;
+        default:
+            return VK_FORMAT_UNDEFINED;
+    }
+}
+
+EvoVulkan::Complexes::MipGenerator* EvoVulkan::Complexes::MipGenerator::Create(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        const std::string& source,
+        const std::string& cache,
+        VkPipelineCache pipelineCache)
+{
+    if (!device || !allocator) {
+        VK_ERROR("MipGenerator::Create() : device or allocator is nullptr!");
+        return nullptr;
+    }
+
+    VK_LOG("MipGenerator::Create() : create compute mip generator...");
+
+    auto* generator = new MipGenerator();
+    {
+        generator->m_device    = device;
+        generator->m_allocator = allocator;
+        generator->m_variants  = {
+                { VK_FORMAT_R8G8B8A8_UNORM,      "rgba8"   },
+                { VK_FORMAT_R16G16B16A16_SFLOAT, "rgba16f" },
+                { VK_FORMAT_R32G32B32A32_SFLOAT, "rgba32f" },
+        };
+    }
+
+    const std::vector<VkDescriptorSetLayoutBinding> bindings = {
+            Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, 0, MaxLevels),
+            Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+    };
+
+    auto setLayoutCI = Tools::Initializers::DescriptorSetLayoutCreateInfo(bindings);
+    if (vkCreateDescriptorSetLayout(*device, &setLayoutCI, nullptr, &generator->m_setLayout) != VK_SUCCESS) {
+        VK_ERROR("MipGenerator::Create() : failed to create descriptor set layout!");
+        generator->Destroy();
+        generator->Free();
+        return nullptr;
+    }
+
+    const VkPushConstantRange pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(Constants) };
+
+    auto pipelineLayoutCI = Tools::Initializers::PipelineLayoutCreateInfo(&generator->m_setLayout, 1);
+    pipelineLayoutCI.pushConstantRangeCount = 1;
+    pipelineLayoutCI.pPushConstantRanges    = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(*device, &pipelineLayoutCI, nullptr, &generator->m_pipelineLayout) != VK_SUCCESS) {
+        VK_ERROR("MipGenerator::Create() : failed to create pipeline layout!");
+        generator->Destroy();
+        generator->Free();
+        return nullptr;
+    }
+
+    Tools::CreatePath(Tools::FixPath(cache + "/"));
+
+    /// one variant per storage format, formats without storage support are generated by blits
+    for (auto&& variant : generator->m_variants) {
+        VkFormatProperties properties = {};
+        vkGetPhysicalDeviceFormatProperties(*device, variant.m_format, &properties);
+
+        if (!(properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT))
+            continue;
+
+        const std::string out = cache + "/mipmaps." + std::string(variant.m_glsl) + ".comp.spv";
+
+        if (Tools::FileExists(out))
+            Tools::RemoveFile(out);
+
+        system(std::string(Shader::GetGlslCompiler() + " -c ")
+                .append("-DFORMAT=" + std::string(variant.m_glsl) + " ")
+                .append(source).append(" -o " + out).c_str());
+
+        auto shaderModule = Tools::LoadShaderModule(out.c_str(), *device);
+        if (shaderModule == VK_NULL_HANDLE) {
+            VK_ERROR("MipGenerator::Create() : failed to load shader module! \n\tPath: " + out);
+            continue;
+        }
+
+        auto pipelineCI = Tools::Initializers::ComputePipelineCreateInfo(generator->m_pipelineLayout);
+        pipelineCI.stage = Tools::Initializers::PipelineShaderStageCreateInfo(shaderModule, VK_SHADER_STAGE_COMPUTE_BIT);
+
+        if (vkCreateComputePipelines(*device, pipelineCache, 1, &pipelineCI, nullptr, &variant.m_pipeline) != VK_SUCCESS) {
+            VK_ERROR("MipGenerator::Create() : failed to create compute pipeline for " + std::string(variant.m_glsl) + "!");
+            variant.m_pipeline = VK_NULL_HANDLE;
+        }
+
+        vkDestroyShaderModule(*device, shaderModule, nullptr);
+    }
+
+    generator->m_counters = Types::VmaBuffer::Create(
+            allocator,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY,
+            sizeof(uint32_t) * MaxLayers);
+
+    if (!generator->FindVariant(VK_FORMAT_R8G8B8A8_UNORM) || *generator->m_counters == VK_NULL_HANDLE) {
+        VK_ERROR("MipGenerator::Create() : failed to create pipelines or counters!");
+        generator->Destroy();
+        generator->Free();
+        return nullptr;
+    }
+
+    return generator;
+}
+
+void EvoVulkan::Complexes::MipGenerator::Destroy() {
+    if (!m_device)
+        return;
+
+    for (auto&& variant : m_variants)
+        if (variant.m_pipeline != VK_NULL_HANDLE) {
+            vkDestroyPipeline(*m_device, variant.m_pipeline, nullptr);
+            variant.m_pipeline = VK_NULL_HANDLE;
+        }
+
+    if (m_pipelineLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(*m_device, m_pipelineLayout, nullptr);
+        m_pipelineLayout = VK_NULL_HANDLE;
+    }
+
+    if (m_setLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(*m_device, m_setLayout, nullptr);
+        m_setLayout = VK_NULL_HANDLE;
+    }
+
+    /// batches which have recorded dispatches must be completed or destroyed before
+    for (auto&& pool : m_pools) {
+        if (pool->m_used > 0)
+            VK_WARN("MipGenerator::Destroy() : " + std::to_string(pool->m_used) + " descriptor sets are still in use!");
+        delete pool;
+    }
+    m_pools.clear();
+
+    if (m_counters) {
+        m_counters->Destroy();
+        m_counters->Free();
+        m_counters = nullptr;
+    }
+
+    m_device = nullptr;
+}
+
+void EvoVulkan::Complexes::MipGenerator::Free() {
+    delete this;
+}
+
+const EvoVulkan::Complexes::MipGenerator::Variant* EvoVulkan::Complexes::MipGenerator::FindVariant(VkFormat format) const {
+    const VkFormat storageFormat = GetStorageFormat(format);
+
+    for (auto&& variant : m_variants)
+        if (variant.m_format == storageFormat && variant.m_pipeline != VK_NULL_HANDLE)
+            return &variant;
+
+    return nullptr;
+}
+
+bool EvoVulkan::Complexes::MipGenerator::IsSupported(
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        uint32_t layerCount) const
+{
+    if (width > MaxSize || height > MaxSize || mipLevels > MaxLevels || layerCount > MaxLayers || !FindVariant(format))
+        return false;
+
+    /// levels are written by views of the storage format
+    VkFormatProperties properties = {};
+    vkGetPhysicalDeviceFormatProperties(*m_device, GetStorageFormat(format), &properties);
+
+    if (!(properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT))
+        return false;
+
+    /// sRGB images have the storage usage only through the extended usage of their UNORM views
+    VkImageFormatProperties imageProperties = {};
+    const VkResult result = vkGetPhysicalDeviceImageFormatProperties(
+            *m_device, format, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+            GetImageFlags(format), &imageProperties);
+
+    return result == VK_SUCCESS && imageProperties.maxArrayLayers >= layerCount && imageProperties.maxMipLevels >= mipLevels;
+}
+
+VkImageCreateFlags EvoVulkan::Complexes::MipGenerator::GetImageFlags(VkFormat format) {
+    /// sRGB formats can't be storage, they are written by UNORM views and the storage usage is valid only for them
+    return IsSRGB(format) ? (VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT) : 0;
+}
+
+EvoVulkan::Core::DescriptorSet EvoVulkan::Complexes::MipGenerator::AllocateSet() {
+    for (auto&& pool : m_pools) {
+        if (pool->m_used >= pool->m_maxSets)
+            continue;
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        auto allocInfo = Tools::Initializers::DescriptorSetAllocateInfo(*pool, &m_setLayout, 1);
+        if (vkAllocateDescriptorSets(*m_device, &allocInfo, &set) == VK_SUCCESS) {
+            ++pool->m_used;
+            return Core::DescriptorSet(set, m_setLayout, pool, UINT32_MAX);
+        }
+    }
+
+    const std::vector<VkDescriptorPoolSize> sizes = {
+            Tools::Initializers::DescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, g_mipSetsPerPool * MaxLevels),
+            Tools::Initializers::DescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, g_mipSetsPerPool),
+    };
+
+    auto&& pool = Core::DescriptorPool::Create(m_device, g_mipSetsPerPool, sizes);
+    if (!pool) {
+        VK_ERROR("MipGenerator::AllocateSet() : failed to create descriptor pool!");
+        return Core::DescriptorSet();
+    }
+
+    m_pools.emplace_back(pool);
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    auto allocInfo = Tools::Initializers::DescriptorSetAllocateInfo(*pool, &m_setLayout, 1);
+    if (vkAllocateDescriptorSets(*m_device, &allocInfo, &set) != VK_SUCCESS) {
+        VK_ERROR("MipGenerator::AllocateSet() : failed to allocate descriptor set!");
+        return Core::DescriptorSet();
+    }
+
+    ++pool->m_used;
+
+    return Core::DescriptorSet(set, m_setLayout, pool, UINT32_MAX);
+}
+
+void EvoVulkan::Complexes::MipGenerator::FreeSet(const Core::DescriptorSet& set) {
+    if (!set.m_pool || !m_device)
+        return;
+
+    vkFreeDescriptorSets(*m_device, *set.m_pool, 1, &set.m_self);
+    --set.m_pool->m_used;
+}
+
+bool EvoVulkan::Complexes::MipGenerator::Record(
+        Types::UploadBatch* batch,
+        VkImage image,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        uint32_t layerCount)
+{
+    auto&& variant = FindVariant(format);
+    if (!variant || !IsSupported(format, width, height, mipLevels, layerCount) || !batch->IsRecording()) {
+        VK_ERROR("MipGenerator::Record() : format or size isn't supported, or batch isn't recording!");
+        return false;
+    }
+
+    /// one storage view per level, unused descriptors of the array repeat the last one
+    std::vector<VkImageView> views(mipLevels, VK_NULL_HANDLE);
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        VkImageViewCreateInfo viewCI           = Tools::Initializers::ImageViewCreateInfo();
+        viewCI.image                           = image;
+        viewCI.viewType                        = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewCI.format                          = variant->m_format;
+        viewCI.components                      = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+        viewCI.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewCI.subresourceRange.baseMipLevel   = level;
+        viewCI.subresourceRange.levelCount     = 1;
+        viewCI.subresourceRange.baseArrayLayer = 0;
+        viewCI.subresourceRange.layerCount     = layerCount;
+
+        if (vkCreateImageView(*m_device, &viewCI, nullptr, &views[level]) != VK_SUCCESS) {
+            VK_ERROR("MipGenerator::Record() : failed to create image view of level " + std::to_string(level) + "!");
+            for (auto&& view : views)
+                if (view != VK_NULL_HANDLE)
+                    vkDestroyImageView(*m_device, view, nullptr);
+            return false;
+        }
+    }
+
+    const Core::DescriptorSet set = AllocateSet();
+    if (set.m_self == VK_NULL_HANDLE) {
+        for (auto&& view : views)
+            vkDestroyImageView(*m_device, view, nullptr);
+        return false;
+    }
+
+    /// the batch can't be completed before the generator is destroyed, see Destroy()
+    batch->Defer([this, set, views]() {
+        this->FreeSet(set);
+        for (auto&& view : views)
+            vkDestroyImageView(*m_device, view, nullptr);
+    });
+
+    std::array<VkDescriptorImageInfo, MaxLevels> imageInfos = {};
+    for (uint32_t i = 0; i < MaxLevels; ++i)
+        imageInfos[i] = Tools::Initializers::DescriptorImageInfo(VK_NULL_HANDLE, views[std::min(i, mipLevels - 1)], VK_IMAGE_LAYOUT_GENERAL);
+
+    std::array<VkWriteDescriptorSet, 2> writes = {};
+    writes[0] = Tools::Initializers::WriteDescriptorSet(set, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0, imageInfos.data(), MaxLevels);
+    writes[1] = Tools::Initializers::WriteDescriptorSet(set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, m_counters->GetDescriptorRef());
+
+    vkUpdateDescriptorSets(*m_device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+    //!=================================================================================================================
+
+    const VkCommandBuffer cmd = batch->GetCmd();
+
+    const VkImageSubresourceRange subresourceRange = {
+            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel   = 0,
+            .levelCount     = mipLevels,
+            .baseArrayLayer = 0,
+            .layerCount     = layerCount
+    };
+
+    /// the previous dispatch (of any batch on this queue) has finished with the counters
+    Tools::Insert::BufferOwnershipBarrier(
+            cmd, *m_counters, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, VK_WHOLE_SIZE);
+
+    vkCmdFillBuffer(cmd, *m_counters, 0, VK_WHOLE_SIZE, 0);
+
+    Tools::Insert::BufferOwnershipBarrier(
+            cmd, *m_counters, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, VK_WHOLE_SIZE);
+
+    Tools::Insert::ImageMemoryBarrier(
+            cmd, image,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            subresourceRange);
+
+    /// 64x64 texels of the first level per work group
+    const uint32_t groupsX = (width + 63) / 64;
+    const uint32_t groupsY = (height + 63) / 64;
+
+    Constants constants;
+    {
+        constants.m_width  = static_cast<int32_t>(width);
+        constants.m_height = static_cast<int32_t>(height);
+        constants.m_levels = mipLevels - 1;
+        constants.m_groups = groupsX * groupsY;
+        constants.m_srgb   = IsSRGB(format) ? 1 : 0;
+    }
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, variant->m_pipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &set.m_self, 0, nullptr);
+    vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(Constants), &constants);
+    vkCmdDispatch(cmd, groupsX, groupsY, layerCount);
+
+    Tools::Insert::ImageMemoryBarrier(
+            cmd, image,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            subresourceRange);
+
+    return true;
+}
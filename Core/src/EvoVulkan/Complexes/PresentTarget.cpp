@@ -0,0 +1,295 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Complexes/PresentTarget.h>
+
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+#include <EvoVulkan/Tools/VulkanConverter.h>
+#include <EvoVulkan/Tools/VulkanInitializers.h>
+
+#include <EvoVulkan/Memory/Allocator.h>
+
+/// the surface extent is undefined on some platforms, then the window size is used
+static VkExtent2D GetSurfaceExtent(const EvoVulkan::Types::Device* device, const EvoVulkan::Types::Surface* surface, uint32_t width, uint32_t height) {
+    VkSurfaceCapabilitiesKHR surfCaps = {};
+    if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(*device, *surface, &surfCaps) != VK_SUCCESS)
+        return { 0, 0 };
+
+    if (surfCaps.currentExtent.width == UINT32_MAX)
+        return { width, height };
+
+    return surfCaps.currentExtent;
+}
+
+EvoVulkan::Complexes::PresentTarget* EvoVulkan::Complexes::PresentTarget::Create(
+        const VkInstance& instance,
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        EvoVulkan::Types::CmdPool* cmdPool,
+        EvoVulkan::Types::Surface* surface,
+        const EvoVulkan::Types::RenderPass& renderPass,
+        VkFormat colorFormat,
+        bool multisampling,
+        bool vsync,
+        VkPresentModeKHR presentMode,
+        uint32_t countImages,
+        uint8_t framesInFlight,
+        uint32_t width,
+        uint32_t height)
+{
+    VK_GRAPH("PresentTarget::Create() : create present target...");
+
+    /// the kernel presents on the graphics queue
+    VkBool32 presentSupported = VK_FALSE;
+    vkGetPhysicalDeviceSurfaceSupportKHR(*device, device->GetQueues()->GetGraphicsIndex(), *surface, &presentSupported);
+    if (!presentSupported) {
+        VK_ERROR("PresentTarget::Create() : graphics queue can't present to the surface!");
+        EVSafeFreeObject(surface);
+        return nullptr;
+    }
+
+    auto* target = new PresentTarget();
+    {
+        target->m_device        = device;
+        target->m_allocator     = allocator;
+        target->m_cmdPool       = cmdPool;
+        target->m_surface       = surface;
+        target->m_renderPass    = renderPass;
+        target->m_multisampling = multisampling;
+        target->m_newWidth      = width;
+        target->m_newHeight     = height;
+    }
+
+    const VkExtent2D extent = GetSurfaceExtent(device, surface, width, height);
+
+    target->m_swapchain = Types::Swapchain::Create(instance, surface, device, vsync, extent.width, extent.height, presentMode, countImages);
+    if (!target->m_swapchain) {
+        VK_ERROR("PresentTarget::Create() : failed to create swapchain!");
+        target->Destroy();
+        target->Free();
+        return nullptr;
+    }
+
+    /// pipelines of the kernel render pass are used for this window
+    if (target->m_swapchain->GetColorFormat() != colorFormat) {
+        VK_ERROR("PresentTarget::Create() : surface format isn't compatible with the kernel render pass! Format: " +
+                 Tools::Convert::format_to_string(target->m_swapchain->GetColorFormat()));
+        target->Destroy();
+        target->Free();
+        return nullptr;
+    }
+
+    target->m_multisample = Types::MultisampleTarget::Create(
+            device,
+            allocator,
+            target->m_swapchain,
+            extent.width,
+            extent.height,
+            { colorFormat },
+            device->MultisampleEnabled());
+
+    for (uint8_t i = 0; i < framesInFlight && target->m_multisample; ++i) {
+        auto&& sync = Tools::CreateSynchronization(*device);
+        if (!sync.IsReady())
+            break;
+        target->m_frameSyncs.emplace_back(sync);
+    }
+
+    if (!target->m_multisample || target->m_frameSyncs.size() != framesInFlight || !target->ReCreateFrameBuffers()) {
+        VK_ERROR("PresentTarget::Create() : failed to create frame resources!");
+        target->Destroy();
+        target->Free();
+        return nullptr;
+    }
+
+    return target;
+}
+
+void EvoVulkan::Complexes::PresentTarget::SetSize(uint32_t width, uint32_t height) {
+    this->m_newWidth  = width;
+    this->m_newHeight = height;
+    this->m_outOfDate = true;
+}
+
+bool EvoVulkan::Complexes::PresentTarget::ReSetup(uint64_t frameCounter) {
+    const VkExtent2D extent = GetSurfaceExtent(m_device, m_surface, m_newWidth, m_newHeight);
+
+    /// window has been collapsed, keep the old swapchain until it's expanded
+    if (extent.width == 0 || extent.height == 0)
+        return true;
+
+    this->m_outOfDate = false;
+
+    for (auto&& fence : m_imagesInFlight)
+        if (fence != VK_NULL_HANDLE)
+            vkWaitForFences(*m_device, 1, &fence, VK_TRUE, UINT64_MAX);
+
+    if (!m_swapchain->ReSetup(extent.width, extent.height)) {
+        VK_ERROR("PresentTarget::ReSetup() : failed to re-setup swapchain!");
+        return false;
+    }
+
+    this->m_retireFrame = frameCounter;
+
+    if (!m_multisample->ReCreate(extent.width, extent.height)) {
+        VK_ERROR("PresentTarget::ReSetup() : failed to re-create multisample!");
+        return false;
+    }
+
+    return ReCreateFrameBuffers();
+}
+
+VkResult EvoVulkan::Complexes::PresentTarget::Acquire(uint32_t frameIndex, VkFence frameFence, uint64_t frameCounter, uint8_t framesInFlight) {
+    this->m_acquired = false;
+
+    /// frames which could present images of the retired swapchains are completed
+    if (m_swapchain->HasRetired() && frameCounter >= m_retireFrame + framesInFlight)
+        m_swapchain->DestroyRetired();
+
+    if (m_outOfDate)
+        return VK_ERROR_OUT_OF_DATE_KHR;
+
+    this->m_syncs = m_frameSyncs[frameIndex];
+
+    VkResult result = m_swapchain->AcquireNextImage(m_syncs.m_presentComplete, &m_currentBuffer);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        this->m_outOfDate = true;
+        return result;
+    }
+
+    /// suboptimal image is acquired and the semaphore will be signaled, present it and re-create later
+    if (result == VK_SUBOPTIMAL_KHR)
+        this->m_outOfDate = true;
+    else if (result != VK_SUCCESS)
+        return result;
+
+    if (m_imagesInFlight[m_currentBuffer] != VK_NULL_HANDLE && m_imagesInFlight[m_currentBuffer] != frameFence)
+        vkWaitForFences(*m_device, 1, &m_imagesInFlight[m_currentBuffer], VK_TRUE, UINT64_MAX);
+
+    m_imagesInFlight[m_currentBuffer] = frameFence;
+
+    m_submitInfo = Tools::Initializers::SubmitInfo();
+    m_submitInfo.waitSemaphoreCount   = 1;
+    m_submitInfo.pWaitSemaphores      = &m_syncs.m_presentComplete;
+    m_submitInfo.pWaitDstStageMask    = &m_waitStage;
+    m_submitInfo.commandBufferCount   = 1;
+    m_submitInfo.pCommandBuffers      = &m_drawCmdBuffs[m_currentBuffer];
+    m_submitInfo.signalSemaphoreCount = 1;
+    m_submitInfo.pSignalSemaphores    = &m_syncs.m_renderComplete;
+
+    this->m_acquired = true;
+
+    return result;
+}
+
+bool EvoVulkan::Complexes::PresentTarget::ReCreateFrameBuffers() {
+    this->DestroyFrameBuffers();
+
+    const uint32_t countImages = m_swapchain->GetCountImages();
+
+    /// count images may be changed by re-setup
+    if (m_countDCB != countImages) {
+        if (m_drawCmdBuffs)
+            Tools::FreeCommandBuffers(*m_device, *m_cmdPool, &m_drawCmdBuffs, m_countDCB);
+
+        this->m_countDCB     = countImages;
+        this->m_drawCmdBuffs = Tools::AllocateCommandBuffers(
+                *m_device,
+                Tools::Initializers::CommandBufferAllocateInfo(*m_cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_countDCB));
+
+        if (!m_drawCmdBuffs) {
+            VK_ERROR("PresentTarget::ReCreateFrameBuffers() : failed to allocate draw command buffers!");
+            this->m_countDCB = 0;
+            return false;
+        }
+    }
+
+    this->m_imagesInFlight.assign(countImages, VK_NULL_HANDLE);
+
+    std::vector<VkImageView> attachments(m_renderPass.m_countAttachments);
+
+    if (m_multisampling) {
+        attachments[0] = m_multisample->GetResolve(0);
+        attachments[2] = m_multisample->GetDepth();
+    } else
+        attachments[1] = m_multisample->GetDepth();
+
+    VkFramebufferCreateInfo frameBufferCreateInfo = {};
+    frameBufferCreateInfo.sType                   = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    frameBufferCreateInfo.renderPass              = m_renderPass.m_self;
+    frameBufferCreateInfo.attachmentCount         = m_renderPass.m_countAttachments;
+    frameBufferCreateInfo.pAttachments            = attachments.data();
+    frameBufferCreateInfo.width                   = m_swapchain->GetSurfaceWidth();
+    frameBufferCreateInfo.height                  = m_swapchain->GetSurfaceHeight();
+    frameBufferCreateInfo.layers                  = 1;
+
+    m_frameBuffers.resize(countImages);
+    for (uint32_t i = 0; i < countImages; ++i) {
+        attachments[m_multisampling ? 1 : 0] = m_swapchain->GetBuffers()[i].m_view;
+
+        auto result = vkCreateFramebuffer(*m_device, &frameBufferCreateInfo, nullptr, &m_frameBuffers[i]);
+        if (result != VK_SUCCESS) {
+            VK_ERROR("PresentTarget::ReCreateFrameBuffers() : failed to create vulkan frame buffer! Reason: " +
+                     Tools::Convert::result_to_description(result));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void EvoVulkan::Complexes::PresentTarget::DestroyFrameBuffers() {
+    for (auto&& frameBuffer : m_frameBuffers)
+        if (frameBuffer != VK_NULL_HANDLE)
+            vkDestroyFramebuffer(*m_device, frameBuffer, nullptr);
+    m_frameBuffers.clear();
+}
+
+VkViewport EvoVulkan::Complexes::PresentTarget::GetViewport() const {
+    return Tools::Initializers::Viewport((float)GetWidth(), (float)GetHeight(), 0.0f, 1.0f);
+}
+
+VkRect2D EvoVulkan::Complexes::PresentTarget::GetScissor() const {
+    return Tools::Initializers::Rect2D(GetWidth(), GetHeight(), 0, 0);
+}
+
+bool EvoVulkan::Complexes::PresentTarget::IsReady() const {
+    return m_swapchain && m_swapchain->IsReady() && m_drawCmdBuffs && !m_frameBuffers.empty();
+}
+
+void EvoVulkan::Complexes::PresentTarget::Destroy() {
+    VK_LOG("PresentTarget::Destroy() : destroy present target...");
+
+    if (!m_device)
+        return;
+
+    this->DestroyFrameBuffers();
+
+    if (m_drawCmdBuffs)
+        Tools::FreeCommandBuffers(*m_device, *m_cmdPool, &m_drawCmdBuffs, m_countDCB);
+    this->m_countDCB = 0;
+
+    for (auto&& sync : m_frameSyncs)
+        Tools::DestroySynchronization(*m_device, &sync);
+    m_frameSyncs.clear();
+    m_syncs = {};
+
+    if (m_multisample) {
+        m_multisample->Destroy();
+        m_multisample->Free();
+        m_multisample = nullptr;
+    }
+
+    /// the swapchain has to be destroyed before its surface
+    EVSafeFreeObject(m_swapchain);
+    EVSafeFreeObject(m_surface);
+
+    m_imagesInFlight.clear();
+    m_device = nullptr;
+}
+
+void EvoVulkan::Complexes::PresentTarget::Free() {
+    delete this;
+}
@@ -0,0 +1,327 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Complexes/Readback.h>
+#include <EvoVulkan/Complexes/Framebuffer.h>
+
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/VulkanInsert.h>
+#include <EvoVulkan/Tools/HeapGuard.h>
+
+#include <algorithm>
+
+EvoVulkan::Complexes::ReadbackRequest EvoVulkan::Complexes::ReadbackRequest::Attachment(const FrameBuffer* frameBuffer, uint32_t id) {
+    if (!frameBuffer || frameBuffer->GetAttachment(id) == VK_NULL_HANDLE)
+        return ReadbackRequest();
+
+    const VkExtent2D extent = frameBuffer->GetRenderPassArea().extent;
+
+    ReadbackRequest request;
+    {
+        request.m_image  = frameBuffer->m_attachments[id].m_image;
+        request.m_format = frameBuffer->m_attachments[id].m_format;
+        request.m_width  = extent.width;
+        request.m_height = extent.height;
+        /// final layout of color attachments of the render pass
+        request.m_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    return request;
+}
+
+void EvoVulkan::Complexes::ConvertBGRAToRGBA(ReadbackResult& result) {
+    VkFormat format;
+
+    switch (result.m_format) {
+        case VK_FORMAT_B8G8R8A8_UNORM: format = VK_FORMAT_R8G8B8A8_UNORM; break;
+        case VK_FORMAT_B8G8R8A8_SRGB:  format = VK_FORMAT_R8G8B8A8_SRGB;  break;
+        default:
+            return;
+    }
+
+    for (size_t i = 0; i + 3 < result.m_pixels.size(); i += 4)
+        std::swap(result.m_pixels[i], result.m_pixels[i + 2]);
+
+    result.m_format = format;
+}
+
+EvoVulkan::Complexes::Readback* EvoVulkan::Complexes::Readback::Create(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        uint32_t countThreads)
+{
+    VK_GRAPH("Readback::Create() : create readback...");
+
+    if (!device || !allocator) {
+        VK_ERROR("Readback::Create() : invalid arguments!");
+        return nullptr;
+    }
+
+    auto* readback = new Readback();
+    {
+        readback->m_device    = device;
+        readback->m_allocator = allocator;
+    }
+
+    for (uint32_t i = 0; i < std::max(countThreads, 1u); ++i)
+        readback->m_workers.emplace_back(&Readback::WorkerLoop, readback);
+
+    return readback;
+}
+
+bool EvoVulkan::Complexes::Readback::Record(
+        VkCommandBuffer cmd,
+        uint64_t frame,
+        const ReadbackRequest& request,
+        ReadbackCallback&& callback)
+{
+    if (cmd == VK_NULL_HANDLE || request.m_image == VK_NULL_HANDLE || request.m_width == 0 || request.m_height == 0) {
+        VK_ERROR("Readback::Record() : invalid request!");
+        return false;
+    }
+
+    /// staging memory is sized by the table of formats, a guessed size could be overrun by the copy
+    const VkDeviceSize size = Tools::GetImageSize(request.m_format, request.m_width, request.m_height);
+    if (size == 0) {
+        VK_ERROR("Readback::Record() : unsupported format " + std::to_string(request.m_format) + "!");
+        return false;
+    }
+
+    Job job;
+    {
+        job.m_frame             = frame;
+        job.m_size              = size;
+        job.m_result.m_format   = request.m_format;
+        job.m_result.m_width    = request.m_width;
+        job.m_result.m_height   = request.m_height;
+        job.m_convert           = request.m_convert;
+        job.m_callback          = std::move(callback);
+    }
+
+    if (!AcquireStaging(size, job.m_staging)) {
+        VK_ERROR("Readback::Record() : failed to allocate readback buffer!");
+        return false;
+    }
+
+    VkImageSubresourceRange range = {};
+    range.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.baseMipLevel   = request.m_mipLevel;
+    range.levelCount     = 1;
+    range.baseArrayLayer = request.m_layer;
+    range.layerCount     = 1;
+
+    /// writes of the image are made available by the semaphore or the submission order, the barrier only changes the layout
+    Tools::Insert::ImageMemoryBarrier(cmd, request.m_image,
+            VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            request.m_layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, range);
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel       = request.m_mipLevel;
+    region.imageSubresource.baseArrayLayer = request.m_layer;
+    region.imageSubresource.layerCount     = 1;
+    region.imageExtent                     = { request.m_width, request.m_height, 1 };
+
+    vkCmdCopyImageToBuffer(cmd, request.m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, job.m_staging.m_buffer, 1, &region);
+
+    Tools::Insert::ImageMemoryBarrier(cmd, request.m_image,
+            VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_MEMORY_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, request.m_layout,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, range);
+
+    /// the fence of the frame makes the memory available, the barrier makes it visible to the host
+    Tools::Insert::BufferOwnershipBarrier(cmd, job.m_staging.m_buffer,
+            VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT);
+
+    m_recorded.emplace_back(std::move(job));
+
+    return true;
+}
+
+std::future<EvoVulkan::Complexes::ReadbackResult> EvoVulkan::Complexes::Readback::Record(
+        VkCommandBuffer cmd,
+        uint64_t frame,
+        const ReadbackRequest& request)
+{
+    /// std::function must be copyable, the promise is shared with the callback
+    auto&& promise = std::make_shared<std::promise<ReadbackResult>>();
+    auto future = promise->get_future();
+
+    if (!Record(cmd, frame, request, [promise](ReadbackResult&& result) { promise->set_value(std::move(result)); }))
+        promise->set_value(ReadbackResult());
+
+    return future;
+}
+
+void EvoVulkan::Complexes::Readback::Update(uint64_t completedFrame) {
+    if (m_recorded.empty() || m_recorded.front().m_frame > completedFrame)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        while (!m_recorded.empty() && m_recorded.front().m_frame <= completedFrame) {
+            m_completed.emplace_back(std::move(m_recorded.front()));
+            m_recorded.pop_front();
+        }
+    }
+
+    m_condition.notify_all();
+}
+
+void EvoVulkan::Complexes::Readback::Discard(uint64_t frame) {
+    /// copies of the frame are the newest ones
+    while (!m_recorded.empty() && m_recorded.back().m_frame == frame) {
+        auto&& job = m_recorded.back();
+
+        this->ReleaseStaging(job.m_staging);
+
+        if (job.m_callback)
+            job.m_callback(ReadbackResult());
+
+        m_recorded.pop_back();
+    }
+}
+
+void EvoVulkan::Complexes::Readback::WorkerLoop() {
+    /// conversions run concurrently with frames, the heap guard counts them
+    Tools::HeapGuard::SetGuarded(true);
+
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_completed.empty(); });
+
+            /// completed copies are still delivered on destroy
+            if (m_completed.empty())
+                return;
+
+            job = std::move(m_completed.front());
+            m_completed.pop_front();
+        }
+
+        auto&& result = job.m_result;
+        const VkDeviceSize size = job.m_size;
+
+        /// host cached memory may be non-coherent
+        if (vmaInvalidateAllocation(*m_allocator, job.m_staging.m_allocation, 0, size) == VK_SUCCESS) {
+            result.m_pixels.assign(job.m_staging.m_mapped, job.m_staging.m_mapped + size);
+            result.m_success = true;
+        }
+        else
+            VK_ERROR("Readback::WorkerLoop() : failed to invalidate readback buffer!");
+
+        this->ReleaseStaging(job.m_staging);
+
+        if (result.m_success && job.m_convert)
+            job.m_convert(result);
+
+        if (job.m_callback)
+            job.m_callback(std::move(result));
+    }
+}
+
+bool EvoVulkan::Complexes::Readback::AcquireStaging(VkDeviceSize size, Staging& staging) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        /// the smallest buffer which fits
+        auto best = m_freeBuffers.end();
+        for (auto it = m_freeBuffers.begin(); it != m_freeBuffers.end(); ++it)
+            if (it->m_size >= size && (best == m_freeBuffers.end() || it->m_size < best->m_size))
+                best = it;
+
+        if (best != m_freeBuffers.end()) {
+            staging = *best;
+            m_freeBuffers.erase(best);
+            return true;
+        }
+    }
+
+    VkBufferCreateInfo bufferCI = {};
+    bufferCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCI.size        = size;
+    bufferCI.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    /// cached memory is read by the CPU much faster than write-combined one
+    VmaAllocationCreateInfo allocCI = {};
+    allocCI.flags          = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocCI.requiredFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    allocCI.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+    VmaAllocationInfo allocInfo = {};
+
+    auto result = vmaCreateBuffer(*m_allocator, &bufferCI, &allocCI, &staging.m_buffer, &staging.m_allocation, &allocInfo);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("Readback::AcquireStaging() : failed to create buffer! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        staging = Staging();
+        return false;
+    }
+
+    staging.m_mapped = static_cast<uint8_t*>(allocInfo.pMappedData);
+    staging.m_size   = size;
+
+    return true;
+}
+
+void EvoVulkan::Complexes::Readback::ReleaseStaging(Staging& staging) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_freeBuffers.size() < m_maxFreeBuffers) {
+            m_freeBuffers.emplace_back(staging);
+            staging = Staging();
+            return;
+        }
+    }
+
+    /// VMA is thread safe
+    this->DestroyStaging(staging);
+}
+
+void EvoVulkan::Complexes::Readback::DestroyStaging(Staging& staging) {
+    if (staging.m_buffer != VK_NULL_HANDLE)
+        vmaDestroyBuffer(*m_allocator, staging.m_buffer, staging.m_allocation);
+
+    staging = Staging();
+}
+
+void EvoVulkan::Complexes::Readback::Destroy() {
+    VK_LOG("Readback::Destroy() : destroy readback...");
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        this->m_stop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (auto&& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    /// frames of these copies may have never been submitted
+    for (auto&& job : m_recorded) {
+        this->DestroyStaging(job.m_staging);
+
+        if (job.m_callback)
+            job.m_callback(ReadbackResult());
+    }
+    m_recorded.clear();
+
+    for (auto&& staging : m_freeBuffers)
+        this->DestroyStaging(staging);
+    m_freeBuffers.clear();
+}
+
+void EvoVulkan::Complexes::Readback::Free() {
+    delete this;
+}
@@ -42,7 +42,7 @@ bool EvoVulkan::Complexes::Shader::Load(
     {
         uint32_t count = 0;
         for (auto bind : descriptorLayoutBindings)
-            if (bind.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+            if (bind.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || bind.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
                 count++;
         if (count != uniformSizes.size()) {
             VK_ERROR("Shader::Load() : incorrect uniform sizes!");
@@ -0,0 +1,453 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Complexes/TextureStreamer.h>
+
+#include <EvoVulkan/Types/UploadBatch.h>
+#include <EvoVulkan/Tools/VulkanHelper.h>
+
+#include <algorithm>
+
+EvoVulkan::Complexes::TextureStreamer* EvoVulkan::Complexes::TextureStreamer::Create(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        EvoVulkan::Core::DescriptorManager* manager,
+        EvoVulkan::Types::CmdPool* pool,
+        EvoVulkan::Types::CmdPool* transferPool,
+        uint8_t framesInFlight,
+        uint32_t countThreads,
+        EvoVulkan::Types::Texture* placeholder)
+{
+    VK_GRAPH("TextureStreamer::Create() : create texture streamer...");
+
+    if (!device || !allocator || !manager || !pool) {
+        VK_ERROR("TextureStreamer::Create() : invalid arguments!");
+        return nullptr;
+    }
+
+    auto* streamer = new TextureStreamer();
+    {
+        streamer->m_device         = device;
+        streamer->m_allocator      = allocator;
+        streamer->m_manager        = manager;
+        streamer->m_pool           = pool;
+        streamer->m_transferPool   = transferPool;
+        streamer->m_framesInFlight = framesInFlight;
+        streamer->m_placeholder    = placeholder;
+    }
+
+    if (!placeholder) {
+        const uint8_t grey[4] = { 128, 128, 128, 255 };
+
+        streamer->m_ownPlaceholder = true;
+        streamer->m_placeholder = Types::Texture::Load(
+                device, allocator, manager, pool, grey, VK_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, VK_FILTER_NEAREST, false, transferPool);
+
+        if (!streamer->m_placeholder) {
+            VK_ERROR("TextureStreamer::Create() : failed to create placeholder texture!");
+            streamer->Destroy();
+            streamer->Free();
+            return nullptr;
+        }
+    }
+
+    /// the render thread is busy with frames, leave it a core
+    if (countThreads == 0)
+        countThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    for (uint32_t i = 0; i < countThreads; ++i)
+        streamer->m_workers.emplace_back(&TextureStreamer::WorkerLoop, streamer);
+
+    return streamer;
+}
+
+EvoVulkan::Complexes::StreamedTexture* EvoVulkan::Complexes::TextureStreamer::Load(
+        StreamDecoder&& decoder,
+        std::function<void(StreamedTexture*)>&& onComplete)
+{
+    if (!decoder) {
+        VK_ERROR("TextureStreamer::Load() : decoder is empty!");
+        return nullptr;
+    }
+
+    auto* handle = new StreamedTexture();
+    {
+        handle->m_streamer   = this;
+        handle->m_decoder    = std::move(decoder);
+        handle->m_onComplete = std::move(onComplete);
+        handle->m_descriptor = *m_placeholder->GetDescriptorRef();
+    }
+
+    m_handles.emplace_back(handle);
+    ++m_countPending;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.emplace_back(handle);
+    }
+
+    m_condition.notify_one();
+
+    return handle;
+}
+
+void EvoVulkan::Complexes::TextureStreamer::Release(StreamedTexture* handle) {
+    if (!handle)
+        return;
+
+    const auto state = handle->m_state.load();
+
+    /// the handle is deleted when it comes back from the decoder or the upload
+    if (state != StreamedTexture::State::Ready && state != StreamedTexture::State::Failed) {
+        handle->m_released = true;
+        return;
+    }
+
+    this->Delete(handle);
+}
+
+void EvoVulkan::Complexes::TextureStreamer::Update() {
+    ++m_updateCounter;
+
+    if (m_updateCounter > m_framesInFlight)
+        m_deletionQueue.Collect(m_updateCounter - m_framesInFlight);
+
+    this->CompleteUploads();
+
+    if (!this->SubmitDecoded())
+        VK_ERROR("TextureStreamer::Update() : failed to submit decoded textures!");
+}
+
+void EvoVulkan::Complexes::TextureStreamer::WorkerLoop() {
+    while (true) {
+        StreamedTexture* handle = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+
+            if (m_stop)
+                return;
+
+            handle = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        auto&& image = handle->m_image;
+        image.m_allocator = m_allocator;
+
+        /// released handles aren't decoded at all
+        const bool decoded = !handle->m_released && handle->m_decoder(image) &&
+                (image.m_pixels || image.m_staging.Valid()) && image.m_width > 0 && image.m_height > 0;
+
+        /// the handle stays pending until Update() takes it, a failed one has no pixels
+        if (!decoded)
+            ReleaseImage(handle);
+
+        handle->m_decoder = nullptr;
+        handle->m_state   = StreamedTexture::State::Decoded;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.emplace_back(handle);
+    }
+}
+
+bool EvoVulkan::Complexes::TextureStreamer::SubmitDecoded() {
+    /// every batch holds staging memory until it's completed, don't let them pile up
+    if (m_uploads.size() > m_framesInFlight)
+        return true;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_decoded.empty())
+            return true;
+    }
+
+    Types::UploadBatch* batch = nullptr;
+    if (!m_freeBatches.empty()) {
+        batch = m_freeBatches.back();
+        m_freeBatches.pop_back();
+    }
+    else if (!(batch = Types::UploadBatch::Create(m_device, m_allocator, m_pool, m_transferPool)))
+        return false;
+
+    if (!batch->Begin()) {
+        m_freeBatches.emplace_back(batch);
+        return false;
+    }
+
+    Upload upload = { batch, {} };
+    VkDeviceSize staged = 0;
+
+    while (true) {
+        StreamedTexture* handle = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty())
+                break;
+
+            auto&& image = m_decoded.front()->m_image;
+            const VkDeviceSize size = Tools::GetImageSize(image.m_format, image.m_width, image.m_height);
+            if (staged > 0 && staged + size > m_budget)
+                break;
+
+            handle = m_decoded.front();
+            m_decoded.pop_front();
+        }
+
+        if ((!handle->m_image.m_pixels && !handle->m_image.m_staging.Valid()) || handle->m_released) {
+            ReleaseImage(handle);
+            this->Complete(handle, nullptr);
+            continue;
+        }
+
+        auto&& image = handle->m_image;
+
+        uint32_t mipLevels = image.m_mipLevels;
+        if (mipLevels == 0)
+            mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(image.m_width, image.m_height)))) + 1;
+
+        Types::Texture* texture = nullptr;
+
+        batch->SetMipGenerator(image.m_computeMips ? m_mipGenerator : nullptr);
+
+        /// texels written by the decoder in place aren't copied again
+        if (image.m_staging.Valid())
+            texture = Types::Texture::Load(
+                    batch, m_manager, batch->Adopt(image.m_staging), image.m_format, image.m_width, image.m_height, mipLevels, image.m_filter);
+        else
+            texture = Types::Texture::Load(
+                    batch, m_manager, image.m_pixels, image.m_format, image.m_width, image.m_height, mipLevels, image.m_filter);
+
+        staged += Tools::GetImageSize(image.m_format, image.m_width, image.m_height);
+
+        /// pixels are in the staging memory now
+        ReleaseImage(handle);
+
+        if (!texture) {
+            VK_ERROR("TextureStreamer::SubmitDecoded() : failed to load texture!");
+            this->Complete(handle, nullptr);
+            continue;
+        }
+
+        handle->m_state = StreamedTexture::State::Uploading;
+        upload.m_textures.emplace_back(handle, texture);
+    }
+
+    if (!batch->Submit()) {
+        for (auto&& [handle, texture] : upload.m_textures) {
+            this->DeferredFree(texture);
+            this->Complete(handle, nullptr);
+        }
+
+        m_freeBatches.emplace_back(batch);
+
+        return false;
+    }
+
+    m_uploads.emplace_back(std::move(upload));
+
+    return true;
+}
+
+void EvoVulkan::Complexes::TextureStreamer::CompleteUploads() {
+    for (auto&& upload = m_uploads.begin(); upload != m_uploads.end(); ) {
+        if (!upload->m_batch->IsComplete()) {
+            ++upload;
+            continue;
+        }
+
+        /// releases staging memory of the batch
+        upload->m_batch->Wait();
+
+        for (auto&& [handle, texture] : upload->m_textures)
+            this->Complete(handle, texture);
+
+        m_freeBatches.emplace_back(upload->m_batch);
+        upload = m_uploads.erase(upload);
+    }
+}
+
+void EvoVulkan::Complexes::TextureStreamer::Complete(StreamedTexture* handle, Types::Texture* texture) {
+    --m_countPending;
+
+    if (handle->m_released) {
+        this->DeferredFree(texture);
+        this->Delete(handle);
+        return;
+    }
+
+    if (!texture) {
+        handle->m_state = StreamedTexture::State::Failed;
+    }
+    else {
+        handle->m_texture    = texture;
+        handle->m_descriptor = *texture->GetDescriptorRef();
+        ++handle->m_version;
+
+        /// frames in flight can use the old set, so a new one is written
+        if (const Core::DescriptorSet oldSet = handle->m_descriptorSet; oldSet != VK_NULL_HANDLE) {
+            handle->m_descriptorSet = Core::DescriptorSet();
+            handle->GetDescriptorSet(oldSet.m_layout, handle->m_binding);
+
+            m_deletionQueue.Push(m_updateCounter, [manager = m_manager, oldSet]() {
+                manager->FreeDescriptorSet(oldSet);
+            });
+        }
+
+        handle->m_state = StreamedTexture::State::Ready;
+    }
+
+    if (handle->m_onComplete)
+        handle->m_onComplete(handle);
+}
+
+void EvoVulkan::Complexes::TextureStreamer::Delete(StreamedTexture* handle) {
+    m_handles.erase(std::remove(m_handles.begin(), m_handles.end(), handle), m_handles.end());
+
+    m_deletionQueue.Push(m_updateCounter, [manager = m_manager, handle]() {
+        if (handle->m_descriptorSet != VK_NULL_HANDLE)
+            manager->FreeDescriptorSet(handle->m_descriptorSet);
+
+        if (handle->m_texture) {
+            handle->m_texture->Destroy();
+            handle->m_texture->Free();
+        }
+
+        delete handle;
+    });
+}
+
+void EvoVulkan::Complexes::TextureStreamer::DeferredFree(Types::Texture* texture) {
+    if (!texture)
+        return;
+
+    m_deletionQueue.Push(m_updateCounter, [texture]() {
+        texture->Destroy();
+        texture->Free();
+    });
+}
+
+void EvoVulkan::Complexes::TextureStreamer::ReleaseImage(StreamedTexture* handle) {
+    auto&& image = handle->m_image;
+
+    /// adopted staging is already reset
+    if (image.m_staging.Valid())
+        Types::UploadBatch::ReleaseDetached(image.m_allocator, image.m_staging);
+
+    if (image.m_release && image.m_pixels)
+        image.m_release(image.m_pixels);
+
+    image = StreamImage();
+}
+
+void EvoVulkan::Complexes::TextureStreamer::Destroy() {
+    VK_LOG("TextureStreamer::Destroy() : destroy texture streamer...");
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        this->m_stop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (auto&& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    for (auto&& upload : m_uploads) {
+        upload.m_batch->Wait();
+
+        for (auto&& [handle, texture] : upload.m_textures) {
+            texture->Destroy();
+            texture->Free();
+        }
+
+        upload.m_batch->Destroy();
+        upload.m_batch->Free();
+    }
+    m_uploads.clear();
+
+    for (auto&& batch : m_freeBatches)
+        EVSafeFreeObject(batch);
+    m_freeBatches.clear();
+
+    /// decoded pixels which haven't been staged
+    for (auto&& handle : m_decoded)
+        ReleaseImage(handle);
+    m_decoded.clear();
+    m_jobs.clear();
+
+    /// released handles, textures and old descriptor sets
+    this->m_deletionQueue.Flush();
+
+    /// pending handles are still here, even if they have been released
+    for (auto&& handle : m_handles) {
+        if (handle->m_descriptorSet != VK_NULL_HANDLE)
+            m_manager->FreeDescriptorSet(handle->m_descriptorSet);
+
+        if (handle->m_texture) {
+            handle->m_texture->Destroy();
+            handle->m_texture->Free();
+        }
+
+        delete handle;
+    }
+    m_handles.clear();
+
+    if (m_ownPlaceholder && m_placeholder) {
+        m_placeholder->Destroy();
+        m_placeholder->Free();
+    }
+
+    m_placeholder  = nullptr;
+    m_countPending = 0;
+}
+
+void EvoVulkan::Complexes::TextureStreamer::Free() {
+    delete this;
+}
+
+EvoVulkan::Core::DescriptorSet EvoVulkan::Complexes::StreamedTexture::GetDescriptorSet(VkDescriptorSetLayout layout, uint32_t binding) {
+    if (m_descriptorSet != VK_NULL_HANDLE)
+        return m_descriptorSet;
+
+    static const std::set<VkDescriptorType> type = { VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER };
+
+    m_descriptorSet = m_streamer->m_manager->AllocateDescriptorSets(layout, type);
+    if (m_descriptorSet == VK_NULL_HANDLE) {
+        VK_ERROR("StreamedTexture::GetDescriptorSet() : failed to allocate descriptor set!");
+        return Core::DescriptorSet();
+    }
+
+    m_binding = binding;
+
+    auto writer = Tools::Initializers::WriteDescriptorSet(
+            m_descriptorSet,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            binding, &m_descriptor);
+
+    vkUpdateDescriptorSets(*m_streamer->m_device, 1, &writer, 0, nullptr);
+
+    return m_descriptorSet;
+}
+
+uint8_t* EvoVulkan::Complexes::StreamImage::MapStaging() {
+    if (m_staging.Valid()) {
+        VK_ERROR("StreamImage::MapStaging() : staging memory is already mapped!");
+        return nullptr;
+    }
+
+    if (m_width == 0 || m_height == 0) {
+        VK_ERROR("StreamImage::MapStaging() : sizes of the image aren't set!");
+        return nullptr;
+    }
+
+    /// the image is unique per handle, so it owns the allocation in the ring until a batch adopts it
+    m_staging = Types::UploadBatch::MapDetached(m_allocator, this, Tools::GetImageSize(m_format, m_width, m_height),
+            Tools::GetStagingAlignment(m_streamer->m_device, m_format));
+
+    return static_cast<uint8_t*>(m_staging.m_staging.m_data);
+}
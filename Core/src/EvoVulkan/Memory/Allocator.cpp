@@ -4,6 +4,7 @@
 
 #define VMA_IMPLEMENTATION
 #include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Memory/StagingRing.h>
 #include <EvoVulkan/Tools/VulkanDebug.h>
 
 EvoVulkan::Memory::Allocator *EvoVulkan::Memory::Allocator::Create(EvoVulkan::Types::Device *device) {
@@ -35,6 +36,10 @@ bool EvoVulkan::Memory::Allocator::Init() {
     vmaAllocationCreateInfo.pVulkanFunctions = nullptr;
     vmaAllocationCreateInfo.vulkanApiVersion = instance->GetVersion();
 
+    /// memory of all blocks (and pools) is allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+    if (m_device->IsBufferDeviceAddressEnabled())
+        vmaAllocationCreateInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+
     if (auto result = vmaCreateAllocator(&vmaAllocationCreateInfo, &m_vmaAllocator); result != VK_SUCCESS) {
         VK_ERROR("Allocator::Init() : failed to create vma allocator! "
                  "\n\tReason: " + Tools::Convert::result_to_string(result) +
@@ -73,7 +78,32 @@ EvoVulkan::Types::Image EvoVulkan::Memory::Allocator::AllocImage(const VkImageCr
     return image;
 }
 
+bool EvoVulkan::Memory::Allocator::CreateStagingRing(VkDeviceSize capacity) {
+    if (m_stagingRing) {
+        VK_ERROR("Allocator::CreateStagingRing() : staging ring is already created!");
+        return false;
+    }
+
+    VK_LOG("Allocator::CreateStagingRing() : create staging ring of " + std::to_string(capacity / 1024 / 1024) + " MB...");
+
+    m_stagingRing = StagingRing::Create(m_device, this, capacity);
+
+    return m_stagingRing != nullptr;
+}
+
 EvoVulkan::Memory::Allocator::~Allocator() {
+    /// the ring is allocated by VMA, it has to be freed before the allocator
+    if (m_stagingRing) {
+        m_stagingRing->Destroy();
+        m_stagingRing->Free();
+        m_stagingRing = nullptr;
+    }
+
+    /// buffers of the pools are destroyed by their owners before
+    for (auto&& [key, pool] : m_smallBufferPools)
+        vmaDestroyPool(m_vmaAllocator, pool);
+    m_smallBufferPools.clear();
+
     m_device = nullptr;
 
     if (m_vmaAllocator) {
@@ -100,6 +130,52 @@ void EvoVulkan::Memory::Allocator::FreeImage(Types::Image& image) {
     image.m_allocator  = VK_NULL_HANDLE;
 }
 
+VmaPool EvoVulkan::Memory::Allocator::GetSmallBufferPool(const VkBufferCreateInfo& info, VkMemoryPropertyFlags flags) {
+    if (info.size > SmallBufferSize)
+        return VK_NULL_HANDLE;
+
+    uint32_t kind = 0;
+    if (info.usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+        kind = 1;
+    else if (info.usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT))
+        kind = 2;
+    else
+        return VK_NULL_HANDLE;
+
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.requiredFlags = flags;
+
+    uint32_t memoryType = 0;
+    if (vmaFindMemoryTypeIndexForBufferInfo(m_vmaAllocator, &info, &allocCreateInfo, &memoryType) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+
+    /// uniforms and geometry don't share blocks, they live and die at different rates
+    const uint32_t key = (memoryType << 2) | kind;
+
+    std::lock_guard<std::mutex> lock(m_poolsMutex);
+
+    if (auto&& pIt = m_smallBufferPools.find(key); pIt != m_smallBufferPools.end())
+        return pIt->second;
+
+    VmaPoolCreateInfo poolCreateInfo = {};
+    poolCreateInfo.memoryTypeIndex = memoryType;
+    poolCreateInfo.blockSize       = SmallBufferBlockSize;
+
+    VmaPool pool = VK_NULL_HANDLE;
+    if (auto result = vmaCreatePool(m_vmaAllocator, &poolCreateInfo, &pool); result != VK_SUCCESS) {
+        VK_ERROR("Allocator::GetSmallBufferPool() : failed to create pool! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        return VK_NULL_HANDLE;
+    }
+
+    VK_LOG("Allocator::GetSmallBufferPool() : create pool of small " + std::string(kind == 1 ? "uniform" : "vertex/index") +
+           " buffers, memory type " + std::to_string(memoryType));
+
+    m_smallBufferPools.insert(std::make_pair(key, pool));
+
+    return pool;
+}
+
 EvoVulkan::Memory::RawMemory EvoVulkan::Memory::Allocator::AllocateMemory(VkMemoryAllocateInfo memoryAllocateInfo) {
     auto memory = RawMemory();
     memory.m_size = memoryAllocateInfo.allocationSize;
@@ -155,6 +231,11 @@ uint64_t EvoVulkan::Memory::Allocator::GetCPUMemoryUsage() const {
 EvoVulkan::Memory::Buffer EvoVulkan::Memory::Allocator::AllocBuffer(const VkBufferCreateInfo &info, VmaMemoryUsage usage) {
     EvoVulkan::Memory::Buffer buffer = {};
 
+    if ((info.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) && !m_device->IsBufferDeviceAddressEnabled()) {
+        VK_ERROR("Allocator::AllocBuffer() : buffer device address isn't enabled!");
+        return EvoVulkan::Memory::Buffer();
+    }
+
     VmaAllocationCreateInfo allocInfo;
     allocInfo.flags = 0;
     allocInfo.usage = usage;
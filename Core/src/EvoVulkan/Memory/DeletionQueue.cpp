@@ -0,0 +1,53 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Memory/DeletionQueue.h>
+
+#include <algorithm>
+
+void EvoVulkan::Memory::DeletionQueue::Push(uint64_t frame, Deleter&& deleter) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.emplace_back(Entry { frame, std::move(deleter) });
+}
+
+void EvoVulkan::Memory::DeletionQueue::Collect(uint64_t completedFrame) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_entries.empty())
+            return;
+
+        /// frames can be pushed from different threads, so entries aren't sorted
+        auto&& middle = std::partition(m_entries.begin(), m_entries.end(), [completedFrame](const Entry& entry) {
+            return entry.m_frame > completedFrame;
+        });
+
+        m_collected.assign(std::make_move_iterator(middle), std::make_move_iterator(m_entries.end()));
+        m_entries.erase(middle, m_entries.end());
+    }
+
+    /// deleters can push new entries
+    for (auto&& entry : m_collected)
+        entry.m_deleter();
+
+    /// keeps the capacity, collecting doesn't allocate in a steady state
+    m_collected.clear();
+}
+
+void EvoVulkan::Memory::DeletionQueue::Flush() {
+    std::vector<Entry> entries;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        entries.swap(m_entries);
+    }
+
+    for (auto&& entry : entries)
+        entry.m_deleter();
+}
+
+size_t EvoVulkan::Memory::DeletionQueue::GetCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
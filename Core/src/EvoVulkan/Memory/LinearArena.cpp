@@ -0,0 +1,87 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Memory/LinearArena.h>
+
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+#include <cstdlib>
+
+EvoVulkan::Memory::LinearArena* EvoVulkan::Memory::LinearArena::Create(size_t capacity) {
+    auto* arena = new LinearArena(capacity);
+
+    if (capacity > 0 && !(arena->m_data = static_cast<uint8_t*>(std::malloc(capacity)))) {
+        VK_ERROR("LinearArena::Create() : failed to allocate " + std::to_string(capacity) + " bytes!");
+        delete arena;
+        return nullptr;
+    }
+
+    return arena;
+}
+
+void* EvoVulkan::Memory::LinearArena::Allocate(size_t size, size_t alignment) {
+    const auto address = reinterpret_cast<uintptr_t>(m_data) + m_offset;
+    const size_t padding = (alignment - address % alignment) % alignment;
+
+    m_required += size + padding;
+
+    if (m_data && m_offset + padding + size <= m_capacity) {
+        void* memory = m_data + m_offset + padding;
+        m_offset += padding + size;
+        return memory;
+    }
+
+    /// overflow, the arena will be resized at the next reset
+    auto* block = static_cast<uint8_t*>(std::malloc(size + alignment));
+    if (!block) {
+        VK_ERROR("LinearArena::Allocate() : failed to allocate overflow block!");
+        return nullptr;
+    }
+
+    m_overflow.emplace_back(block);
+
+    const auto blockAddress = reinterpret_cast<uintptr_t>(block);
+    return block + (alignment - blockAddress % alignment) % alignment;
+}
+
+void EvoVulkan::Memory::LinearArena::Reset() {
+    if (!m_overflow.empty()) {
+        for (auto&& block : m_overflow)
+            std::free(block);
+        m_overflow.clear();
+
+        size_t capacity = m_capacity > 0 ? m_capacity : 1024;
+        while (capacity < m_required)
+            capacity *= 2;
+
+        std::free(m_data);
+
+        if (!(m_data = static_cast<uint8_t*>(std::malloc(capacity)))) {
+            VK_ERROR("LinearArena::Reset() : failed to grow arena!");
+            capacity = 0;
+        }
+
+        m_capacity = capacity;
+    }
+
+    m_offset   = 0;
+    m_required = 0;
+}
+
+void EvoVulkan::Memory::LinearArena::Destroy() {
+    for (auto&& block : m_overflow)
+        std::free(block);
+    m_overflow.clear();
+
+    std::free(m_data);
+
+    m_data     = nullptr;
+    m_capacity = 0;
+    m_offset   = 0;
+    m_required = 0;
+}
+
+void EvoVulkan::Memory::LinearArena::Free() {
+    delete this;
+}
@@ -0,0 +1,208 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Memory/StagingRing.h>
+#include <EvoVulkan/Memory/Allocator.h>
+
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+EvoVulkan::Memory::StagingRing* EvoVulkan::Memory::StagingRing::Create(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        VkDeviceSize capacity)
+{
+    if (!device->IsTimelineSemaphoreSupported()) {
+        VK_WARN("StagingRing::Create() : device isn't support timeline semaphores!");
+        return nullptr;
+    }
+
+    auto* ring = new StagingRing();
+    {
+        ring->m_device    = device;
+        ring->m_allocator = allocator;
+        ring->m_capacity  = capacity;
+    }
+
+    auto bufferCreateInfo = Tools::Initializers::BufferCreateInfo(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, capacity);
+
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocCreateInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+    VmaAllocationInfo allocInfo = {};
+
+    auto result = vmaCreateBuffer(*allocator, &bufferCreateInfo, &allocCreateInfo, &ring->m_buffer, &ring->m_allocation, &allocInfo);
+    if (result != VK_SUCCESS || !allocInfo.pMappedData) {
+        VK_ERROR("StagingRing::Create() : failed to create buffer! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        ring->Destroy();
+        ring->Free();
+        return nullptr;
+    }
+
+    ring->m_mapped = static_cast<uint8_t*>(allocInfo.pMappedData);
+
+    VkMemoryPropertyFlags memoryFlags = 0;
+    vmaGetMemoryTypeProperties(*allocator, allocInfo.memoryType, &memoryFlags);
+    ring->m_coherent = memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    if ((ring->m_timeline = Tools::CreateTimelineSemaphore(*device, 0)) == VK_NULL_HANDLE) {
+        VK_ERROR("StagingRing::Create() : failed to create timeline semaphore!");
+        ring->Destroy();
+        ring->Free();
+        return nullptr;
+    }
+
+    return ring;
+}
+
+EvoVulkan::Memory::StagingRing::Allocation EvoVulkan::Memory::StagingRing::Allocate(
+        const void* owner,
+        VkDeviceSize size,
+        VkDeviceSize alignment,
+        uint64_t timeout)
+{
+    if (size == 0 || size > m_capacity)
+        return Allocation();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;) {
+        this->Reclaim();
+
+        VkDeviceSize offset = 0;
+        if (TryAllocate(size, alignment, offset)) {
+            m_regions.emplace_back(Region { owner, offset, offset + size, 0 });
+            return Allocation { m_buffer, offset, m_mapped + offset };
+        }
+
+        /// the oldest region is recorded now, waiting for it would never end
+        const uint64_t value = m_regions.front().m_value;
+        if (value == 0)
+            return Allocation();
+
+        /// back-pressure, other threads can allocate and submit while the oldest upload is in flight
+        lock.unlock();
+
+        VkSemaphoreWaitInfo waitInfo = {};
+        waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &m_timeline;
+        waitInfo.pValues        = &value;
+
+        if (vkWaitSemaphores(*m_device, &waitInfo, timeout) != VK_SUCCESS)
+            return Allocation();
+
+        lock.lock();
+    }
+}
+
+bool EvoVulkan::Memory::StagingRing::TryAllocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) const {
+    if (m_regions.empty()) {
+        offset = 0;
+        return true;
+    }
+
+    const Region& front = m_regions.front();
+    const Region& back  = m_regions.back();
+
+    const VkDeviceSize aligned = (back.m_end + alignment - 1) / alignment * alignment;
+
+    /// used part is [front, capacity) + [0, back)
+    if (back.m_begin < front.m_begin) {
+        offset = aligned;
+        return aligned + size <= front.m_begin;
+    }
+
+    /// used part is [front, back)
+    if (aligned + size <= m_capacity) {
+        offset = aligned;
+        return true;
+    }
+
+    offset = 0;
+    return size <= front.m_begin;
+}
+
+void EvoVulkan::Memory::StagingRing::Reclaim() {
+    uint64_t completed = 0;
+    vkGetSemaphoreCounterValue(*m_device, m_timeline, &completed);
+
+    while (!m_regions.empty()) {
+        const Region& front = m_regions.front();
+        if (front.m_owner && (front.m_value == 0 || front.m_value > completed))
+            break;
+        m_regions.pop_front();
+    }
+}
+
+bool EvoVulkan::Memory::StagingRing::Close(const void* owner, uint64_t value) {
+    bool closed = false;
+
+    for (auto&& region : m_regions) {
+        if (region.m_owner != owner || region.m_value != 0)
+            continue;
+
+        region.m_value = value;
+        closed = true;
+
+        if (!m_coherent)
+            vmaFlushAllocation(*m_allocator, m_allocation, region.m_begin, region.m_end - region.m_begin);
+    }
+
+    return closed;
+}
+
+void EvoVulkan::Memory::StagingRing::Discard(uint64_t value) {
+    for (auto&& region : m_regions) {
+        if (region.m_value == value) {
+            region.m_owner = nullptr;
+            region.m_value = 0;
+        }
+    }
+}
+
+void EvoVulkan::Memory::StagingRing::Cancel(const void* owner) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto&& region : m_regions)
+        if (region.m_owner == owner && region.m_value == 0)
+            region.m_owner = nullptr;
+}
+
+void EvoVulkan::Memory::StagingRing::Transfer(const void* from, const void* to) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto&& region : m_regions)
+        if (region.m_owner == from && region.m_value == 0)
+            region.m_owner = to;
+}
+
+void EvoVulkan::Memory::StagingRing::Destroy() {
+    if (m_timeline != VK_NULL_HANDLE) {
+        VkSemaphoreWaitInfo waitInfo = {};
+        waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &m_timeline;
+        waitInfo.pValues        = &m_value;
+        vkWaitSemaphores(*m_device, &waitInfo, UINT64_MAX);
+
+        vkDestroySemaphore(*m_device, m_timeline, nullptr);
+        m_timeline = VK_NULL_HANDLE;
+    }
+
+    if (m_buffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(*m_allocator, m_buffer, m_allocation);
+        m_buffer     = VK_NULL_HANDLE;
+        m_allocation = VK_NULL_HANDLE;
+        m_mapped     = nullptr;
+    }
+
+    m_regions.clear();
+}
+
+void EvoVulkan::Memory::StagingRing::Free() {
+    delete this;
+}
@@ -0,0 +1,89 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Memory/UniformRing.h>
+#include <EvoVulkan/Memory/Allocator.h>
+
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+EvoVulkan::Memory::UniformRing* EvoVulkan::Memory::UniformRing::Create(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        VkDeviceSize frameSize,
+        uint32_t countFrames)
+{
+    if (frameSize == 0 || countFrames == 0) {
+        VK_ERROR("UniformRing::Create() : invalid size or count of frames!");
+        return nullptr;
+    }
+
+    auto* ring = new UniformRing();
+    {
+        ring->m_device      = device;
+        ring->m_allocator   = allocator;
+        ring->m_alignment   = std::max<VkDeviceSize>(device->GetUniformBufferAlignment(), 1);
+        ring->m_frameSize   = (frameSize + ring->m_alignment - 1) / ring->m_alignment * ring->m_alignment;
+        ring->m_countFrames = countFrames;
+    }
+
+    if (ring->m_frameSize * countFrames > UINT32_MAX) {
+        VK_ERROR("UniformRing::Create() : dynamic offsets don't cover the ring!");
+        ring->Free();
+        return nullptr;
+    }
+
+    auto bufferCreateInfo = Tools::Initializers::BufferCreateInfo(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, ring->m_frameSize * countFrames);
+
+    /// device local memory is preferred if it's visible to the host (resizable BAR), the GPU reads it every draw
+    VmaAllocationCreateInfo allocCreateInfo = {};
+    allocCreateInfo.flags          = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocCreateInfo.usage          = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    allocCreateInfo.requiredFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    allocCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    VmaAllocationInfo allocInfo = {};
+
+    auto result = vmaCreateBuffer(*allocator, &bufferCreateInfo, &allocCreateInfo, &ring->m_buffer, &ring->m_allocation, &allocInfo);
+    if (result != VK_SUCCESS || !allocInfo.pMappedData) {
+        VK_ERROR("UniformRing::Create() : failed to create buffer! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        ring->Destroy();
+        ring->Free();
+        return nullptr;
+    }
+
+    ring->m_mapped = static_cast<uint8_t*>(allocInfo.pMappedData);
+
+    return ring;
+}
+
+void EvoVulkan::Memory::UniformRing::BeginFrame(uint32_t frame) {
+    m_base = m_frameSize * (frame % m_countFrames);
+    m_head.store(0, std::memory_order_relaxed);
+}
+
+EvoVulkan::Memory::UniformRing::Allocation EvoVulkan::Memory::UniformRing::Allocate(VkDeviceSize size) {
+    const VkDeviceSize aligned = (size + m_alignment - 1) / m_alignment * m_alignment;
+
+    /// sizes are multiples of the alignment, so every offset is aligned too
+    const VkDeviceSize offset = m_head.fetch_add(aligned, std::memory_order_relaxed);
+    if (size == 0 || offset + aligned > m_frameSize)
+        return Allocation();
+
+    return Allocation { static_cast<uint32_t>(m_base + offset), m_mapped + m_base + offset };
+}
+
+void EvoVulkan::Memory::UniformRing::Destroy() {
+    if (m_buffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(*m_allocator, m_buffer, m_allocation);
+        m_buffer     = VK_NULL_HANDLE;
+        m_allocation = VK_NULL_HANDLE;
+        m_mapped     = nullptr;
+    }
+}
+
+void EvoVulkan::Memory::UniformRing::Free() {
+    delete this;
+}
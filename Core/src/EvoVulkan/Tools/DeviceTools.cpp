@@ -20,11 +20,6 @@ bool EvoVulkan::Tools::IsDeviceSuitable(
         VkSurfaceKHR const &surface,
         const std::vector<const char *> &extensions)
 {
-    if (!surface) {
-        Tools::VkDebug::Error("Types::IsDeviceSuitable() : surface is nullptr!");
-        return false;
-    }
-
     if (!extensions.empty())
         if (!Tools::CheckDeviceExtensionSupport(physicalDevice, extensions)) {
             Tools::VkDebug::Warn("Tools::IsDeviceSuitable() : device \"" +
@@ -32,17 +27,20 @@ bool EvoVulkan::Tools::IsDeviceSuitable(
             return false;
         }
 
-    Types::SwapChainSupportDetails swapChainSupport = Types::QuerySwapChainSupport(physicalDevice, surface);
-    if (!swapChainSupport.m_complete) {
-        Tools::VkDebug::Warn("Tools::IsDeviceSuitable() : something went wrong! Details isn't complete!");
-        return false;
-    }
+    /// headless device has nothing to present to
+    if (surface != VK_NULL_HANDLE) {
+        Types::SwapChainSupportDetails swapChainSupport = Types::QuerySwapChainSupport(physicalDevice, surface);
+        if (!swapChainSupport.m_complete) {
+            Tools::VkDebug::Warn("Tools::IsDeviceSuitable() : something went wrong! Details isn't complete!");
+            return false;
+        }
 
-    bool swapChainAdequate = !swapChainSupport.m_formats.empty() && !swapChainSupport.m_presentModes.empty();
-    if (!swapChainAdequate) {
-        Tools::VkDebug::Warn("Tools::IsDeviceSuitable() : device \"" +
-                                     Tools::GetDeviceName(physicalDevice) + "\" isn't support swapchain!");
-        return false;
+        bool swapChainAdequate = !swapChainSupport.m_formats.empty() && !swapChainSupport.m_presentModes.empty();
+        if (!swapChainAdequate) {
+            Tools::VkDebug::Warn("Tools::IsDeviceSuitable() : device \"" +
+                                 Tools::GetDeviceName(physicalDevice) + "\" isn't support swapchain!");
+            return false;
+        }
     }
 
     VkPhysicalDeviceFeatures supportedFeatures;
@@ -63,3 +61,78 @@ bool EvoVulkan::Tools::IsBetterThan(VkPhysicalDevice const &_new, VkPhysicalDevi
 
     return _newProp.limits.maxStorageBufferRange > _oldProp.limits.maxStorageBufferRange;
 }
+
+bool EvoVulkan::Tools::IsTimelineSemaphoreSupported(const VkPhysicalDevice& physicalDevice) {
+    VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &timelineFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+    return timelineFeatures.timelineSemaphore == VK_TRUE;
+}
+
+bool EvoVulkan::Tools::IsBufferDeviceAddressSupported(const VkPhysicalDevice& physicalDevice) {
+    VkPhysicalDeviceBufferDeviceAddressFeatures addressFeatures = {};
+    addressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &addressFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+    return addressFeatures.bufferDeviceAddress == VK_TRUE;
+}
+
+bool EvoVulkan::Tools::IsPresentWaitSupported(const VkPhysicalDevice& physicalDevice) {
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    if (!Tools::CheckDeviceExtensionSupport(physicalDevice, { VK_KHR_PRESENT_ID_EXTENSION_NAME, VK_KHR_PRESENT_WAIT_EXTENSION_NAME }))
+        return false;
+
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    presentIdFeatures.pNext = &presentWaitFeatures;
+
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &presentIdFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+    return presentIdFeatures.presentId == VK_TRUE && presentWaitFeatures.presentWait == VK_TRUE;
+#else
+    return false;
+#endif
+}
+
+bool EvoVulkan::Tools::IsHostImageCopySupported(const VkPhysicalDevice& physicalDevice) {
+#ifdef VK_EXT_host_image_copy
+    if (!Tools::CheckDeviceExtensionSupport(physicalDevice, {
+            VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME,
+            VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME,
+            VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME }))
+    {
+        return false;
+    }
+
+    VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures = {};
+    hostImageCopyFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &hostImageCopyFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+    return hostImageCopyFeatures.hostImageCopy == VK_TRUE;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,517 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Tools/MipChain.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define EVK_MIP_X86
+
+    #include <immintrin.h>
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        /// MSVC compiles AVX intrinsics without flags
+        #define EVK_TARGET_AVX2
+    #else
+        #define EVK_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+
+namespace EvoVulkan::Tools::MipKernels {
+    /// rows of levels smaller than it aren't split between threads
+    static constexpr uint32_t g_minParallelTexels = 64 * 1024;
+
+    /// Kaiser windowed sinc, taps at 0.25, 0.75 and 1.25 texels of the destination level from the center
+    struct KaiserWeights {
+        float m_near = 0.f;
+        float m_mid  = 0.f;
+        float m_far  = 0.f;
+    };
+
+    static float BesselI0(float x) {
+        float sum = 1.f, term = 1.f;
+        for (uint32_t k = 1; k < 16; ++k) {
+            term *= (x / (2.f * static_cast<float>(k))) * (x / (2.f * static_cast<float>(k)));
+            sum += term;
+        }
+        return sum;
+    }
+
+    static KaiserWeights ComputeKaiserWeights() {
+        constexpr float alpha  = 4.f;
+        constexpr float radius = 1.5f;
+        constexpr float pi     = 3.14159265358979f;
+
+        auto&& weight = [&](float t) {
+            const float sinc   = std::sin(pi * t) / (pi * t);
+            const float ratio  = t / radius;
+            const float window = BesselI0(alpha * std::sqrt(1.f - ratio * ratio)) / BesselI0(alpha);
+            return sinc * window;
+        };
+
+        KaiserWeights weights = { weight(0.25f), weight(0.75f), weight(1.25f) };
+
+        /// every output texel has two taps of each weight
+        const float norm = 1.f / (2.f * (weights.m_near + weights.m_mid + weights.m_far));
+        weights.m_near *= norm;
+        weights.m_mid  *= norm;
+        weights.m_far  *= norm;
+
+        return weights;
+    }
+
+    static const KaiserWeights& GetKaiserWeights() {
+        static const KaiserWeights weights = ComputeKaiserWeights();
+        return weights;
+    }
+
+    static const std::array<float, 256>& GetSRGBDecodeTable() {
+        static const std::array<float, 256> table = []() {
+            std::array<float, 256> values = {};
+            for (uint32_t i = 0; i < 256; ++i) {
+                const float c = static_cast<float>(i) / 255.f;
+                values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    /// linear values quantized to 14 bits, values below the knee are encoded exactly
+    static const std::array<uint8_t, 16384>& GetSRGBEncodeTable() {
+        static const std::array<uint8_t, 16384> table = []() {
+            std::array<uint8_t, 16384> values = {};
+            for (uint32_t i = 0; i < 16384; ++i) {
+                const float c = static_cast<float>(i) / 16383.f;
+                const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.f / 2.4f) - 0.055f;
+                values[i] = static_cast<uint8_t>(std::clamp(s * 255.f + 0.5f, 0.f, 255.f));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    static uint8_t EncodeUNORM(float value) {
+        return static_cast<uint8_t>(std::clamp(value * 255.f + 0.5f, 0.f, 255.f));
+    }
+
+    static uint8_t EncodeSRGB(float value) {
+        /// encode is the steepest below the knee, a step of the table there would be a fifth of an 8 bit step
+        if (value <= 0.0031308f)
+            return EncodeUNORM(value * 12.92f);
+
+        return GetSRGBEncodeTable()[static_cast<uint32_t>(std::min(value, 1.f) * 16383.f + 0.5f)];
+    }
+
+    //!=================================================================================================================
+
+    /// rows of the level are split between the calling thread and count - 1 workers
+    static void ParallelRows(uint32_t rows, uint32_t texels, uint32_t countThreads, const std::function<void(uint32_t, uint32_t)>& job) {
+        const uint32_t count = texels < g_minParallelTexels ? 1 : std::min(countThreads, rows);
+
+        if (count <= 1) {
+            job(0, rows);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(count - 1);
+
+        const uint32_t step = (rows + count - 1) / count;
+        for (uint32_t begin = step; begin < rows; begin += step)
+            workers.emplace_back(job, begin, std::min(begin + step, rows));
+
+        job(0, std::min(step, rows));
+
+        for (auto&& worker : workers)
+            worker.join();
+    }
+
+    //!=================================================================================================================
+
+    /// 2x2 average of two source rows, the last column and row are repeated for odd sizes
+    typedef void(*BoxRowKernel)(const float* row0, const float* row1, float* out, uint32_t srcWidth, uint32_t dstWidth);
+    /// horizontal pass of the Kaiser filter, 6 taps per texel
+    typedef void(*KaiserRowKernel)(const float* row, float* out, uint32_t srcWidth, uint32_t dstWidth, const KaiserWeights& w);
+    /// vertical pass of the Kaiser filter, sums 6 rows of floats
+    typedef void(*KaiserColumnKernel)(const float* const* rows, float* out, uint32_t countFloats, const KaiserWeights& w);
+
+    struct Kernels {
+        BoxRowKernel       m_boxRow       = nullptr;
+        KaiserRowKernel    m_kaiserRow    = nullptr;
+        KaiserColumnKernel m_kaiserColumn = nullptr;
+        bool               m_avx2         = false;
+    };
+
+    static uint32_t Clamp(int64_t x, uint32_t size) {
+        return static_cast<uint32_t>(std::clamp<int64_t>(x, 0, static_cast<int64_t>(size) - 1));
+    }
+
+    static void BoxTexelScalar(const float* row0, const float* row1, float* out, uint32_t srcWidth, uint32_t x) {
+        const uint32_t x0 = Clamp(2 * int64_t(x), srcWidth) * 4;
+        const uint32_t x1 = Clamp(2 * int64_t(x) + 1, srcWidth) * 4;
+        for (uint32_t c = 0; c < 4; ++c)
+            out[x * 4 + c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25f;
+    }
+
+    static void KaiserTexelScalar(const float* row, float* out, uint32_t srcWidth, uint32_t x, const KaiserWeights& w) {
+        const int64_t base = 2 * int64_t(x);
+        const uint32_t taps[6] = {
+                Clamp(base - 2, srcWidth) * 4, Clamp(base - 1, srcWidth) * 4, Clamp(base, srcWidth) * 4,
+                Clamp(base + 1, srcWidth) * 4, Clamp(base + 2, srcWidth) * 4, Clamp(base + 3, srcWidth) * 4
+        };
+        for (uint32_t c = 0; c < 4; ++c) {
+            out[x * 4 + c] = w.m_far  * (row[taps[0] + c] + row[taps[5] + c]) +
+                             w.m_mid  * (row[taps[1] + c] + row[taps[4] + c]) +
+                             w.m_near * (row[taps[2] + c] + row[taps[3] + c]);
+        }
+    }
+
+    /// first and last output texels whose taps are all inside the row
+    static void KaiserInterior(uint32_t srcWidth, uint32_t dstWidth, uint32_t& begin, uint32_t& end) {
+        begin = std::min(1u, dstWidth);
+        end   = srcWidth >= 4 ? std::min(dstWidth, (srcWidth - 4) / 2 + 1) : begin;
+        end   = std::max(begin, end);
+    }
+
+#ifndef EVK_MIP_X86
+    static void BoxRowScalar(const float* row0, const float* row1, float* out, uint32_t srcWidth, uint32_t dstWidth) {
+        for (uint32_t x = 0; x < dstWidth; ++x)
+            BoxTexelScalar(row0, row1, out, srcWidth, x);
+    }
+
+    static void KaiserRowScalar(const float* row, float* out, uint32_t srcWidth, uint32_t dstWidth, const KaiserWeights& w) {
+        for (uint32_t x = 0; x < dstWidth; ++x)
+            KaiserTexelScalar(row, out, srcWidth, x, w);
+    }
+
+    static void KaiserColumnScalar(const float* const* rows, float* out, uint32_t countFloats, const KaiserWeights& w) {
+        for (uint32_t i = 0; i < countFloats; ++i) {
+            out[i] = w.m_far  * (rows[0][i] + rows[5][i]) +
+                     w.m_mid  * (rows[1][i] + rows[4][i]) +
+                     w.m_near * (rows[2][i] + rows[3][i]);
+        }
+    }
+#else
+    //!=================================================================================================================
+    //! SSE2, one RGBA texel per register
+
+    static void BoxRowSSE(const float* row0, const float* row1, float* out, uint32_t srcWidth, uint32_t dstWidth) {
+        const __m128 quarter = _mm_set1_ps(0.25f);
+
+        /// texels whose 2x2 footprint is inside the level
+        const uint32_t interior = std::min(dstWidth, srcWidth / 2);
+
+        for (uint32_t x = 0; x < interior; ++x) {
+            const __m128 a = _mm_add_ps(_mm_loadu_ps(row0 + x * 8), _mm_loadu_ps(row0 + x * 8 + 4));
+            const __m128 b = _mm_add_ps(_mm_loadu_ps(row1 + x * 8), _mm_loadu_ps(row1 + x * 8 + 4));
+            _mm_storeu_ps(out + x * 4, _mm_mul_ps(_mm_add_ps(a, b), quarter));
+        }
+
+        for (uint32_t x = interior; x < dstWidth; ++x)
+            BoxTexelScalar(row0, row1, out, srcWidth, x);
+    }
+
+    static void KaiserRowSSE(const float* row, float* out, uint32_t srcWidth, uint32_t dstWidth, const KaiserWeights& w) {
+        uint32_t begin, end;
+        KaiserInterior(srcWidth, dstWidth, begin, end);
+
+        const __m128 wFar  = _mm_set1_ps(w.m_far);
+        const __m128 wMid  = _mm_set1_ps(w.m_mid);
+        const __m128 wNear = _mm_set1_ps(w.m_near);
+
+        for (uint32_t x = 0; x < begin; ++x)
+            KaiserTexelScalar(row, out, srcWidth, x, w);
+
+        for (uint32_t x = begin; x < end; ++x) {
+            const float* taps = row + (2 * x - 2) * 4;
+            __m128 sum = _mm_mul_ps(wFar, _mm_add_ps(_mm_loadu_ps(taps), _mm_loadu_ps(taps + 20)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(wMid, _mm_add_ps(_mm_loadu_ps(taps + 4), _mm_loadu_ps(taps + 16))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(wNear, _mm_add_ps(_mm_loadu_ps(taps + 8), _mm_loadu_ps(taps + 12))));
+            _mm_storeu_ps(out + x * 4, sum);
+        }
+
+        for (uint32_t x = end; x < dstWidth; ++x)
+            KaiserTexelScalar(row, out, srcWidth, x, w);
+    }
+
+    static void KaiserColumnSSE(const float* const* rows, float* out, uint32_t countFloats, const KaiserWeights& w) {
+        const __m128 wFar  = _mm_set1_ps(w.m_far);
+        const __m128 wMid  = _mm_set1_ps(w.m_mid);
+        const __m128 wNear = _mm_set1_ps(w.m_near);
+
+        /// rows are RGBA, the count is a multiple of 4
+        for (uint32_t i = 0; i < countFloats; i += 4) {
+            __m128 sum = _mm_mul_ps(wFar, _mm_add_ps(_mm_loadu_ps(rows[0] + i), _mm_loadu_ps(rows[5] + i)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(wMid, _mm_add_ps(_mm_loadu_ps(rows[1] + i), _mm_loadu_ps(rows[4] + i))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(wNear, _mm_add_ps(_mm_loadu_ps(rows[2] + i), _mm_loadu_ps(rows[3] + i))));
+            _mm_storeu_ps(out + i, sum);
+        }
+    }
+
+    //!=================================================================================================================
+    //! AVX2, two RGBA texels per register
+
+    EVK_TARGET_AVX2 static void BoxRowAVX2(const float* row0, const float* row1, float* out, uint32_t srcWidth, uint32_t dstWidth) {
+        const __m256 quarter = _mm256_set1_ps(0.25f);
+
+        const uint32_t interior = std::min(dstWidth, srcWidth / 2);
+        uint32_t x = 0;
+
+        /// 4 source texels of both rows -> 2 output texels
+        for (; x + 2 <= interior; x += 2) {
+            const __m256 a = _mm256_add_ps(_mm256_loadu_ps(row0 + x * 8), _mm256_loadu_ps(row1 + x * 8));
+            const __m256 b = _mm256_add_ps(_mm256_loadu_ps(row0 + x * 8 + 8), _mm256_loadu_ps(row1 + x * 8 + 8));
+            const __m256 sum = _mm256_add_ps(_mm256_permute2f128_ps(a, b, 0x20), _mm256_permute2f128_ps(a, b, 0x31));
+            _mm256_storeu_ps(out + x * 4, _mm256_mul_ps(sum, quarter));
+        }
+
+        for (; x < dstWidth; ++x)
+            BoxTexelScalar(row0, row1, out, srcWidth, x);
+    }
+
+    /// taps of the next texel are 2 texels further, both are gathered by 128 bit halves
+    EVK_TARGET_AVX2 static inline __m256 LoadTexelPair(const float* taps) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(taps)), _mm_loadu_ps(taps + 8), 1);
+    }
+
+    EVK_TARGET_AVX2 static void KaiserRowAVX2(const float* row, float* out, uint32_t srcWidth, uint32_t dstWidth, const KaiserWeights& w) {
+        uint32_t begin, end;
+        KaiserInterior(srcWidth, dstWidth, begin, end);
+
+        const __m256 wFar  = _mm256_set1_ps(w.m_far);
+        const __m256 wMid  = _mm256_set1_ps(w.m_mid);
+        const __m256 wNear = _mm256_set1_ps(w.m_near);
+
+        for (uint32_t x = 0; x < begin; ++x)
+            KaiserTexelScalar(row, out, srcWidth, x, w);
+
+        uint32_t x = begin;
+        for (; x + 2 <= end; x += 2) {
+            const float* taps = row + (2 * x - 2) * 4;
+            __m256 sum = _mm256_mul_ps(wFar, _mm256_add_ps(LoadTexelPair(taps), LoadTexelPair(taps + 20)));
+            sum = _mm256_fmadd_ps(wMid, _mm256_add_ps(LoadTexelPair(taps + 4), LoadTexelPair(taps + 16)), sum);
+            sum = _mm256_fmadd_ps(wNear, _mm256_add_ps(LoadTexelPair(taps + 8), LoadTexelPair(taps + 12)), sum);
+            _mm256_storeu_ps(out + x * 4, sum);
+        }
+
+        for (; x < dstWidth; ++x)
+            KaiserTexelScalar(row, out, srcWidth, x, w);
+    }
+
+    EVK_TARGET_AVX2 static void KaiserColumnAVX2(const float* const* rows, float* out, uint32_t countFloats, const KaiserWeights& w) {
+        const __m256 wFar  = _mm256_set1_ps(w.m_far);
+        const __m256 wMid  = _mm256_set1_ps(w.m_mid);
+        const __m256 wNear = _mm256_set1_ps(w.m_near);
+
+        uint32_t i = 0;
+        for (; i + 8 <= countFloats; i += 8) {
+            __m256 sum = _mm256_mul_ps(wFar, _mm256_add_ps(_mm256_loadu_ps(rows[0] + i), _mm256_loadu_ps(rows[5] + i)));
+            sum = _mm256_fmadd_ps(wMid, _mm256_add_ps(_mm256_loadu_ps(rows[1] + i), _mm256_loadu_ps(rows[4] + i)), sum);
+            sum = _mm256_fmadd_ps(wNear, _mm256_add_ps(_mm256_loadu_ps(rows[2] + i), _mm256_loadu_ps(rows[3] + i)), sum);
+            _mm256_storeu_ps(out + i, sum);
+        }
+
+        /// the last odd texel
+        const float* tail[6] = { rows[0] + i, rows[1] + i, rows[2] + i, rows[3] + i, rows[4] + i, rows[5] + i };
+        KaiserColumnSSE(tail, out + i, countFloats - i, w);
+    }
+
+    /// AVX2 and FMA are reported by the CPU and their registers are saved by the OS
+    static bool IsAVX2Supported() {
+    #ifdef _MSC_VER
+        int info[4] = {};
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        const bool osxsave = info[2] & (1 << 27);
+        const bool fma     = info[2] & (1 << 12);
+        if (!osxsave || !fma || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return info[1] & (1 << 5);
+    #else
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    #endif
+    }
+#endif
+
+    static const Kernels& GetKernels() {
+        static const Kernels kernels = []() {
+        #ifdef EVK_MIP_X86
+            if (IsAVX2Supported())
+                return Kernels { BoxRowAVX2, KaiserRowAVX2, KaiserColumnAVX2, true };
+            return Kernels { BoxRowSSE, KaiserRowSSE, KaiserColumnSSE, false };
+        #else
+            return Kernels { BoxRowScalar, KaiserRowScalar, KaiserColumnScalar, false };
+        #endif
+        }();
+        return kernels;
+    }
+
+    //!=================================================================================================================
+
+    static void Downsample(
+            const std::vector<float>& src, uint32_t srcWidth, uint32_t srcHeight,
+            std::vector<float>& dst, uint32_t dstWidth, uint32_t dstHeight,
+            MipFilter filter, uint32_t countThreads)
+    {
+        auto&& kernels = GetKernels();
+        const size_t srcStride = size_t(srcWidth) * 4;
+        const size_t dstStride = size_t(dstWidth) * 4;
+
+        dst.resize(dstStride * dstHeight);
+
+        if (filter == MipFilter::Box) {
+            ParallelRows(dstHeight, dstWidth * dstHeight, countThreads, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t y = begin; y < end; ++y) {
+                    const float* row0 = src.data() + srcStride * Clamp(2 * int64_t(y), srcHeight);
+                    const float* row1 = src.data() + srcStride * Clamp(2 * int64_t(y) + 1, srcHeight);
+                    kernels.m_boxRow(row0, row1, dst.data() + dstStride * y, srcWidth, dstWidth);
+                }
+            });
+            return;
+        }
+
+        auto&& weights = GetKaiserWeights();
+
+        /// horizontal pass of every source row, then 6 rows of it per output row
+        std::vector<float> horizontal(dstStride * srcHeight);
+
+        ParallelRows(srcHeight, dstWidth * srcHeight, countThreads, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t y = begin; y < end; ++y)
+                kernels.m_kaiserRow(src.data() + srcStride * y, horizontal.data() + dstStride * y, srcWidth, dstWidth, weights);
+        });
+
+        ParallelRows(dstHeight, dstWidth * dstHeight, countThreads, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t y = begin; y < end; ++y) {
+                const float* rows[6];
+                for (int64_t k = 0; k < 6; ++k)
+                    rows[k] = horizontal.data() + dstStride * Clamp(2 * int64_t(y) - 2 + k, srcHeight);
+                kernels.m_kaiserColumn(rows, dst.data() + dstStride * y, static_cast<uint32_t>(dstStride), weights);
+            }
+        });
+    }
+
+    static float ComputeCoverage(const std::vector<float>& level, float cutoff, float scale) {
+        size_t covered = 0;
+        for (size_t i = 3; i < level.size(); i += 4)
+            if (level[i] * scale > cutoff)
+                ++covered;
+        return static_cast<float>(covered) / static_cast<float>(level.size() / 4);
+    }
+
+    /// scale of alpha which gives the level the same coverage as level 0
+    static float FindCoverageScale(const std::vector<float>& level, float cutoff, float coverage) {
+        float low = 0.f, high = 4.f, scale = 1.f;
+
+        for (uint32_t i = 0; i < 10; ++i) {
+            const float current = ComputeCoverage(level, cutoff, scale);
+            if (std::abs(current - coverage) < 0.001f)
+                break;
+
+            if (current < coverage)
+                low = scale;
+            else
+                high = scale;
+
+            scale = (low + high) * 0.5f;
+        }
+
+        return scale;
+    }
+
+    static void Encode(const std::vector<float>& level, uint8_t* out, bool srgb, float alphaScale) {
+        const size_t count = level.size();
+        for (size_t i = 0; i < count; i += 4) {
+            for (size_t c = 0; c < 3; ++c)
+                out[i + c] = srgb ? EncodeSRGB(level[i + c]) : EncodeUNORM(level[i + c]);
+            out[i + 3] = EncodeUNORM(level[i + 3] * alphaScale);
+        }
+    }
+}
+
+bool EvoVulkan::Tools::IsMipChainAVX2() {
+    return MipKernels::GetKernels().m_avx2;
+}
+
+bool EvoVulkan::Tools::GenerateMipChain(
+        const uint8_t* pixels,
+        uint32_t width,
+        uint32_t height,
+        const MipChainInfo& info,
+        MipChain& chain)
+{
+    using namespace MipKernels;
+
+    if (!pixels || width == 0 || height == 0) {
+        VK_ERROR("Tools::GenerateMipChain() : invalid pixels or sizes!");
+        return false;
+    }
+
+    const uint32_t fullChain = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    const uint32_t mipLevels = info.m_mipLevels == 0 ? fullChain : std::min(info.m_mipLevels, fullChain);
+    const uint32_t countThreads = info.m_countThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : info.m_countThreads;
+
+    /// layout of the levels, all of them are written into one allocation
+    chain.m_levels.resize(mipLevels);
+    {
+        VkDeviceSize offset = 0;
+        uint32_t w = width, h = height;
+        for (auto&& level : chain.m_levels) {
+            level = MipLevel { w, h, offset, VkDeviceSize(w) * h * 4 };
+            offset += level.m_size;
+            w = std::max(1u, w / 2);
+            h = std::max(1u, h / 2);
+        }
+        chain.m_data.resize(offset);
+    }
+
+    memcpy(chain.m_data.data(), pixels, chain.m_levels[0].m_size);
+
+    if (mipLevels == 1)
+        return true;
+
+    /// levels are filtered in linear float space, each from the previous one
+    std::vector<float> current(size_t(width) * height * 4);
+    {
+        auto&& decode = GetSRGBDecodeTable();
+        ParallelRows(height, width * height, countThreads, [&](uint32_t begin, uint32_t end) {
+            for (size_t i = size_t(begin) * width * 4; i < size_t(end) * width * 4; ++i)
+                current[i] = (info.m_srgb && (i % 4) != 3) ? decode[pixels[i]] : static_cast<float>(pixels[i]) / 255.f;
+        });
+    }
+
+    const bool preserveCoverage = info.m_alphaCutoff > 0.f;
+    const float coverage = preserveCoverage ? ComputeCoverage(current, info.m_alphaCutoff, 1.f) : 0.f;
+
+    std::vector<float> next;
+
+    for (uint32_t i = 1; i < mipLevels; ++i) {
+        auto&& src = chain.m_levels[i - 1];
+        auto&& dst = chain.m_levels[i];
+
+        Downsample(current, src.m_width, src.m_height, next, dst.m_width, dst.m_height, info.m_filter, countThreads);
+
+        /// only stored alpha is scaled, the next level is filtered from the unscaled one
+        const float alphaScale = preserveCoverage ? FindCoverageScale(next, info.m_alphaCutoff, coverage) : 1.f;
+
+        Encode(next, chain.m_data.data() + dst.m_offset, info.m_srgb, alphaScale);
+
+        std::swap(current, next);
+    }
+
+    return true;
+}
@@ -168,6 +168,26 @@ namespace EvoVulkan::Tools {
         return sync;
     }
 
+    VkSemaphore CreateTimelineSemaphore(const VkDevice& device, uint64_t initialValue) {
+        VkSemaphoreTypeCreateInfo timelineCreateInfo = {};
+        timelineCreateInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineCreateInfo.initialValue  = initialValue;
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo = Initializers::SemaphoreCreateInfo();
+        semaphoreCreateInfo.pNext = &timelineCreateInfo;
+
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        auto result = vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphore);
+        if (result != VK_SUCCESS) {
+            VK_ERROR("Tools::CreateTimelineSemaphore() : failed to create timeline semaphore! Reason: " +
+                     Convert::result_to_description(result));
+            return VK_NULL_HANDLE;
+        }
+
+        return semaphore;
+    }
+
     VkAttachmentDescription CreateColorAttachmentDescription(
             VkFormat format,
             VkSampleCountFlagBits samples,
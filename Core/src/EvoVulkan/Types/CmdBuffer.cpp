@@ -111,12 +111,27 @@ bool EvoVulkan::Types::CmdBuffer::End() {
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &m_buffer;
 
-    auto result = vkQueueSubmit(m_device->GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+    /// buffers of a transfer or compute pool can't be executed by the graphics queue
+    VkQueue queue = m_device->GetQueues()->GetQueue(m_cmdPool->GetQueueFamilyIndex());
+
+    /// waits only for this buffer, other work of the queue (e.g. streaming uploads) keeps running
+    VkFenceCreateInfo fenceCI = Tools::Initializers::FenceCreateInfo();
+    VkFence fence = VK_NULL_HANDLE;
+    if (vkCreateFence(*m_device, &fenceCI, nullptr, &fence) != VK_SUCCESS) {
+        VK_ERROR("CmdBuffer::End() : failed to create fence!");
+        return false;
+    }
+
+    auto result = vkQueueSubmit(queue, 1, &submitInfo, fence);
+    if (result == VK_SUCCESS)
+        result = vkWaitForFences(*m_device, 1, &fence, VK_TRUE, UINT64_MAX);
+
+    vkDestroyFence(*m_device, fence, nullptr);
+
     if (result != VK_SUCCESS) {
         VK_ERROR("CmdBuffer::End() : failed to queue submit!");
         return false;
     }
-    vkQueueWaitIdle(m_device->GetGraphicsQueue());
 
     return true;
 }
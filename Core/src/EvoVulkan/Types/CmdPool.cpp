@@ -29,7 +29,26 @@ void EvoVulkan::Types::CmdPool::Free() {
     delete this;
 }
 
+bool EvoVulkan::Types::CmdPool::Reset(bool releaseResources) {
+    auto result = vkResetCommandPool(*m_device, m_pool, releaseResources ? VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT : 0);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("CmdPool::Reset() : failed to reset command pool! Reason: "
+            + Tools::Convert::result_to_description(result));
+        return false;
+    }
+
+    return true;
+}
+
 EvoVulkan::Types::CmdPool *EvoVulkan::Types::CmdPool::Create(EvoVulkan::Types::Device *device) {
+    return Create(device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+}
+
+EvoVulkan::Types::CmdPool *EvoVulkan::Types::CmdPool::Create(EvoVulkan::Types::Device *device, VkCommandPoolCreateFlags flags) {
+    return Create(device, flags, device->GetQueues()->GetGraphicsIndex());
+}
+
+EvoVulkan::Types::CmdPool *EvoVulkan::Types::CmdPool::Create(EvoVulkan::Types::Device *device, VkCommandPoolCreateFlags flags, uint32_t queueFamilyIndex) {
     Tools::VkDebug::Graph("CmdPool::Create() : create vulkan command pool...");
 
     if (!device->IsReady()) {
@@ -41,8 +60,8 @@ EvoVulkan::Types::CmdPool *EvoVulkan::Types::CmdPool::Create(EvoVulkan::Types::D
 
     VkCommandPoolCreateInfo cmdPoolInfo = {};
     cmdPoolInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    cmdPoolInfo.queueFamilyIndex        = device->GetQueues()->GetGraphicsIndex();
-    cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    cmdPoolInfo.queueFamilyIndex        = queueFamilyIndex;
+    cmdPoolInfo.flags = flags;
 
     VkResult vkRes = vkCreateCommandPool(*device, &cmdPoolInfo, nullptr, &cmdPool);
     if (vkRes != VK_SUCCESS) {
@@ -55,6 +74,8 @@ EvoVulkan::Types::CmdPool *EvoVulkan::Types::CmdPool::Create(EvoVulkan::Types::D
     {
         commandPool->m_pool   = cmdPool;
         commandPool->m_device = device;
+        commandPool->m_flags  = flags;
+        commandPool->m_family = queueFamilyIndex;
     }
 
     return commandPool;
@@ -8,6 +8,8 @@
 #include <EvoVulkan/Memory/Allocator.h>
 #include <EvoVulkan/Tools/DeviceTools.h>
 
+#include <algorithm>
+
 EvoVulkan::Types::Device *EvoVulkan::Types::Device::Create(const EvoDeviceCreateInfo& info) {
     if (info.physicalDevice == VK_NULL_HANDLE) {
         Tools::VkDebug::Error("Device::Create() : physical device is nullptr!");
@@ -44,10 +46,57 @@ EvoVulkan::Types::Device *EvoVulkan::Types::Device::Create(const EvoDeviceCreate
     VkPhysicalDeviceProperties deviceProperties;
     vkGetPhysicalDeviceProperties(device->m_physicalDevice, &deviceProperties);
     {
-        device->m_maxSamplerAnisotropy = deviceProperties.limits.maxSamplerAnisotropy;
+        device->m_maxSamplerAnisotropy   = deviceProperties.limits.maxSamplerAnisotropy;
+        device->m_uniformBufferAlignment = deviceProperties.limits.minUniformBufferOffsetAlignment;
+        device->m_maxUniformBufferRange  = deviceProperties.limits.maxUniformBufferRange;
+        device->m_copyOffsetAlignment    = deviceProperties.limits.optimalBufferCopyOffsetAlignment;
     }
 
     device->m_deviceName = Tools::GetDeviceName(info.physicalDevice);
+    device->m_timelineSemaphores = Tools::IsTimelineSemaphoreSupported(info.physicalDevice);
+    device->m_bufferDeviceAddress = Tools::IsBufferDeviceAddressSupported(info.physicalDevice);
+    device->m_presentWait        = info.presentWait;
+
+#ifdef VK_EXT_host_image_copy
+    if (info.hostImageCopy) {
+        VkPhysicalDeviceHostImageCopyPropertiesEXT hostCopyProperties = {};
+        hostCopyProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2 properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &hostCopyProperties;
+
+        /// the first call returns counts of layouts
+        vkGetPhysicalDeviceProperties2(info.physicalDevice, &properties2);
+
+        std::vector<VkImageLayout> srcLayouts(hostCopyProperties.copySrcLayoutCount);
+        std::vector<VkImageLayout> dstLayouts(hostCopyProperties.copyDstLayoutCount);
+        hostCopyProperties.pCopySrcLayouts = srcLayouts.data();
+        hostCopyProperties.pCopyDstLayouts = dstLayouts.data();
+
+        vkGetPhysicalDeviceProperties2(info.physicalDevice, &properties2);
+
+        /// textures are sampled in the layout they are written in, there are no transitions after the copy
+        for (auto&& layout : { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL })
+            if (std::find(dstLayouts.begin(), dstLayouts.end(), layout) != dstLayouts.end()) {
+                device->m_hostCopyLayout = layout;
+                break;
+            }
+
+        if (device->m_hostCopyLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
+            device->m_copyMemoryToImage     = vkGetDeviceProcAddr(info.logicalDevice, "vkCopyMemoryToImageEXT");
+            device->m_transitionImageLayout = vkGetDeviceProcAddr(info.logicalDevice, "vkTransitionImageLayoutEXT");
+
+            if (!device->m_transitionImageLayout)
+                device->m_copyMemoryToImage = nullptr;
+        }
+
+        if (device->m_copyMemoryToImage)
+            VK_LOG("Device::Create() : host image copy is enabled.");
+        else
+            VK_WARN("Device::Create() : host image copy is supported, but it can't be used for sampled textures!");
+    }
+#endif
 
     /// device->m_maxCountMSAASamples = calculate...
     if (info.multisampling) {
@@ -144,6 +193,81 @@ bool EvoVulkan::Types::Device::IsSupportLinearBlitting(const VkFormat& imageForm
     return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
 }
 
+bool EvoVulkan::Types::Device::IsSupportHostImageCopy(VkFormat format, VkImageTiling tiling) const {
+#ifdef VK_EXT_host_image_copy
+    if (!m_copyMemoryToImage)
+        return false;
+
+    VkFormatProperties3KHR formatProperties3 = {};
+    formatProperties3.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_3_KHR;
+
+    VkFormatProperties2 formatProperties2 = {};
+    formatProperties2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    formatProperties2.pNext = &formatProperties3;
+
+    vkGetPhysicalDeviceFormatProperties2(m_physicalDevice, format, &formatProperties2);
+
+    const VkFormatFeatureFlags2KHR features = tiling == VK_IMAGE_TILING_LINEAR ?
+            formatProperties3.linearTilingFeatures : formatProperties3.optimalTilingFeatures;
+
+    return (features & VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT) && (features & VK_FORMAT_FEATURE_2_SAMPLED_IMAGE_BIT_KHR);
+#else
+    return false;
+#endif
+}
+
+VkResult EvoVulkan::Types::Device::TransitionImageLayoutOnHost(VkImage image, VkImageLayout newLayout, const VkImageSubresourceRange& range) const {
+#ifdef VK_EXT_host_image_copy
+    if (m_transitionImageLayout) {
+        VkHostImageLayoutTransitionInfoEXT transitionInfo = {};
+        transitionInfo.sType            = VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT;
+        transitionInfo.image            = image;
+        transitionInfo.oldLayout        = VK_IMAGE_LAYOUT_UNDEFINED;
+        transitionInfo.newLayout        = newLayout;
+        transitionInfo.subresourceRange = range;
+
+        return reinterpret_cast<PFN_vkTransitionImageLayoutEXT>(m_transitionImageLayout)(m_logicalDevice, 1, &transitionInfo);
+    }
+#endif
+
+    return VK_ERROR_EXTENSION_NOT_PRESENT;
+}
+
+VkResult EvoVulkan::Types::Device::CopyMemoryToImage(
+        VkImage image,
+        VkImageLayout layout,
+        const void* const* pixels,
+        const VkBufferImageCopy* regions,
+        uint32_t countRegions) const
+{
+#ifdef VK_EXT_host_image_copy
+    if (m_copyMemoryToImage) {
+        /// the same regions as for a staging buffer, but every one has its own host pointer
+        std::vector<VkMemoryToImageCopyEXT> copies(countRegions);
+        for (uint32_t i = 0; i < countRegions; ++i) {
+            copies[i].sType             = VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+            copies[i].pHostPointer      = pixels[i];
+            copies[i].memoryRowLength   = regions[i].bufferRowLength;
+            copies[i].memoryImageHeight = regions[i].bufferImageHeight;
+            copies[i].imageSubresource  = regions[i].imageSubresource;
+            copies[i].imageOffset       = regions[i].imageOffset;
+            copies[i].imageExtent       = regions[i].imageExtent;
+        }
+
+        VkCopyMemoryToImageInfoEXT copyInfo = {};
+        copyInfo.sType          = VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT;
+        copyInfo.dstImage       = image;
+        copyInfo.dstImageLayout = layout;
+        copyInfo.regionCount    = countRegions;
+        copyInfo.pRegions       = copies.data();
+
+        return reinterpret_cast<PFN_vkCopyMemoryToImageEXT>(m_copyMemoryToImage)(m_logicalDevice, &copyInfo);
+    }
+#endif
+
+    return VK_ERROR_EXTENSION_NOT_PRESENT;
+}
+
 VkCommandPool EvoVulkan::Types::Device::CreateCommandPool(VkCommandPoolCreateFlags flagBits) const {
     VkCommandPoolCreateInfo commandPoolCreateInfo = {
             VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -17,6 +17,16 @@ bool EvoVulkan::Types::FamilyQueues::IsReady() const {
     return IsComplete() && (m_graphicsQueue != VK_NULL_HANDLE);
 }
 
+VkQueue EvoVulkan::Types::FamilyQueues::GetQueue(uint32_t familyIndex) const noexcept {
+    if (familyIndex == GetTransferIndex() && IsTransferDedicated())
+        return m_transferQueue;
+
+    if (familyIndex == GetComputeIndex() && IsComputeDedicated())
+        return m_computeQueue;
+
+    return m_graphicsQueue;
+}
+
 EvoVulkan::Types::FamilyQueues* EvoVulkan::Types::FamilyQueues::Find(
         VkPhysicalDevice const &device,
         const EvoVulkan::Types::Surface *surface)
@@ -45,7 +55,10 @@ EvoVulkan::Types::FamilyQueues* EvoVulkan::Types::FamilyQueues::Find(
             queues->m_iGraphics = i;
 
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, *surface, &presentSupport);
+        if (surface)
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, *surface, &presentSupport);
+        else
+            presentSupport = queues->m_iGraphics == i; /// headless, "present" is done by the graphics queue
 
         if (presentSupport)
             queues->m_iPresent = i;
@@ -56,6 +69,32 @@ EvoVulkan::Types::FamilyQueues* EvoVulkan::Types::FamilyQueues::Find(
         i++;
     }
 
+    /// async compute family doesn't support graphics, so it is scheduled independently of rasterization
+    for (i = 0; i < static_cast<int>(queueFamilies.size()); ++i) {
+        const VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT)) {
+            queues->m_iCompute = i;
+            break;
+        }
+    }
+
+    /// graphics family always supports compute
+    if (queues->m_iCompute < 0)
+        queues->m_iCompute = queues->m_iGraphics;
+
+    /// transfer-only family is usually backed by a copy engine which runs concurrently with both graphics and compute
+    for (i = 0; i < static_cast<int>(queueFamilies.size()); ++i) {
+        const VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            queues->m_iTransfer = i;
+            break;
+        }
+    }
+
+    /// graphics family always supports transfer
+    if (queues->m_iTransfer < 0)
+        queues->m_iTransfer = queues->m_iGraphics;
+
     return queues;
 }
 
@@ -67,9 +106,13 @@ void EvoVulkan::Types::FamilyQueues::Destroy() {
 
     m_graphicsQueue = VK_NULL_HANDLE;
     m_presentQueue  = VK_NULL_HANDLE;
+    m_computeQueue  = VK_NULL_HANDLE;
+    m_transferQueue = VK_NULL_HANDLE;
 
     m_iPresent  = -2;
     m_iGraphics = -2;
+    m_iCompute  = -2;
+    m_iTransfer = -2;
 }
 
 void EvoVulkan::Types::FamilyQueues::Free() {
@@ -11,6 +11,8 @@
 #include <EvoVulkan/Types/Surface.h>
 #include <EvoVulkan/Types/CmdBuffer.h>
 
+#include <EvoVulkan/Memory/Allocator.h>
+
 #include <EvoVulkan/Tools/VulkanInitializers.h>
 
 EvoVulkan::Types::Swapchain* EvoVulkan::Types::Swapchain::Create(
@@ -19,7 +21,9 @@ EvoVulkan::Types::Swapchain* EvoVulkan::Types::Swapchain::Create(
         EvoVulkan::Types::Device *device,
         bool vsync,
         unsigned int width,
-        unsigned int height)
+        unsigned int height,
+        VkPresentModeKHR presentMode,
+        uint32_t countImages)
 {
     VK_GRAPH("Swapchain::Create() : create vulkan swapchain...");
 
@@ -36,8 +40,16 @@ EvoVulkan::Types::Swapchain* EvoVulkan::Types::Swapchain::Create(
 
         swapchain->m_swapchain = VK_NULL_HANDLE;
         swapchain->m_vsync     = vsync;
+
+        swapchain->m_requestedPresentMode = presentMode;
+        swapchain->m_requestedCountImages = countImages;
     }
 
+#ifdef VK_KHR_present_wait
+    if (device->IsPresentWaitEnabled())
+        swapchain->m_waitForPresent = vkGetDeviceProcAddr(*device, "vkWaitForPresentKHR");
+#endif
+
     if (!swapchain->InitFormats()) {
         Tools::VkDebug::Error("Swapchain::Create() : failed to init depth format!");
         return nullptr;
@@ -53,9 +65,76 @@ EvoVulkan::Types::Swapchain* EvoVulkan::Types::Swapchain::Create(
     return swapchain;
 }
 
+EvoVulkan::Types::Swapchain *EvoVulkan::Types::Swapchain::CreateHeadless(
+        EvoVulkan::Types::Device *device,
+        EvoVulkan::Memory::Allocator *allocator,
+        VkFormat colorFormat,
+        uint32_t countImages,
+        unsigned int width,
+        unsigned int height)
+{
+    VK_GRAPH("Swapchain::CreateHeadless() : create headless swapchain...");
+
+    if (!allocator || countImages == 0) {
+        VK_ERROR("Swapchain::CreateHeadless() : invalid arguments!");
+        return nullptr;
+    }
+
+    auto* swapchain = new Swapchain();
+    {
+        swapchain->m_instance    = *device->GetInstance();
+        swapchain->m_device      = device;
+        swapchain->m_allocator   = allocator;
+        swapchain->m_countImages = countImages;
+
+        swapchain->m_colorFormat = colorFormat;
+        swapchain->m_colorSpace  = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+        swapchain->m_presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+    }
+
+    if (swapchain->m_depthFormat = Tools::GetDepthFormat(*device); swapchain->m_depthFormat == VK_FORMAT_UNDEFINED) {
+        VK_ERROR("Swapchain::CreateHeadless() : could not find a supported depth format!");
+        delete swapchain;
+        return nullptr;
+    }
+
+    if (!swapchain->ReSetup(width, height)) {
+        VK_ERROR("Swapchain::CreateHeadless() : failed to setup swapchain!");
+        delete swapchain;
+        return nullptr;
+    }
+
+    VK_GRAPH("Swapchain::CreateHeadless() : headless swapchain successfully created!");
+
+    return swapchain;
+}
+
 bool EvoVulkan::Types::Swapchain::ReSetup(uint32_t width, uint32_t height) {
     Tools::VkDebug::Graph("Swapchain::ReSetup() : re-setup vulkan swapchain...");
 
+    if (IsHeadless()) {
+        this->m_surfaceWidth  = width;
+        this->m_surfaceHeight = height;
+
+        /// frames in flight can still render into the old images, they are destroyed with the retired setup
+        if (m_buffers) {
+            RetiredSetup retired;
+            this->RetireBuffers(retired);
+            retired.m_images = std::move(m_headlessImages);
+
+            m_retired.emplace_back(std::move(retired));
+        }
+
+        this->DestroyHeadlessImages();
+
+        if (!CreateHeadlessImages() || !CreateBuffers()) {
+            VK_ERROR("Swapchain::ReSetup() : failed to create headless images!");
+            return false;
+        }
+
+        return true;
+    }
+
     VkSwapchainKHR oldSwapchain = m_swapchain;
 
     // Get physical device surface properties and formats
@@ -79,10 +158,17 @@ bool EvoVulkan::Types::Swapchain::ReSetup(uint32_t width, uint32_t height) {
     this->m_surfaceHeight = surfCaps.currentExtent.height;
 
     VK_GRAPH("Swapchain::ReSetup() : get present mode...");
-    this->m_presentMode = Tools::GetPresentMode(*m_device, *m_surface, m_vsync);
+    if (m_requestedPresentMode == VK_PRESENT_MODE_MAX_ENUM_KHR)
+        this->m_presentMode = Tools::GetPresentMode(*m_device, *m_surface, m_vsync);
+    else
+        this->m_presentMode = Tools::GetPresentMode(*m_device, *m_surface, m_requestedPresentMode);
 
     // Determine the number of images
-    uint32_t desiredNumberOfSwapchainImages = surfCaps.minImageCount + 1;
+    // More images give throughput, less images give latency
+    uint32_t desiredNumberOfSwapchainImages = std::max(m_requestedCountImages, surfCaps.minImageCount);
+    if (m_requestedCountImages == 0)
+        desiredNumberOfSwapchainImages = surfCaps.minImageCount + 1;
+
     VkSurfaceTransformFlagsKHR preTransform;
     {
         if ((surfCaps.maxImageCount > 0) && (desiredNumberOfSwapchainImages > surfCaps.maxImageCount))
@@ -147,12 +233,23 @@ bool EvoVulkan::Types::Swapchain::ReSetup(uint32_t width, uint32_t height) {
         return false;
     }
 
-    // If we just re-created an existing swapchain, we should destroy the old
-    // swapchain at this point.
+    this->m_imageUsage = swapchainCI.imageUsage;
+
+    // If we just re-created an existing swapchain, the old one is retired
+    // and will be destroyed by the owner when frames in flight are completed.
     //! Note: destroying the swapchain also cleans up all its associated
     //! presentable images once the platform is done with them.
-    if (oldSwapchain != VK_NULL_HANDLE)
-        vkDestroySwapchainKHR(*m_device, oldSwapchain, nullptr);
+    RetiredSetup retired;
+    retired.m_swapchain = oldSwapchain;
+
+    /// framebuffers of frames in flight can still refer to the old views, count images may be changed below
+    if (m_buffers)
+        this->RetireBuffers(retired);
+
+    if (retired.m_swapchain != VK_NULL_HANDLE || !retired.m_views.empty())
+        m_retired.emplace_back(std::move(retired));
+
+    this->m_firstPresentId = m_presentId + 1;
 
     //!=================================================================================================================
 
@@ -165,8 +262,6 @@ bool EvoVulkan::Types::Swapchain::ReSetup(uint32_t width, uint32_t height) {
     this->CreateImages();
 
     Tools::VkDebug::Graph("Swapchain::ReSetup() : create buffers...");
-    if (m_buffers)
-        this->DestroyBuffers();
     this->CreateBuffers();
 
     Tools::VkDebug::Graph("Swapchain::ReSetup() : swapchain successfully re-configured!");
@@ -188,8 +283,15 @@ void EvoVulkan::Types::Swapchain::Destroy() {
     }
 
     this->DestroyBuffers();
+    this->DestroyRetired();
+
+    if (IsHeadless()) {
+        this->DestroyHeadlessImages();
+        this->m_allocator = nullptr;
+    }
+    else
+        vkDestroySwapchainKHR(*m_device, m_swapchain, nullptr);
 
-    vkDestroySwapchainKHR(*m_device, m_swapchain, nullptr);
     this->m_swapchain = VK_NULL_HANDLE;
 
     this->m_device      = nullptr;
@@ -198,11 +300,42 @@ void EvoVulkan::Types::Swapchain::Destroy() {
     this->m_instance    = VK_NULL_HANDLE;
 }
 
+void EvoVulkan::Types::Swapchain::DestroyRetired() {
+    for (auto&& retired : m_retired)
+        this->DestroyRetired(retired);
+
+    m_retired.clear();
+}
+
+std::vector<EvoVulkan::Types::RetiredSetup> EvoVulkan::Types::Swapchain::TakeRetired() {
+    std::vector<RetiredSetup> retired;
+    retired.swap(m_retired);
+
+    return retired;
+}
+
+void EvoVulkan::Types::Swapchain::DestroyRetired(RetiredSetup& retired) const {
+    for (auto&& view : retired.m_views)
+        vkDestroyImageView(*m_device, view, nullptr);
+    retired.m_views.clear();
+
+    for (auto&& image : retired.m_images)
+        m_allocator->FreeImage(image);
+    retired.m_images.clear();
+
+    /// images of the swapchain are destroyed with it
+    if (retired.m_swapchain != VK_NULL_HANDLE) {
+        vkDestroySwapchainKHR(*m_device, retired.m_swapchain, nullptr);
+        retired.m_swapchain = VK_NULL_HANDLE;
+    }
+}
+
 bool EvoVulkan::Types::Swapchain::IsReady() const {
-    return  m_swapchain != VK_NULL_HANDLE &&
+    const bool presentable = IsHeadless() ? !m_headlessImages.empty() : (m_swapchain != VK_NULL_HANDLE && m_surface != nullptr);
+
+    return  presentable                   &&
             m_device    != nullptr        &&
             m_instance  != VK_NULL_HANDLE &&
-            m_surface   != nullptr        &&
 
             m_presentMode != VK_PRESENT_MODE_MAX_ENUM_KHR &&
             m_colorFormat != VK_FORMAT_UNDEFINED          &&
@@ -254,6 +387,14 @@ void EvoVulkan::Types::Swapchain::DestroyBuffers() {
         VK_WARN("Swapchain::DestroyBuffers() : failed to destroy swapchain buffers!");
 }
 
+void EvoVulkan::Types::Swapchain::RetireBuffers(RetiredSetup& retired) {
+    for (uint32_t i = 0; i < m_countImages; i++)
+        retired.m_views.emplace_back(m_buffers[i].m_view);
+
+    free(m_buffers);
+    m_buffers = nullptr;
+}
+
 bool EvoVulkan::Types::Swapchain::CreateImages() {
     this->m_countImages = 0;
 
@@ -326,13 +467,114 @@ bool EvoVulkan::Types::Swapchain::CreateBuffers() {
     return true;
 }
 
+bool EvoVulkan::Types::Swapchain::CreateHeadlessImages() {
+    this->m_imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    for (uint32_t i = 0; i < m_countImages; ++i) {
+        auto&& image = Types::Image::Create(Types::ImageCreateInfo(
+                m_device, m_allocator,
+                m_surfaceWidth, m_surfaceHeight,
+                m_colorFormat,
+                m_imageUsage,
+                false /** multisampling */
+        ));
+
+        if (!image.Valid()) {
+            VK_ERROR("Swapchain::CreateHeadlessImages() : failed to create image!");
+            return false;
+        }
+
+        m_headlessImages.emplace_back(image);
+    }
+
+    /// keep the same layout as a vulkan swapchain, so buffers are created the same way
+    m_swapchainImages = (VkImage*)malloc(m_countImages * sizeof(VkImage));
+    for (uint32_t i = 0; i < m_countImages; ++i)
+        m_swapchainImages[i] = m_headlessImages[i];
+
+    m_headlessCurrent = m_countImages - 1;
+
+    return true;
+}
+
+void EvoVulkan::Types::Swapchain::DestroyHeadlessImages() {
+    for (auto&& image : m_headlessImages)
+        m_allocator->FreeImage(image);
+
+    m_headlessImages.clear();
+
+    if (m_swapchainImages) {
+        free(m_swapchainImages);
+        m_swapchainImages = nullptr;
+    }
+}
+
+VkResult EvoVulkan::Types::Swapchain::AcquireHeadlessImage(VkSemaphore presentCompleteSemaphore, uint32_t *imageIndex) const {
+    m_headlessCurrent = (m_headlessCurrent + 1) % m_countImages;
+    *imageIndex = m_headlessCurrent;
+
+    if (presentCompleteSemaphore == VK_NULL_HANDLE)
+        return VK_SUCCESS;
+
+    /// there is no presentation engine, the image is available right away
+    VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &presentCompleteSemaphore;
+
+    return vkQueueSubmit(m_device->GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+}
+
+VkResult EvoVulkan::Types::Swapchain::PresentHeadlessImage(VkQueue queue, VkSemaphore waitSemaphore) const {
+    if (waitSemaphore == VK_NULL_HANDLE)
+        return VK_SUCCESS;
+
+    /// consume the render complete semaphore so it can be signaled again
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores    = &waitSemaphore;
+    submitInfo.pWaitDstStageMask  = &waitStage;
+
+    return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+}
+
 VkResult EvoVulkan::Types::Swapchain::AcquireNextImage(VkSemaphore presentCompleteSemaphore, uint32_t *imageIndex) const {
+    if (IsHeadless())
+        return AcquireHeadlessImage(presentCompleteSemaphore, imageIndex);
+
     // By setting timeout to UINT64_MAX we will always wait until the next image has been acquired or an actual error is thrown
     // With that we don't have to handle VK_NOT_READY
     return vkAcquireNextImageKHR(*m_device, m_swapchain, UINT64_MAX, presentCompleteSemaphore, (VkFence)nullptr, imageIndex);
 }
 
+VkResult EvoVulkan::Types::Swapchain::WaitForPresent(uint64_t presentId, uint64_t timeout) const {
+#ifdef VK_KHR_present_wait
+    if (m_waitForPresent && presentId >= m_firstPresentId)
+        return reinterpret_cast<PFN_vkWaitForPresentKHR>(m_waitForPresent)(*m_device, m_swapchain, presentId, timeout);
+#endif
+
+    return VK_SUCCESS;
+}
+
+VkExtent2D EvoVulkan::Types::Swapchain::GetCurrentExtent() const {
+    if (IsHeadless())
+        return { m_surfaceWidth, m_surfaceHeight };
+
+    VkSurfaceCapabilitiesKHR surfCaps = {};
+    if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(*m_device, *m_surface, &surfCaps) != VK_SUCCESS)
+        return { 0, 0 };
+
+    if (surfCaps.currentExtent.width == UINT32_MAX || surfCaps.currentExtent.height == UINT32_MAX)
+        return { 0, 0 };
+
+    return surfCaps.currentExtent;
+}
+
 bool EvoVulkan::Types::Swapchain::SurfaceIsAvailable() {
+    if (IsHeadless())
+        return true;
+
     VkSurfaceCapabilitiesKHR surfCaps = {};
     return !(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(*m_device, *m_surface, &surfCaps) != VK_SUCCESS);
 }
@@ -3,25 +3,58 @@
 //
 
 #include <EvoVulkan/Types/Texture.h>
+#include <EvoVulkan/Types/UploadBatch.h>
 #include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Complexes/MipGenerator.h>
+
+/// records the upload into a temporary batch and waits for it, one queue submit per texture
+template<typename Loader> static EvoVulkan::Types::Texture* LoadImmediate(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        EvoVulkan::Types::CmdPool* pool,
+        EvoVulkan::Types::CmdPool* transferPool,
+        EvoVulkan::Complexes::MipGenerator* mipGenerator,
+        const Loader& loader)
+{
+    auto batch = EvoVulkan::Types::UploadBatch::Create(device, allocator, pool, transferPool);
+    if (!batch || !batch->Begin()) {
+        EVSafeFreeObject(batch);
+        return nullptr;
+    }
+
+    batch->SetMipGenerator(mipGenerator);
 
-uint64_t GetDataSize(uint32_t w, uint32_t h, uint8_t level) {
-    uint64_t dataSize = 0;
-    for (uint8_t i = 0; i < level; i++) {
-        dataSize += w * h * 4 * 6;
-        w /= 2;
-        h /= 2;
+    EvoVulkan::Types::Texture* texture = loader(batch);
+
+    if (texture && (!batch->Submit() || !batch->Wait())) {
+        VK_ERROR("Texture::LoadImmediate() : failed to submit upload!");
+        texture->Destroy();
+        texture->Free();
+        texture = nullptr;
     }
-    return dataSize;
+
+    batch->Destroy();
+    batch->Free();
+
+    return texture;
 }
 
-uint64_t GetImageSize(uint32_t w, uint32_t h, uint8_t level, uint8_t face) {
-    for (uint8_t i = 0; i < level; i++) {
-        w /= 2;
-        h /= 2;
-    }
+/// mips are generated by the compute generator of the batch or by blits
+static bool CanGenerateMipmaps(
+        EvoVulkan::Types::UploadBatch* batch,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        uint32_t layerCount)
+{
+    if (mipLevels <= 1)
+        return true;
 
-    return (w * h * 4) * face;
+    if (auto&& generator = batch->GetMipGenerator(); generator && generator->IsSupported(format, width, height, mipLevels, layerCount))
+        return true;
+
+    return batch->GetDevice()->IsSupportLinearBlitting(format);
 }
 
 EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
@@ -33,6 +66,27 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
     uint32_t height,
     const std::array<uint8_t*, 6> &sides,
     uint32_t mipLevels,
+    bool cpuUsage,
+    CmdPool* transferPool,
+    Complexes::MipGenerator* mipGenerator)
+{
+    if (IsHostCopyPreferred(device, format, width, height, 6, mipLevels, cpuUsage)) {
+        const std::array<const void*, 6> layers = { sides[0], sides[1], sides[2], sides[3], sides[4], sides[5] };
+        return LoadOnHost(device, allocator, nullptr, pool, layers.data(), 6, format, width, height, VK_FILTER_LINEAR, cpuUsage);
+    }
+
+    return LoadImmediate(device, allocator, pool, transferPool, mipGenerator, [&](UploadBatch* batch) {
+        return LoadCubeMap(batch, format, width, height, sides, mipLevels, cpuUsage);
+    });
+}
+
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
+    UploadBatch* batch,
+    VkFormat format,
+    uint32_t width,
+    uint32_t height,
+    const std::array<uint8_t*, 6> &sides,
+    uint32_t mipLevels,
     bool cpuUsage)
 {
     if (mipLevels == 0)
@@ -42,6 +96,17 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
         mipLevels = std::floor(std::log2(std::max(width, height))) + 1;
 #endif
 
+    if (IsHostCopyPreferred(batch->GetDevice(), format, width, height, 6, mipLevels, cpuUsage)) {
+        const std::array<const void*, 6> layers = { sides[0], sides[1], sides[2], sides[3], sides[4], sides[5] };
+        return LoadOnHost(batch->GetDevice(), batch->GetAllocator(), nullptr, batch->GetCmdPool(), layers.data(), 6,
+                          format, width, height, VK_FILTER_LINEAR, cpuUsage);
+    }
+
+    if (!CanGenerateMipmaps(batch, format, width, height, mipLevels, 6)) {
+        VK_ERROR("Texture::LoadCubeMap() : device does not support linear blitting!");
+        return nullptr;
+    }
+
     VK_LOG("Texture::LoadCubeMap() : loading new cube map texture... \n\tWidth: " +
            std::to_string(width) + "\n\tHeight: " + std::to_string(height));
 
@@ -52,158 +117,158 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
         texture->m_mipLevels         = mipLevels;
         texture->m_format            = format;
         texture->m_descriptorManager = nullptr;
-        texture->m_allocator         = allocator;
-        texture->m_device            = device;
+        texture->m_allocator         = batch->GetAllocator();
+        texture->m_device            = batch->GetDevice();
         texture->m_canBeDestroyed    = true;
-        texture->m_pool              = pool;
+        texture->m_pool              = batch->GetCmdPool();
         texture->m_filter            = VkFilter::VK_FILTER_LINEAR;
         texture->m_cubeMap           = true;
         texture->m_cpuUsage          = cpuUsage;
     }
 
-    const VkDeviceSize imageSize = width * height * 4 * 6;
+    /// only the first level is given, the rest are generated
+    const VkDeviceSize layerSize = Tools::GetImageSize(format, width, height);
 
-    auto stagingBuffer = VmaBuffer::Create(allocator, imageSize * 2); // TODO: imageSize * 2? Check correctly or fix
-    if (void* data = stagingBuffer->MapData(); !data) {
+    const UploadBatch::Staging staging = batch->MapStaging(layerSize * 6, Tools::GetStagingAlignment(batch->GetDevice(), format));
+    auto&& data = static_cast<uint8_t*>(staging.m_data);
+    if (!data) {
         VK_ERROR("Texture::LoadCubeMap() : failed to map memory!");
         return nullptr;
     }
-    else {
-        const uint64_t layerSize = imageSize / 6;
-        for (uint8_t i = 0; i < 6; ++i)
-            memcpy(static_cast<uint8_t*>(data) + (layerSize * i), sides[i], layerSize);
-        stagingBuffer->Unmap();
-    }
-
-    /*texture->m_image = Tools::CreateImage(
-            texture->m_device,
-            texture->m_width, texture->m_height,
-            texture->m_mipLevels,
-            texture->m_format,
-            VK_IMAGE_TILING_OPTIMAL,
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            &texture->m_deviceMemory,
-            false, // multisampling
-            VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT, // flags
-            6); // cube map*/
-
-    auto imageCI = Types::ImageCreateInfo(
-            texture->m_device, texture->m_allocator, texture->m_width, texture->m_height, texture->m_format,
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            false, false, texture->m_mipLevels, 6, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
 
-    if (!(texture->m_image = Types::Image::Create(imageCI)).Valid()) {
-        VK_ERROR("Texture::LoadCubeMap() : failed to create image!");
-        return nullptr;
-    }
+    for (uint8_t i = 0; i < 6; ++i)
+        memcpy(data + (layerSize * i), sides[i], layerSize);
 
-    std::vector<VkBufferImageCopy> bufferCopyRegions = {};
+    std::array<VkBufferImageCopy, 6> bufferCopyRegions = {};
     for (uint8_t face = 0; face < 6; face++) {
-        for (uint8_t level = 0; level < (uint8_t) mipLevels; level++) {
-            uint64_t offset = GetDataSize(width, height, level);
-
-            if (face != 0)
-                offset += GetImageSize(width, height, level, face);
-
-            VkBufferImageCopy bufferCopyRegion = {};
-            bufferCopyRegion.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-            bufferCopyRegion.imageSubresource.mipLevel       = level;
-            bufferCopyRegion.imageSubresource.baseArrayLayer = face;
-            bufferCopyRegion.imageSubresource.layerCount     = 1;
-            bufferCopyRegion.imageExtent.width               = width >> level;
-            bufferCopyRegion.imageExtent.height              = height >> level;
-            bufferCopyRegion.imageExtent.depth               = 1;
-            bufferCopyRegion.bufferOffset                    = offset;
-            bufferCopyRegions.emplace_back(bufferCopyRegion);
-        }
+        VkBufferImageCopy& bufferCopyRegion = bufferCopyRegions[face];
+        bufferCopyRegion.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        bufferCopyRegion.imageSubresource.mipLevel       = 0;
+        bufferCopyRegion.imageSubresource.baseArrayLayer = face;
+        bufferCopyRegion.imageSubresource.layerCount     = 1;
+        bufferCopyRegion.imageExtent.width               = width;
+        bufferCopyRegion.imageExtent.height              = height;
+        bufferCopyRegion.imageExtent.depth               = 1;
+        bufferCopyRegion.bufferOffset                    = layerSize * face;
     }
 
-    auto copyCmd = Types::CmdBuffer::BeginSingleTime(device, pool);
+    if (!texture->Create(batch, staging, bufferCopyRegions.data(), static_cast<uint32_t>(bufferCopyRegions.size()), 6)) {
+        VK_ERROR("Texture::LoadCubeMap() : failed to create!");
+        return nullptr;
+    }
 
-    Tools::TransitionImageLayout(
-            copyCmd, texture->m_image,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            mipLevels, 6);
+    return texture;
+}
 
-    {
-        if (!copyCmd->IsBegin())
-            copyCmd->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
+        EvoVulkan::Types::Device *device,
+        Memory::Allocator *allocator,
+        Core::DescriptorManager* manager,
+        EvoVulkan::Types::CmdPool *pool,
+        const unsigned char *pixels,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        VkFilter filter,
+        bool cpuUsage,
+        CmdPool* transferPool,
+        Complexes::MipGenerator* mipGenerator)
+{
+    /// without a batch, so there is no submit and no wait
+    if (pixels && IsHostCopyPreferred(device, format, width, height, 1, mipLevels, cpuUsage)) {
+        const void* layers[] = { pixels };
+        return LoadOnHost(device, allocator, manager, pool, layers, 1, format, width, height, filter, cpuUsage);
+    }
 
-        // Copy the cube map faces from the staging buffer to the optimal tiled image
-        vkCmdCopyBufferToImage(
-                *copyCmd,
-                *stagingBuffer,
-                texture->m_image,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                static_cast<uint32_t>(bufferCopyRegions.size()),
-                bufferCopyRegions.data()
-        );
+    return LoadImmediate(device, allocator, pool, transferPool, mipGenerator, [&](UploadBatch* batch) {
+        return Load(batch, manager, pixels, format, width, height, mipLevels, filter, cpuUsage);
+    });
+}
 
-        copyCmd->End();
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
+        UploadBatch* batch,
+        Core::DescriptorManager* manager,
+        const unsigned char *pixels,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        VkFilter filter,
+        bool cpuUsage)
+{
+    if (!pixels) {
+        VK_ERROR("Texture::Load() : pixels is nullptr!");
+        return nullptr;
     }
 
-    Tools::TransitionImageLayout(
-            copyCmd, texture->m_image,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-            mipLevels, 6);
-
-    texture->m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    if (IsHostCopyPreferred(batch->GetDevice(), format, width, height, 1, mipLevels, cpuUsage)) {
+        const void* layers[] = { pixels };
+        return LoadOnHost(batch->GetDevice(), batch->GetAllocator(), manager, batch->GetCmdPool(), layers, 1,
+                          format, width, height, filter, cpuUsage);
+    }
 
-    //!=================================================================================================================
+    const UploadBatch::Staging staging = batch->Stage(pixels, Tools::GetImageSize(format, width, height), Tools::GetStagingAlignment(batch->GetDevice(), format));
+    if (!staging.Valid()) {
+        VK_ERROR("Texture::Load() : failed to stage pixels!");
+        return nullptr;
+    }
 
-    copyCmd->Destroy();
-    copyCmd->Free();
+    return Load(batch, manager, staging, format, width, height, mipLevels, filter, cpuUsage);
+}
 
-    stagingBuffer->Destroy();
-    stagingBuffer->Free();
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Decode(
+        Device *device,
+        Memory::Allocator *allocator,
+        Core::DescriptorManager* manager,
+        CmdPool *pool,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        VkFilter filter,
+        const PixelWriter& write,
+        bool cpuUsage,
+        CmdPool* transferPool,
+        Complexes::MipGenerator* mipGenerator)
+{
+    return LoadImmediate(device, allocator, pool, transferPool, mipGenerator, [&](UploadBatch* batch) {
+        return Decode(batch, manager, format, width, height, mipLevels, filter, write, cpuUsage);
+    });
+}
 
-    //!=================================================================================================================
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Decode(
+        UploadBatch* batch,
+        Core::DescriptorManager* manager,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        VkFilter filter,
+        const PixelWriter& write,
+        bool cpuUsage)
+{
+    const VkDeviceSize size = Tools::GetImageSize(format, width, height);
 
-    texture->m_view = Tools::CreateImageView(
-            *texture->m_device,
-            texture->m_image,
-            texture->m_format,
-            texture->m_mipLevels,
-            VK_IMAGE_ASPECT_COLOR_BIT,
-            true);
-    if (texture->m_view == VK_NULL_HANDLE) {
-        VK_ERROR("Texture::LoadCubeMap() : failed to create image view!");
+    const UploadBatch::Staging staging = batch->MapStaging(size, Tools::GetStagingAlignment(batch->GetDevice(), format));
+    if (!staging.Valid()) {
+        VK_ERROR("Texture::Decode() : failed to map staging memory!");
         return nullptr;
     }
 
-    //!=================================================================================================================
-
-    texture->m_sampler = Tools::CreateSampler(
-            texture->m_device,
-            texture->m_mipLevels,
-            texture->m_filter, texture->m_filter,
-            VK_SAMPLER_ADDRESS_MODE_REPEAT,
-            VK_COMPARE_OP_NEVER);
-    if (texture->m_sampler == VK_NULL_HANDLE) {
-        VK_ERROR("Texture::Create() : LoadCubeMap to create sampler image!");
+    /// the memory stays with the batch even if the writer fails, it's released with the batch
+    if (!write(static_cast<uint8_t*>(staging.m_data), size)) {
+        VK_ERROR("Texture::Decode() : failed to write pixels!");
         return nullptr;
     }
 
-    //!=================================================================================================================
-
-    //! make a texture descriptor
-    texture->m_descriptor = {
-            texture->m_sampler,
-            texture->m_view,
-            texture->m_imageLayout
-    };
-    return texture;
+    return Load(batch, manager, staging, format, width, height, mipLevels, filter, cpuUsage);
 }
 
 EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
-        EvoVulkan::Types::Device *device,
-        Memory::Allocator *allocator,
+        UploadBatch* batch,
         Core::DescriptorManager* manager,
-        EvoVulkan::Types::CmdPool *pool,
-        const unsigned char *pixels,
+        const UploadBatch::Staging& staging,
         VkFormat format,
         uint32_t width,
         uint32_t height,
@@ -211,12 +276,8 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
         VkFilter filter,
         bool cpuUsage)
 {
-    if (!pixels) {
-        VK_ERROR("Texture::Load() : pixels is nullptr!");
-        return nullptr;
-    }
-
-    if (!device->IsSupportLinearBlitting(format)) {
+    /// single level textures don't need blits at all
+    if (!CanGenerateMipmaps(batch, format, width, height, mipLevels, 1)) {
         VK_ERROR("Texture::Load() : device does not support linear blitting!");
         return nullptr;
     }
@@ -233,17 +294,21 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
         texture->m_mipLevels         = mipLevels;
         texture->m_format            = format;
         texture->m_descriptorManager = manager;
-        texture->m_allocator         = allocator;
-        texture->m_device            = device;
+        texture->m_allocator         = batch->GetAllocator();
+        texture->m_device            = batch->GetDevice();
         texture->m_canBeDestroyed    = true;
-        texture->m_pool              = pool;
+        texture->m_pool              = batch->GetCmdPool();
         texture->m_filter            = filter;
         texture->m_cubeMap           = false;
         texture->m_cpuUsage          = cpuUsage;
     }
 
-    auto stagingBuffer = VmaBuffer::Create(allocator, texture->m_width * texture->m_height * 4, (void*)pixels);
-    if (!texture->Create(stagingBuffer)) {
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent                 = { width, height, 1 };
+
+    if (!texture->Create(batch, staging, &region, 1, 1)) {
         VK_ERROR("Texture::Load() : failed to create!");
         return nullptr;
     }
@@ -251,61 +316,203 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
     return texture;
 }
 
-bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffer) {
-    /*m_image = Tools::CreateImage(
-            m_device,
-            m_width, m_height,
-            m_mipLevels,
-            m_format,
-            VK_IMAGE_TILING_OPTIMAL,
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            &m_deviceMemory,
-            false); */
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadLevels(
+        Device *device,
+        Memory::Allocator *allocator,
+        Core::DescriptorManager* manager,
+        CmdPool *pool,
+        const uint8_t* data,
+        const std::vector<Tools::MipLevel>& levels,
+        VkFormat format,
+        VkFilter filter,
+        bool cpuUsage,
+        CmdPool* transferPool)
+{
+    return LoadImmediate(device, allocator, pool, transferPool, nullptr, [&](UploadBatch* batch) {
+        return LoadLevels(batch, manager, data, levels, format, filter, cpuUsage);
+    });
+}
+
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadLevels(
+        UploadBatch* batch,
+        Core::DescriptorManager* manager,
+        const uint8_t* data,
+        const std::vector<Tools::MipLevel>& levels,
+        VkFormat format,
+        VkFilter filter,
+        bool cpuUsage)
+{
+    if (!data || levels.empty()) {
+        VK_ERROR("Texture::LoadLevels() : data is nullptr or there are no levels!");
+        return nullptr;
+    }
+
+    VkDeviceSize size = 0;
+    for (auto&& level : levels)
+        size = std::max(size, level.m_offset + level.m_size);
+
+    const UploadBatch::Staging staging = batch->Stage(data, size, Tools::GetStagingAlignment(batch->GetDevice(), format));
+    if (!staging.Valid()) {
+        VK_ERROR("Texture::LoadLevels() : failed to stage levels!");
+        return nullptr;
+    }
+
+    const uint32_t width  = levels.front().m_width;
+    const uint32_t height = levels.front().m_height;
+
+    VK_LOG("Texture::LoadLevels() : loading new texture... \n\tWidth: " +
+           std::to_string(width) + "\n\tHeight: " +
+           std::to_string(height) + "\n\tMip levels: " +
+           std::to_string(levels.size()) + "\n\tCPU usage: " + std::string(cpuUsage ? "True" : "False"));
+
+    auto *texture = new Texture();
+    {
+        texture->m_width             = width;
+        texture->m_height            = height;
+        texture->m_mipLevels         = static_cast<uint32_t>(levels.size());
+        texture->m_format            = format;
+        texture->m_descriptorManager = manager;
+        texture->m_allocator         = batch->GetAllocator();
+        texture->m_device            = batch->GetDevice();
+        texture->m_canBeDestroyed    = true;
+        texture->m_pool              = batch->GetCmdPool();
+        texture->m_filter            = filter;
+        texture->m_cubeMap           = false;
+        texture->m_cpuUsage          = cpuUsage;
+    }
+
+    std::vector<VkBufferImageCopy> regions(levels.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(levels.size()); ++i) {
+        VkBufferImageCopy& region = regions[i];
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel   = i;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent                 = { levels[i].m_width, levels[i].m_height, 1 };
+        region.bufferOffset                = levels[i].m_offset;
+    }
+
+    if (!texture->Create(batch, staging, regions.data(), static_cast<uint32_t>(regions.size()), 1, false)) {
+        VK_ERROR("Texture::LoadLevels() : failed to create!");
+        return nullptr;
+    }
+
+    return texture;
+}
+
+bool EvoVulkan::Types::Texture::Create(
+        UploadBatch* batch,
+        const UploadBatch::Staging& staging,
+        const VkBufferImageCopy* regions,
+        uint32_t countRegions,
+        uint32_t layerCount,
+        bool generateMipmaps)
+{
+    /// the generator of the batch is used if it supports the format, otherwise the levels are blitted
+    Complexes::MipGenerator* generator = (generateMipmaps && m_mipLevels > 1) ? batch->GetMipGenerator() : nullptr;
+    if (generator && !generator->IsSupported(m_format, m_width, m_height, m_mipLevels, layerCount))
+        generator = nullptr;
+
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    VkImageCreateFlags flags = m_cubeMap ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+
+    if (generator) {
+        usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+        flags |= Complexes::MipGenerator::GetImageFlags(m_format);
+    }
+
+    /// the sampled view of an image with the extended usage has no storage usage
+    m_viewUsage = (flags & VK_IMAGE_CREATE_EXTENDED_USAGE_BIT) ? (usage & ~VK_IMAGE_USAGE_STORAGE_BIT) : 0;
 
     auto imageCI = Types::ImageCreateInfo(
-            m_device, m_allocator, m_width, m_height, m_format,
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            false, m_cpuUsage, m_mipLevels);
+            m_device, m_allocator, m_width, m_height, m_format, usage,
+            false, m_cpuUsage, m_mipLevels, layerCount,
+            flags ? static_cast<VkImageCreateFlagBits>(flags) : VK_IMAGE_CREATE_FLAG_BITS_MAX_ENUM);
 
     if (!(m_image = Types::Image::Create(imageCI)).Valid()) {
         VK_ERROR("Texture::Create() : failed to create image!");
         return false;
     }
 
-    auto copyCmd = Types::CmdBuffer::BeginSingleTime(m_device, m_pool);
+    if (!batch->CopyToImage(staging, m_image, regions, countRegions, m_mipLevels, layerCount)) {
+        VK_ERROR("Texture::Create() : failed to record copy!");
+        return false;
+    }
 
-    Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels);
-    Tools::CopyBufferToImage(copyCmd, *stagingBuffer, m_image, m_width, m_height);
-    if (m_mipLevels == 1) {
-        Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels);
-        m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    } else
-    if (!GenerateMipmaps(this, copyCmd)) {
+    if (m_mipLevels == 1 || !generateMipmaps) {
+        if (!batch->TransitionImage(m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, layerCount)) {
+            VK_ERROR("Texture::Create() : failed to record layout transition!");
+            return false;
+        }
+    }
+    else if (generator) {
+        if (!generator->Record(batch, m_image, m_format, m_width, m_height, m_mipLevels, layerCount)) {
+            VK_ERROR("Texture::Create() : failed to record mip generation!");
+            return false;
+        }
+    }
+    else if (!batch->GenerateMipmaps(m_image, m_width, m_height, m_mipLevels, layerCount)) {
         VK_ERROR("Texture::Create() : failed to generate mip maps!");
         return false;
     }
 
-    //!=================================================================================================================
+    m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-    copyCmd->Destroy();
-    copyCmd->Free();
+    return CreateView();
+}
 
-    stagingBuffer->Destroy();
-    stagingBuffer->Free();
+bool EvoVulkan::Types::Texture::CreateOnHost(
+        const void* const* pixels,
+        const VkBufferImageCopy* regions,
+        uint32_t countRegions,
+        uint32_t layerCount)
+{
+#ifdef VK_EXT_host_image_copy
+    /// transfer bits aren't needed, the image is never touched by commands
+    auto imageCI = Types::ImageCreateInfo(
+            m_device, m_allocator, m_width, m_height, m_format,
+            VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            false, m_cpuUsage, m_mipLevels, layerCount, m_cubeMap ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : VK_IMAGE_CREATE_FLAG_BITS_MAX_ENUM);
 
-    //!=================================================================================================================
+    if (!(m_image = Types::Image::Create(imageCI)).Valid()) {
+        VK_ERROR("Texture::CreateOnHost() : failed to create image!");
+        return false;
+    }
 
+    m_imageLayout = m_device->GetHostCopyLayout();
+
+    VkImageSubresourceRange range = {};
+    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.levelCount = m_mipLevels;
+    range.layerCount = layerCount;
+
+    if (m_device->TransitionImageLayoutOnHost(m_image, m_imageLayout, range) != VK_SUCCESS) {
+        VK_ERROR("Texture::CreateOnHost() : failed to transition image layout!");
+        return false;
+    }
+
+    if (m_device->CopyMemoryToImage(m_image, m_imageLayout, pixels, regions, countRegions) != VK_SUCCESS) {
+        VK_ERROR("Texture::CreateOnHost() : failed to copy memory to image!");
+        return false;
+    }
+
+    return CreateView();
+#else
+    VK_ERROR("Texture::CreateOnHost() : host image copy isn't supported by the headers!");
+    return false;
+#endif
+}
+
+bool EvoVulkan::Types::Texture::CreateView() {
     m_view = Tools::CreateImageView(
             *m_device,
             m_image,
             m_format,
             m_mipLevels,
             VK_IMAGE_ASPECT_COLOR_BIT,
-            m_cubeMap);
+            m_cubeMap,
+            m_viewUsage);
     if (m_view == VK_NULL_HANDLE) {
-        VK_ERROR("Texture::Create() : failed to create image view!");
+        VK_ERROR("Texture::CreateView() : failed to create image view!");
         return false;
     }
 
@@ -318,7 +525,7 @@ bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffe
             VK_SAMPLER_ADDRESS_MODE_REPEAT,
             VK_COMPARE_OP_NEVER);
     if (m_sampler == VK_NULL_HANDLE) {
-        VK_ERROR("Texture::Create() : failed to create sampler image!");
+        VK_ERROR("Texture::CreateView() : failed to create sampler image!");
         return false;
     }
 
@@ -334,83 +541,107 @@ bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffe
     return true;
 }
 
+bool EvoVulkan::Types::Texture::IsHostCopyPreferred(
+        Device* device,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t layerCount,
+        uint32_t mipLevels,
+        bool cpuUsage)
+{
+    /// the rest of levels are blitted by a queue anyway
+    if (mipLevels != 1 || !device->IsHostImageCopyEnabled())
+        return false;
+
+    if (!cpuUsage && Tools::GetImageSize(format, width, height) * layerCount > device->GetHostImageCopyLimit())
+        return false;
+
+    return device->IsSupportHostImageCopy(format, cpuUsage ? VK_IMAGE_TILING_LINEAR : VK_IMAGE_TILING_OPTIMAL);
+}
+
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadOnHost(
+        Device* device,
+        Memory::Allocator* allocator,
+        Core::DescriptorManager* manager,
+        CmdPool* pool,
+        const void* const* layers,
+        uint32_t layerCount,
+        VkFormat format,
+        uint32_t width,
+        uint32_t height,
+        VkFilter filter,
+        bool cpuUsage)
+{
+    VK_LOG("Texture::LoadOnHost() : loading new texture by host copy... \n\tWidth: " +
+           std::to_string(width) + "\n\tHeight: " +
+           std::to_string(height) + "\n\tLayers: " + std::to_string(layerCount));
+
+    auto *texture = new Texture();
+    {
+        texture->m_width             = width;
+        texture->m_height            = height;
+        texture->m_mipLevels         = 1;
+        texture->m_format            = format;
+        texture->m_descriptorManager = manager;
+        texture->m_allocator         = allocator;
+        texture->m_device            = device;
+        texture->m_canBeDestroyed    = true;
+        texture->m_pool              = pool;
+        texture->m_filter            = filter;
+        texture->m_cubeMap           = layerCount == 6;
+        texture->m_cpuUsage          = cpuUsage;
+    }
+
+    std::vector<VkBufferImageCopy> regions(layerCount);
+    for (uint32_t layer = 0; layer < layerCount; ++layer) {
+        VkBufferImageCopy& region = regions[layer];
+        region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.baseArrayLayer = layer;
+        region.imageSubresource.layerCount     = 1;
+        region.imageExtent                     = { width, height, 1 };
+    }
+
+    if (!texture->CreateOnHost(layers, regions.data(), layerCount, layerCount)) {
+        VK_ERROR("Texture::LoadOnHost() : failed to create!");
+        texture->Destroy();
+        texture->Free();
+        return nullptr;
+    }
+
+    return texture;
+}
+
 bool EvoVulkan::Types::Texture::GenerateMipmaps(
     EvoVulkan::Types::Texture *texture,
-    EvoVulkan::Types::CmdBuffer *singleBuffer)
+    EvoVulkan::Types::UploadBatch *batch)
 {
-    if (!singleBuffer->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)) {
-        VK_ERROR("Texture::GenerateMipmaps() : failed to begin command buffer!");
+    if (!texture || !batch) {
+        VK_ERROR("Texture::GenerateMipmaps() : texture or batch is nullptr!");
         return false;
     }
 
-    int32_t mipWidth  = texture->m_width;
-    int32_t mipHeight = texture->m_height;
+    const uint32_t layerCount = texture->m_cubeMap ? 6 : 1;
 
-    VkImageSubresourceRange subresourceRange = {
-            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-            .baseMipLevel   = 0, // default
-            .levelCount     = 1,
-            .baseArrayLayer = 0,
-            .layerCount     = 1
-    };
+    if (!CanGenerateMipmaps(batch, texture->m_format, texture->m_width, texture->m_height, texture->m_mipLevels, layerCount)) {
+        VK_ERROR("Texture::GenerateMipmaps() : format doesn't support mip generation!");
+        return false;
+    }
 
-    for (uint32_t i = 1; i < texture->m_mipLevels; i++) {
-        subresourceRange.baseMipLevel = i - 1;
-
-        Tools::Insert::ImageMemoryBarrier(
-                *singleBuffer,
-                texture->m_image,
-                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                subresourceRange);
-
-        {
-            VkImageBlit blit{};
-            blit.srcOffsets[0] = {0, 0, 0};
-            blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
-            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.srcSubresource.mipLevel = i - 1;
-            blit.srcSubresource.baseArrayLayer = 0;
-            blit.srcSubresource.layerCount = 1;
-            blit.dstOffsets[0] = {0, 0, 0};
-            blit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
-            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.dstSubresource.mipLevel = i;
-            blit.dstSubresource.baseArrayLayer = 0;
-            blit.dstSubresource.layerCount = 1;
-
-            vkCmdBlitImage(*singleBuffer,
-                           texture->m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                           texture->m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                           1, &blit,
-                           VK_FILTER_LINEAR);
-        }
+    auto&& generator = batch->GetMipGenerator();
 
-        Tools::Insert::ImageMemoryBarrier(
-                *singleBuffer,
-                texture->m_image,
-                VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
-                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                subresourceRange);
+    const bool recorded = generator && generator->IsSupported(texture->m_format, texture->m_width, texture->m_height, texture->m_mipLevels, layerCount) ?
+            generator->Record(batch, texture->m_image, texture->m_format, texture->m_width, texture->m_height, texture->m_mipLevels, layerCount) :
+            batch->GenerateMipmaps(texture->m_image, texture->m_width, texture->m_height, texture->m_mipLevels, layerCount);
 
-        if (mipWidth > 1)  mipWidth  /= 2;
-        if (mipHeight > 1) mipHeight /= 2;
+    if (!recorded) {
+        VK_ERROR("Texture::GenerateMipmaps() : failed to record mip generation!");
+        return false;
     }
 
-    subresourceRange.baseMipLevel = texture->m_mipLevels - 1;
-    Tools::Insert::ImageMemoryBarrier(
-            *singleBuffer,
-            texture->m_image,
-            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-            subresourceRange);
-
     texture->m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-    return singleBuffer->End();
+    return true;
 }
 
 EvoVulkan::Core::DescriptorSet EvoVulkan::Types::Texture::GetDescriptorSet(VkDescriptorSetLayout layout) {
@@ -0,0 +1,553 @@
+//
+// Created by Monika on 18.10.2026.
+//
+
+#include <EvoVulkan/Types/UploadBatch.h>
+
+#include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Types/VmaBuffer.h>
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/VulkanInsert.h>
+
+EvoVulkan::Types::UploadBatch* EvoVulkan::Types::UploadBatch::Create(
+        EvoVulkan::Types::Device* device,
+        EvoVulkan::Memory::Allocator* allocator,
+        EvoVulkan::Types::CmdPool* pool,
+        EvoVulkan::Types::CmdPool* transferPool)
+{
+    if (!device || !device->IsReady() || !pool || !pool->IsReady()) {
+        VK_ERROR("UploadBatch::Create() : device or command pool isn't ready!");
+        return nullptr;
+    }
+
+    auto* batch = new UploadBatch();
+    {
+        batch->m_device    = device;
+        batch->m_allocator = allocator;
+        batch->m_pool      = pool;
+    }
+
+    /// command buffers are re-recorded by every Begin()
+    batch->m_cmd = CmdBuffer::CreateSimple(device, pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    batch->m_transferCmd = batch->m_cmd;
+
+    if (transferPool && transferPool->GetQueueFamilyIndex() != pool->GetQueueFamilyIndex()) {
+        batch->m_transferPool = transferPool;
+        batch->m_transferCmd  = CmdBuffer::CreateSimple(device, transferPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        auto semaphoreCI = Tools::Initializers::SemaphoreCreateInfo();
+        if (vkCreateSemaphore(*device, &semaphoreCI, nullptr, &batch->m_transferDone) != VK_SUCCESS)
+            batch->m_transferDone = VK_NULL_HANDLE;
+    }
+
+    auto fenceCI = Tools::Initializers::FenceCreateInfo();
+    if (vkCreateFence(*device, &fenceCI, nullptr, &batch->m_fence) != VK_SUCCESS)
+        batch->m_fence = VK_NULL_HANDLE;
+
+    if (!batch->IsReady()) {
+        VK_ERROR("UploadBatch::Create() : failed to create command buffers or synchronization!");
+        batch->Destroy();
+        batch->Free();
+        return nullptr;
+    }
+
+    return batch;
+}
+
+bool EvoVulkan::Types::UploadBatch::Begin() {
+    if (m_recording) {
+        VK_ERROR("UploadBatch::Begin() : batch is already recording!");
+        return false;
+    }
+
+    if (m_submitted && !Wait())
+        return false;
+
+    VkCommandBufferBeginInfo beginInfo = Tools::Initializers::CommandBufferBeginInfo();
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(m_cmd, &beginInfo) != VK_SUCCESS ||
+        (IsTransferQueued() && vkBeginCommandBuffer(m_transferCmd, &beginInfo) != VK_SUCCESS))
+    {
+        VK_ERROR("UploadBatch::Begin() : failed to begin command buffer!");
+        return false;
+    }
+
+    this->m_acquireStages = 0;
+    this->m_countUploads  = 0;
+    this->m_recording     = true;
+
+    return true;
+}
+
+EvoVulkan::Types::UploadBatch::Staging EvoVulkan::Types::UploadBatch::MapStaging(VkDeviceSize size, VkDeviceSize alignment) {
+    /// e.g. Tools::GetImageSize() of an unknown format
+    if (size == 0) {
+        VK_ERROR("UploadBatch::MapStaging() : size is zero!");
+        return Staging();
+    }
+
+    /// copies from the ring are read before the submit of this batch signals its value
+    if (auto&& ring = m_allocator->GetStagingRing()) {
+        if (auto&& staging = ring->Allocate(this, size, alignment); staging.Valid()) {
+            this->m_ringUsed = true;
+            return staging;
+        }
+    }
+
+    auto&& buffer = VmaBuffer::Create(m_allocator, size);
+    if (!buffer) {
+        VK_ERROR("UploadBatch::MapStaging() : failed to create staging buffer!");
+        return Staging();
+    }
+
+    m_staging.emplace_back(buffer);
+
+    /// stays mapped until Submit()
+    return Staging { *buffer, 0, buffer->MapData() };
+}
+
+EvoVulkan::Types::UploadBatch::Staging EvoVulkan::Types::UploadBatch::Stage(const void* data, VkDeviceSize size, VkDeviceSize alignment) {
+    Staging staging = MapStaging(size, alignment);
+    if (staging.Valid())
+        memcpy(staging.m_data, data, size);
+
+    return staging;
+}
+
+EvoVulkan::Types::UploadBatch::DetachedStaging EvoVulkan::Types::UploadBatch::MapDetached(
+        EvoVulkan::Memory::Allocator* allocator,
+        const void* owner,
+        VkDeviceSize size,
+        VkDeviceSize alignment)
+{
+    if (size == 0) {
+        VK_ERROR("UploadBatch::MapDetached() : size is zero!");
+        return DetachedStaging();
+    }
+
+    if (auto&& ring = allocator->GetStagingRing()) {
+        if (auto&& staging = ring->Allocate(owner, size, alignment); staging.Valid())
+            return DetachedStaging { staging, nullptr, owner };
+    }
+
+    auto&& buffer = VmaBuffer::Create(allocator, size);
+    if (!buffer) {
+        VK_ERROR("UploadBatch::MapDetached() : failed to create staging buffer!");
+        return DetachedStaging();
+    }
+
+    return DetachedStaging { Staging { *buffer, 0, buffer->MapData() }, buffer, nullptr };
+}
+
+void EvoVulkan::Types::UploadBatch::ReleaseDetached(EvoVulkan::Memory::Allocator* allocator, DetachedStaging& staging) {
+    if (staging.m_buffer) {
+        staging.m_buffer->Unmap();
+        staging.m_buffer->Destroy();
+        staging.m_buffer->Free();
+    }
+    else if (staging.m_owner)
+        allocator->GetStagingRing()->Cancel(staging.m_owner);
+
+    staging = DetachedStaging();
+}
+
+EvoVulkan::Types::UploadBatch::Staging EvoVulkan::Types::UploadBatch::Adopt(DetachedStaging& staging) {
+    const Staging adopted = staging.m_staging;
+
+    if (!m_recording || !adopted.Valid()) {
+        VK_ERROR("UploadBatch::Adopt() : batch isn't recording or staging is invalid!");
+        ReleaseDetached(m_allocator, staging);
+        return Staging();
+    }
+
+    /// closed and flushed by Submit() together with the memory of the batch
+    if (staging.m_buffer)
+        m_staging.emplace_back(staging.m_buffer);
+    else {
+        m_allocator->GetStagingRing()->Transfer(staging.m_owner, this);
+        this->m_ringUsed = true;
+    }
+
+    staging = DetachedStaging();
+
+    return adopted;
+}
+
+bool EvoVulkan::Types::UploadBatch::CopyToImage(
+        const Staging& staging,
+        VkImage image,
+        const VkBufferImageCopy* regions,
+        uint32_t countRegions,
+        uint32_t mipLevels,
+        uint32_t layerCount)
+{
+    if (!m_recording || !staging.Valid()) {
+        VK_ERROR("UploadBatch::CopyToImage() : batch isn't recording or staging is invalid!");
+        return false;
+    }
+
+    m_regions.assign(regions, regions + countRegions);
+    for (auto&& region : m_regions)
+        region.bufferOffset += staging.m_offset;
+
+    const VkImageSubresourceRange subresourceRange = {
+            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel   = 0,
+            .levelCount     = mipLevels,
+            .baseArrayLayer = 0,
+            .layerCount     = layerCount
+    };
+
+    Tools::Insert::ImageMemoryBarrier(
+            m_transferCmd,
+            image,
+            0, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            subresourceRange);
+
+    vkCmdCopyBufferToImage(m_transferCmd, staging.m_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, countRegions, m_regions.data());
+
+    if (IsTransferQueued()) {
+        const uint32_t srcFamily = m_transferPool->GetQueueFamilyIndex();
+        const uint32_t dstFamily = m_pool->GetQueueFamilyIndex();
+
+        /// release, dst access and stage are ignored by the transfer queue
+        Tools::Insert::ImageOwnershipBarrier(
+                m_transferCmd, image, srcFamily, dstFamily,
+                VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                subresourceRange);
+
+        /// acquire, mip generation reads and writes the levels after it
+        Tools::Insert::ImageOwnershipBarrier(
+                m_cmd, image, srcFamily, dstFamily,
+                0, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                subresourceRange);
+
+        m_acquireStages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+
+    ++m_countUploads;
+
+    return true;
+}
+
+bool EvoVulkan::Types::UploadBatch::UploadImage(
+        VkImage image,
+        VkFormat format,
+        const void* data,
+        VkDeviceSize size,
+        const VkBufferImageCopy* regions,
+        uint32_t countRegions,
+        uint32_t mipLevels,
+        uint32_t layerCount)
+{
+    return CopyToImage(Stage(data, size, Tools::GetStagingAlignment(m_device, format)), image, regions, countRegions, mipLevels, layerCount);
+}
+
+bool EvoVulkan::Types::UploadBatch::UploadBuffer(
+        VkBuffer buffer,
+        const void* data,
+        VkDeviceSize size,
+        VkDeviceSize offset,
+        VkAccessFlags dstAccess,
+        VkPipelineStageFlags dstStage)
+{
+    if (!m_recording) {
+        VK_ERROR("UploadBatch::UploadBuffer() : batch isn't recording!");
+        return false;
+    }
+
+    const Staging staging = Stage(data, size);
+    if (!staging.Valid())
+        return false;
+
+    const VkBufferCopy region = { staging.m_offset, offset, size };
+    vkCmdCopyBuffer(m_transferCmd, staging.m_buffer, buffer, 1, &region);
+
+    if (IsTransferQueued()) {
+        const uint32_t srcFamily = m_transferPool->GetQueueFamilyIndex();
+        const uint32_t dstFamily = m_pool->GetQueueFamilyIndex();
+
+        Tools::Insert::BufferOwnershipBarrier(
+                m_transferCmd, buffer, srcFamily, dstFamily,
+                VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                offset, size);
+
+        Tools::Insert::BufferOwnershipBarrier(
+                m_cmd, buffer, srcFamily, dstFamily,
+                0, dstAccess,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage,
+                offset, size);
+
+        m_acquireStages |= dstStage;
+    }
+    else {
+        Tools::Insert::BufferOwnershipBarrier(
+                m_cmd, buffer, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+                VK_ACCESS_TRANSFER_WRITE_BIT, dstAccess,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                offset, size);
+    }
+
+    ++m_countUploads;
+
+    return true;
+}
+
+bool EvoVulkan::Types::UploadBatch::TransitionImage(
+        VkImage image,
+        VkImageLayout oldLayout,
+        VkImageLayout newLayout,
+        uint32_t mipLevels,
+        uint32_t layerCount)
+{
+    if (!m_recording) {
+        VK_ERROR("UploadBatch::TransitionImage() : batch isn't recording!");
+        return false;
+    }
+
+    return Tools::RecordTransitionImageLayout(m_cmd, image, oldLayout, newLayout, mipLevels, layerCount);
+}
+
+bool EvoVulkan::Types::UploadBatch::GenerateMipmaps(
+        VkImage image,
+        uint32_t width,
+        uint32_t height,
+        uint32_t mipLevels,
+        uint32_t layerCount)
+{
+    if (!m_recording) {
+        VK_ERROR("UploadBatch::GenerateMipmaps() : batch isn't recording!");
+        return false;
+    }
+
+    Tools::RecordGenerateMipmaps(m_cmd, image, static_cast<int32_t>(width), static_cast<int32_t>(height), mipLevels, layerCount);
+
+    return true;
+}
+
+bool EvoVulkan::Types::UploadBatch::Submit(VkSemaphore signalTimeline, uint64_t signalValue) {
+    if (!m_recording) {
+        VK_ERROR("UploadBatch::Submit() : batch isn't recording!");
+        return false;
+    }
+
+    this->m_recording = false;
+
+    /// staging memory is host coherent or flushed here, before the device reads it
+    for (auto&& staging : m_staging) {
+        staging->Flush();
+        staging->Unmap();
+    }
+
+    if (vkEndCommandBuffer(m_cmd) != VK_SUCCESS || (IsTransferQueued() && vkEndCommandBuffer(m_transferCmd) != VK_SUCCESS)) {
+        VK_ERROR("UploadBatch::Submit() : failed to end command buffer!");
+        this->CancelRing();
+        return false;
+    }
+
+    auto&& ring = m_allocator->GetStagingRing();
+
+    const bool ringUsed = m_ringUsed;
+    this->m_ringUsed = false;
+
+    /// staging memory is read only by the copies, so the ring value is signaled by the submit which executes them
+    if (IsTransferQueued()) {
+        auto&& submitTransfer = [&](VkSemaphore ringTimeline, uint64_t ringValue) -> VkResult {
+            const std::array<VkSemaphore, 2> signals = { m_transferDone, ringTimeline };
+            /// value of the binary semaphore is ignored
+            const std::array<uint64_t, 2>    values  = { 0, ringValue };
+
+            VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+            timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.signalSemaphoreValueCount = 2;
+            timelineInfo.pSignalSemaphoreValues    = values.data();
+
+            VkSubmitInfo transferSubmit = Tools::Initializers::SubmitInfo();
+            transferSubmit.pNext                = ringTimeline != VK_NULL_HANDLE ? &timelineInfo : nullptr;
+            transferSubmit.commandBufferCount   = 1;
+            transferSubmit.pCommandBuffers      = &m_transferCmd;
+            transferSubmit.signalSemaphoreCount = ringTimeline != VK_NULL_HANDLE ? 2 : 1;
+            transferSubmit.pSignalSemaphores    = signals.data();
+
+            return vkQueueSubmit(m_device->GetQueues()->GetQueue(m_transferPool->GetQueueFamilyIndex()), 1, &transferSubmit, VK_NULL_HANDLE);
+        };
+
+        /// a failed submit discards the closed allocations of the ring
+        auto result = ringUsed ? ring->Submit(this, submitTransfer) : submitTransfer(VK_NULL_HANDLE, 0);
+        if (result != VK_SUCCESS) {
+            VK_ERROR("UploadBatch::Submit() : failed to submit to the transfer queue! Reason: " +
+                     Tools::Convert::result_to_description(result));
+            return false;
+        }
+    }
+
+    const VkPipelineStageFlags waitStage = m_acquireStages ? m_acquireStages : VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+    auto&& submit = [&](VkSemaphore ringTimeline, uint64_t ringValue) -> VkResult {
+        std::array<VkSemaphore, 2> signals = {};
+        std::array<uint64_t, 2>    values  = {};
+        uint32_t countSignals = 0;
+
+        if (signalTimeline != VK_NULL_HANDLE) {
+            signals[countSignals] = signalTimeline;
+            values[countSignals++] = signalValue;
+        }
+
+        if (ringTimeline != VK_NULL_HANDLE) {
+            signals[countSignals] = ringTimeline;
+            values[countSignals++] = ringValue;
+        }
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+        timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.signalSemaphoreValueCount = countSignals;
+        timelineInfo.pSignalSemaphoreValues    = values.data();
+
+        VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+        submitInfo.pNext                = countSignals > 0 ? &timelineInfo : nullptr;
+        submitInfo.waitSemaphoreCount   = IsTransferQueued() ? 1 : 0;
+        submitInfo.pWaitSemaphores      = &m_transferDone;
+        submitInfo.pWaitDstStageMask    = &waitStage;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &m_cmd;
+        submitInfo.signalSemaphoreCount = countSignals;
+        submitInfo.pSignalSemaphores    = signals.data();
+
+        vkResetFences(*m_device, 1, &m_fence);
+
+        return vkQueueSubmit(m_device->GetQueues()->GetQueue(m_pool->GetQueueFamilyIndex()), 1, &submitInfo, m_fence);
+    };
+
+    auto result = (ringUsed && !IsTransferQueued()) ? ring->Submit(this, submit) : submit(VK_NULL_HANDLE, 0);
+
+    if (result != VK_SUCCESS) {
+        VK_ERROR("UploadBatch::Submit() : failed to queue submit! Reason: " +
+                 Tools::Convert::result_to_description(result));
+
+        /// the copies have been submitted, staging memory and the transfer command buffer are in use until they are completed
+        if (IsTransferQueued())
+            this->AbandonTransfer();
+
+        return false;
+    }
+
+    this->m_submitted = true;
+
+    return true;
+}
+
+void EvoVulkan::Types::UploadBatch::AbandonTransfer() {
+    const VkQueue queue = m_device->GetQueues()->GetQueue(m_transferPool->GetQueueFamilyIndex());
+
+    /// nobody waits for the semaphore, it has to be unsignaled before the next submit of the batch
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores    = &m_transferDone;
+    submitInfo.pWaitDstStageMask  = &waitStage;
+
+    if (vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        VK_ERROR("UploadBatch::AbandonTransfer() : failed to consume transfer semaphore!");
+
+    /// ring allocations are retired by the timeline value of the copies, dedicated buffers are freed after the wait
+    vkQueueWaitIdle(queue);
+}
+
+bool EvoVulkan::Types::UploadBatch::Wait(uint64_t timeout) {
+    if (!m_submitted)
+        return true;
+
+    auto result = vkWaitForFences(*m_device, 1, &m_fence, VK_TRUE, timeout);
+    if (result == VK_TIMEOUT)
+        return false;
+
+    if (result != VK_SUCCESS) {
+        VK_ERROR("UploadBatch::Wait() : failed to wait for fence! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        return false;
+    }
+
+    this->m_submitted = false;
+    this->ReleaseStaging();
+
+    return true;
+}
+
+bool EvoVulkan::Types::UploadBatch::IsComplete() const {
+    return !m_submitted || vkGetFenceStatus(*m_device, m_fence) == VK_SUCCESS;
+}
+
+void EvoVulkan::Types::UploadBatch::CancelRing() {
+    if (m_ringUsed)
+        m_allocator->GetStagingRing()->Cancel(this);
+    this->m_ringUsed = false;
+}
+
+void EvoVulkan::Types::UploadBatch::ReleaseStaging() {
+    for (auto&& staging : m_staging) {
+        staging->Unmap();
+        staging->Destroy();
+        staging->Free();
+    }
+    m_staging.clear();
+
+    for (auto&& release : m_deferred)
+        release();
+    m_deferred.clear();
+}
+
+bool EvoVulkan::Types::UploadBatch::IsReady() const {
+    return m_device && m_cmd != VK_NULL_HANDLE && m_transferCmd != VK_NULL_HANDLE && m_fence != VK_NULL_HANDLE &&
+           (!IsTransferQueued() || m_transferDone != VK_NULL_HANDLE);
+}
+
+void EvoVulkan::Types::UploadBatch::Destroy() {
+    if (!m_device)
+        return;
+
+    /// recorded but not submitted work is dropped
+    if (m_recording) {
+        vkEndCommandBuffer(m_cmd);
+        if (IsTransferQueued())
+            vkEndCommandBuffer(m_transferCmd);
+        m_recording = false;
+        this->CancelRing();
+    }
+
+    this->Wait();
+    this->ReleaseStaging();
+
+    if (IsTransferQueued() && m_transferCmd != VK_NULL_HANDLE)
+        vkFreeCommandBuffers(*m_device, *m_transferPool, 1, &m_transferCmd);
+
+    if (m_cmd != VK_NULL_HANDLE)
+        vkFreeCommandBuffers(*m_device, *m_pool, 1, &m_cmd);
+
+    m_cmd         = VK_NULL_HANDLE;
+    m_transferCmd = VK_NULL_HANDLE;
+
+    if (m_transferDone != VK_NULL_HANDLE) {
+        vkDestroySemaphore(*m_device, m_transferDone, nullptr);
+        m_transferDone = VK_NULL_HANDLE;
+    }
+
+    if (m_fence != VK_NULL_HANDLE) {
+        vkDestroyFence(*m_device, m_fence, nullptr);
+        m_fence = VK_NULL_HANDLE;
+    }
+
+    m_device = nullptr;
+}
+
+void EvoVulkan::Types::UploadBatch::Free() {
+    delete this;
+}
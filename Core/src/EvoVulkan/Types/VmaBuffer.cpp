@@ -78,6 +78,10 @@ VkResult EvoVulkan::Types::VmaBuffer::Flush() {
     return vmaFlushAllocation(*m_allocator, m_buffer.m_allocation, 0, m_size);
 }
 
+VkResult EvoVulkan::Types::VmaBuffer::Invalidate() {
+    return vmaInvalidateAllocation(*m_allocator, m_buffer.m_allocation, 0, m_size);
+}
+
 void EvoVulkan::Types::VmaBuffer::SetupDescriptor(VkDeviceSize offset) {
     m_descriptor.offset = offset;
     m_descriptor.buffer = m_buffer.m_buffer;
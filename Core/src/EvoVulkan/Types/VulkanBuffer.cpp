@@ -8,6 +8,7 @@
 #include <EvoVulkan/Tools/VulkanInitializers.h>
 
 #include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
 
 namespace EvoVulkan::Types {
     /**
@@ -19,30 +20,33 @@ namespace EvoVulkan::Types {
     * @return VkResult of the buffer mapping call
     */
     VkResult Buffer::Map(VkDeviceSize size, VkDeviceSize offset) {
-        return vkMapMemory(*m_device, m_memory, offset, size, 0, &m_mapped);
+        /// host visible memory is mapped by VMA for the whole life of the buffer
+        if (!m_persistent || offset >= m_size)
+            return VK_ERROR_MEMORY_MAP_FAILED;
+
+        m_mapped = m_persistent + offset;
+
+        return VK_SUCCESS;
     }
 
     /**
     * Unmap a mapped memory range
     *
-    * @note Does not return a result as vkUnmapMemory can't fail
+    * @note The memory stays mapped by VMA until the buffer is destroyed
     */
     void Buffer::Unmap() {
-        if (m_mapped) {
-            vkUnmapMemory(*m_device, m_memory);
-            m_mapped = nullptr;
-        }
+        m_mapped = nullptr;
     }
 
     /**
-    * Attach the allocated memory block to the buffer
+    * Check the memory block attached to the buffer
     *
-    * @param offset (Optional) Byte offset (from the beginning) for the memory region to bind
+    * @param offset Unused, VMA binds the allocation on creation
     *
-    * @return VkResult of the bindBufferMemory call
+    * @return VK_SUCCESS if the buffer has memory
     */
     VkResult Buffer::Bind(VkDeviceSize offset) const {
-        return vkBindBufferMemory(*m_device, m_buffer, m_memory, offset);
+        return m_allocation != VK_NULL_HANDLE ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
     }
 
     /**
@@ -70,12 +74,22 @@ namespace EvoVulkan::Types {
         memcpy(m_mapped, data, size);
     }
 
-    void Buffer::CopyToDevice(void *data, VkDeviceSize size) const {
-        vkMapMemory(*m_device, m_memory, 0, size, 0, (void **)&m_mapped);
-        memcpy(m_mapped, data, size);
-        // Unmap after data has been copied
-        // Note: Since we requested a host coherent memory type for the uniform buffer, the write is instantly visible to the GPU
-        vkUnmapMemory(*m_device, m_memory);
+    void Buffer::CopyToDevice(void *data, VkDeviceSize size, VkDeviceSize offset) const {
+        if (!m_persistent) {
+            VK_ERROR("Buffer::CopyToDevice() : memory isn't host visible!");
+            return;
+        }
+
+        if (offset + size > m_size) {
+            VK_ERROR("Buffer::CopyToDevice() : out of range!");
+            return;
+        }
+
+        /// the memory is mapped persistently, there are no map/unmap calls per update
+        memcpy(m_persistent + offset, data, size);
+
+        if (!m_coherent)
+            Flush(size, offset);
     }
 
     /**
@@ -89,12 +103,8 @@ namespace EvoVulkan::Types {
     * @return VkResult of the flush call
     */
     VkResult Buffer::Flush(VkDeviceSize size, VkDeviceSize offset) const {
-        VkMappedMemoryRange mappedRange = {};
-        mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        mappedRange.memory = m_memory;
-        mappedRange.offset = offset;
-        mappedRange.size = size;
-        return vkFlushMappedMemoryRanges(*m_device, 1, &mappedRange);
+        /// offsets are relative to the allocation, VMA aligns them to nonCoherentAtomSize
+        return vmaFlushAllocation(*m_allocator, m_allocation, offset, size);
     }
 
     /**
@@ -108,25 +118,20 @@ namespace EvoVulkan::Types {
     * @return VkResult of the invalidate call
     */
     VkResult Buffer::Invalidate(VkDeviceSize size, VkDeviceSize offset) const {
-        VkMappedMemoryRange mappedRange = {};
-        mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        mappedRange.memory = m_memory;
-        mappedRange.offset = offset;
-        mappedRange.size = size;
-        return vkInvalidateMappedMemoryRanges(*m_device, 1, &mappedRange);
+        return vmaInvalidateAllocation(*m_allocator, m_allocation, offset, size);
     }
 
     /**
     * Release all Vulkan resources held by this buffer
     */
     void Buffer::Destroy() {
-        if (m_buffer)
-            vkDestroyBuffer(*m_device, m_buffer, nullptr);
-
-        m_buffer = VK_NULL_HANDLE;
+        if (m_buffer != VK_NULL_HANDLE)
+            vmaDestroyBuffer(*m_allocator, m_buffer, m_allocation);
 
-        if (m_memory.Ready())
-            m_allocator->FreeMemory(&m_memory);
+        m_buffer     = VK_NULL_HANDLE;
+        m_allocation = VK_NULL_HANDLE;
+        m_persistent = nullptr;
+        m_mapped     = nullptr;
     }
 
     Buffer* Buffer::Create(
@@ -136,67 +141,67 @@ namespace EvoVulkan::Types {
             VkMemoryPropertyFlags memoryPropertyFlags,
             VkDeviceSize size, void* data)
     {
+        /// the memory wouldn't be allocated with VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+        if ((usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) && !device->IsBufferDeviceAddressEnabled()) {
+            VK_ERROR("Buffer::Create() : buffer device address isn't enabled!");
+            return nullptr;
+        }
+
         auto* buffer = new Buffer();
         buffer->m_device = device;
         buffer->m_allocator = allocator;
 
-        // Create the buffer handle
         VkBufferCreateInfo bufferCreateInfo = Tools::Initializers::BufferCreateInfo(usageFlags, size);
-        auto result = vkCreateBuffer(*device, &bufferCreateInfo, nullptr, &buffer->m_buffer);
+
+        // Memory of the properties, small buffers share blocks of a pool instead of a vkAllocateMemory each
+        VmaAllocationCreateInfo allocCreateInfo = {};
+        allocCreateInfo.requiredFlags = memoryPropertyFlags;
+        allocCreateInfo.pool          = allocator->GetSmallBufferPool(bufferCreateInfo, memoryPropertyFlags);
+
+        if (memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+            allocCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo allocInfo = {};
+
+        auto result = vmaCreateBuffer(*allocator, &bufferCreateInfo, &allocCreateInfo, &buffer->m_buffer, &buffer->m_allocation, &allocInfo);
         if (result != VK_SUCCESS) {
-            VK_ERROR("Buffer::Create() : failed to create vulkan buffer!");
-            return {};
+            VK_ERROR("Buffer::Create() : failed to create vulkan buffer! Reason: " +
+                     Tools::Convert::result_to_description(result));
+            buffer->Destroy();
+            buffer->Free();
+            return nullptr;
         }
 
-        // Create the memory backing up the buffer handle
+        VkMemoryPropertyFlags memoryFlags = 0;
+        vmaGetMemoryTypeProperties(*allocator, allocInfo.memoryType, &memoryFlags);
+
         VkMemoryRequirements memReqs;
-        VkMemoryAllocateInfo memAlloc = Tools::Initializers::MemoryAllocateInfo();
         vkGetBufferMemoryRequirements(*device, buffer->m_buffer, &memReqs);
-        memAlloc.allocationSize = memReqs.size;
-        // Find a memory type index that fits the properties of the buffer
-        memAlloc.memoryTypeIndex = device->GetMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags);
-        // If the buffer has VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT set we also need to enable the appropriate flag during allocation
-        VkMemoryAllocateFlagsInfoKHR allocFlagsInfo{};
-        if (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
-            allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
-            allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
-            memAlloc.pNext = &allocFlagsInfo;
-        }
-
-        if (!(buffer->m_memory = allocator->AllocateMemory(memAlloc)).Ready()) {
-            VK_ERROR("Buffer::Create() : failed to allocate vulkan memory!");
-            return { };
-        }
 
+        buffer->m_persistent = static_cast<uint8_t*>(allocInfo.pMappedData);
+        buffer->m_coherent = memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
         buffer->m_alignment = memReqs.alignment;
         buffer->m_size = size;
         buffer->m_usageFlags = usageFlags;
-        buffer->m_memoryPropertyFlags = memoryPropertyFlags;
+        buffer->m_memoryPropertyFlags = memoryFlags;
 
-        // If a pointer to the buffer data has been passed, map the buffer and copy over the data
+        // If a pointer to the buffer data has been passed, copy it into the mapped memory
         if (data != nullptr) {
-            result = buffer->Map();
-            if (result != VK_SUCCESS) {
-                VK_ERROR("Buffer::Create() : failed to map buffer!");
-                return { };
+            if (!buffer->m_persistent) {
+                VK_ERROR("Buffer::Create() : memory isn't host visible!");
+                buffer->Destroy();
+                buffer->Free();
+                return nullptr;
             }
 
-            memcpy(buffer->m_mapped, data, size);
-            if ((memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+            memcpy(buffer->m_persistent, data, size);
+            if (!buffer->m_coherent)
                 buffer->Flush();
-
-            buffer->Unmap();
         }
 
         // Initialize a default descriptor that covers the whole buffer size
         buffer->SetupDescriptor(buffer->m_size);
 
-        if (buffer->Bind() != VK_SUCCESS) {
-            VK_ERROR("Buffer::Create() : failed to bind buffer!");
-            return {};
-        }
-
-        // Attach the memory to the buffer object
         return buffer;
     }
 
@@ -205,8 +210,7 @@ namespace EvoVulkan::Types {
     }
 
     void *Buffer::MapData()  {
-        //void* data = nullptr;
-        if (vkMapMemory(*m_device, m_memory, 0, m_size, 0, &m_mapped) == VK_SUCCESS)
+        if (Map() == VK_SUCCESS)
             return m_mapped;
         else {
             VK_ERROR("Buffer::Map() : failed to map memory!");
@@ -12,6 +12,9 @@
 
 #include "EvoVulkan/VulkanKernel.h"
 #include <EvoVulkan/Complexes/Shader.h>
+#include <EvoVulkan/Types/VmaBuffer.h>
+
+#include <span>
 
 bool EvoVulkan::Core::VulkanKernel::PreInit(
         const std::string& appName,
@@ -35,7 +38,8 @@ bool EvoVulkan::Core::VulkanKernel::PreInit(
     //m_instExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
 #else
     // todo : linux/android
-	m_instExtensions.push_back(VK_KHR_XCB_SURFACE_EXTENSION_NAME);
+    if (!m_headless)
+	    m_instExtensions.push_back(VK_KHR_XCB_SURFACE_EXTENSION_NAME);
 #endif
 
     Tools::VkDebug::Graph("VulkanKernel::PreInit() : create vulkan instance...");
@@ -75,15 +79,21 @@ bool EvoVulkan::Core::VulkanKernel::Init(
 {
     VK_GRAPH("VulkanKernel::Init() : initializing Evo Vulkan kernel...");
 
+    this->m_vsync = vsync;
+
     //const auto extensions = Tools::GetSupportedExtensions();
 
     //!=============================================[Create surface]====================================================
 
-    VK_GRAPH("VulkanKernel::Init() : create vulkan surface...");
-    this->m_surface = Tools::CreateSurface(*m_instance, platformCreate, windowHandle);
-    if (!m_surface) {
-        VK_ERROR("VulkanKernel::Init() : failed create vulkan surface!");
-        return false;
+    if (m_headless)
+        VK_LOG("VulkanKernel::Init() : headless mode, surface will not be created.");
+    else {
+        VK_GRAPH("VulkanKernel::Init() : create vulkan surface...");
+        this->m_surface = Tools::CreateSurface(*m_instance, platformCreate, windowHandle);
+        if (!m_surface) {
+            VK_ERROR("VulkanKernel::Init() : failed create vulkan surface!");
+            return false;
+        }
     }
 
     //!==========================================[Create logical device]================================================
@@ -126,7 +136,7 @@ bool EvoVulkan::Core::VulkanKernel::Init(
 
     //!=============================================[Init surface]======================================================
 
-    if (!m_surface->Init(m_device)) {
+    if (m_surface && !m_surface->Init(m_device)) {
         Tools::VkDebug::Error("VulkanKernel::Init() : failed to create initialize surface!");
         return false;
     }
@@ -147,13 +157,26 @@ bool EvoVulkan::Core::VulkanKernel::Init(
     this->m_width  = m_newWidth;
     this->m_height = m_newHeight;
 
-    this->m_swapchain = Types::Swapchain::Create(
-            *m_instance,
-            m_surface,
-            m_device,
-            vsync,
-            m_width,
-            m_height);
+    if (m_headless) {
+        this->m_swapchain = Types::Swapchain::CreateHeadless(
+                m_device,
+                m_allocator,
+                m_headlessFormat,
+                m_headlessCountImages,
+                m_width,
+                m_height);
+    }
+    else {
+        this->m_swapchain = Types::Swapchain::Create(
+                *m_instance,
+                m_surface,
+                m_device,
+                vsync,
+                m_width,
+                m_height,
+                m_presentMode,
+                m_countSwapchainImages);
+    }
 
     if (!this->m_swapchain) {
         VK_ERROR("VulkanKernel::Init() : failed to create swapchain!");
@@ -198,12 +221,67 @@ bool EvoVulkan::Core::VulkanKernel::PostInit() {
     //!=================================================================================================================
 
     VK_GRAPH("VulkanKernel::PostInit() : create wait fences...");
-    this->m_waitFences = Tools::CreateFences(*m_device, this->m_countDCB);
+    this->m_waitFences = Tools::CreateFences(*m_device, this->m_maxFramesInFlight);
     if (m_waitFences.empty()) {
         VK_ERROR("VulkanKernel::PostInit() : failed to create wait fences!");
         return false;
     }
 
+    this->m_imagesInFlight = std::vector<VkFence>(m_countDCB, VK_NULL_HANDLE);
+
+    VK_GRAPH("VulkanKernel::PostInit() : create frame command pools...");
+    for (uint8_t i = 0; i < m_maxFramesInFlight; ++i) {
+        FrameCmdPool frameCmdPool;
+        if (!(frameCmdPool.m_pool = Types::CmdPool::Create(m_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT))) {
+            VK_ERROR("VulkanKernel::PostInit() : failed to create frame command pool!");
+            return false;
+        }
+        m_frameCmdPools.emplace_back(frameCmdPool);
+    }
+
+    VK_GRAPH("VulkanKernel::PostInit() : create compute command pool...");
+    this->m_computeCmdPool = Types::CmdPool::Create(
+            m_device,
+            VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+            m_device->GetQueues()->GetComputeIndex());
+    if (!m_computeCmdPool) {
+        VK_ERROR("VulkanKernel::PostInit() : failed to create compute command pool!");
+        return false;
+    }
+
+    VK_GRAPH("VulkanKernel::PostInit() : create transfer command pool...");
+    this->m_transferCmdPool = Types::CmdPool::Create(
+            m_device,
+            VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+            m_device->GetQueues()->GetTransferIndex());
+    if (!m_transferCmdPool) {
+        VK_ERROR("VulkanKernel::PostInit() : failed to create transfer command pool!");
+        return false;
+    }
+
+    /// not fatal, upload batches fall back to dedicated staging buffers
+    if (m_stagingRingSize > 0 && !m_allocator->GetStagingRing() && !m_allocator->CreateStagingRing(m_stagingRingSize))
+        VK_WARN("VulkanKernel::PostInit() : failed to create staging ring!");
+
+    VK_GRAPH("VulkanKernel::PostInit() : create frame arenas...");
+    for (uint8_t i = 0; i < m_maxFramesInFlight; ++i) {
+        auto&& arena = Memory::LinearArena::Create(64 * 1024);
+        if (!arena) {
+            VK_ERROR("VulkanKernel::PostInit() : failed to create frame arena!");
+            return false;
+        }
+        m_frameArenas.emplace_back(arena);
+    }
+
+    if (m_uniformRingSize > 0) {
+        VK_GRAPH("VulkanKernel::PostInit() : create uniform ring...");
+        if (!(m_uniformRing = Memory::UniformRing::Create(m_device, m_allocator, m_uniformRingSize, m_maxFramesInFlight))) {
+            VK_ERROR("VulkanKernel::PostInit() : failed to create uniform ring!");
+            return false;
+        }
+        m_uniformRing->BeginFrame(m_currentFrame);
+    }
+
     //!=================================================================================================================
 
     VK_GRAPH("VulkanKernel::PostInit() : create multisample target...");
@@ -232,12 +310,18 @@ bool EvoVulkan::Core::VulkanKernel::PostInit() {
     //!=================================================================================================================
 
     VK_GRAPH("VulkanKernel::PostInit() : create synchronizations...");
-    this->m_syncs = Tools::CreateSynchronization(*m_device);
-    if (!m_syncs.IsReady()) {
-        VK_ERROR("VulkanKernel::PostInit() : failed to create synchronizations!");
-        return false;
+    for (uint8_t i = 0; i < m_maxFramesInFlight; ++i) {
+        auto&& sync = Tools::CreateSynchronization(*m_device);
+        if (!sync.IsReady()) {
+            VK_ERROR("VulkanKernel::PostInit() : failed to create synchronizations!");
+            return false;
+        }
+        m_frameSyncs.emplace_back(sync);
     }
 
+    this->m_currentFrame = 0;
+    this->m_syncs        = m_frameSyncs[m_currentFrame];
+
     // Set up submit info structure
     // Semaphores will stay the same during application lifetime
     // Command buffer submission info is set by each example
@@ -279,6 +363,26 @@ bool EvoVulkan::Core::VulkanKernel::PostInit() {
 bool EvoVulkan::Core::VulkanKernel::Destroy() {
     Tools::VkDebug::Log("VulkanKernel::Destroy() : free Evo Vulkan kernel memory...");
 
+    this->StopRenderThread();
+
+    /// frames in flight can still use the resources
+    if (m_device && m_device->IsReady())
+        vkDeviceWaitIdle(*m_device);
+
+    this->m_deletionQueue.Flush();
+
+    /// completed copies are delivered, the others are failed
+    EVSafeFreeObject(m_readback);
+    m_readbackCmd = VK_NULL_HANDLE;
+
+    for (auto&& semaphore : m_readbackSemaphores)
+        vkDestroySemaphore(*m_device, semaphore, nullptr);
+    m_readbackSemaphores.clear();
+
+    for (auto&& target : m_presentTargets)
+        EVSafeFreeObject(target);
+    m_presentTargets.clear();
+
     if (m_multisample) {
         m_multisample->Destroy();
         m_multisample->Free();
@@ -293,8 +397,26 @@ bool EvoVulkan::Core::VulkanKernel::Destroy() {
     if (m_pipelineCache)
         Tools::DestroyPipelineCache(*m_device, &m_pipelineCache);
 
-    if (m_syncs.IsReady())
-        Tools::DestroySynchronization(*m_device, &m_syncs);
+    if (m_timeline != VK_NULL_HANDLE) {
+        vkDestroySemaphore(*m_device, m_timeline, nullptr);
+        m_timeline = VK_NULL_HANDLE;
+    }
+
+    if (m_computeTimeline != VK_NULL_HANDLE) {
+        vkDestroySemaphore(*m_device, m_computeTimeline, nullptr);
+        m_computeTimeline = VK_NULL_HANDLE;
+    }
+
+    if (m_transferTimeline != VK_NULL_HANDLE) {
+        vkDestroySemaphore(*m_device, m_transferTimeline, nullptr);
+        m_transferTimeline = VK_NULL_HANDLE;
+    }
+
+    for (auto&& sync : m_frameSyncs)
+        if (sync.IsReady())
+            Tools::DestroySynchronization(*m_device, &sync);
+    m_frameSyncs.clear();
+    m_syncs = {};
 
     if (m_renderPass.Ready())
         Types::DestroyRenderPass(m_device, &m_renderPass);
@@ -304,9 +426,27 @@ bool EvoVulkan::Core::VulkanKernel::Destroy() {
         m_waitFences.clear();
     }
 
+    m_imagesInFlight.clear();
+
+    /// command buffers are freed with their pools
+    for (auto&& frameCmdPool : m_frameCmdPools)
+        EVSafeFreeObject(frameCmdPool.m_pool);
+    m_frameCmdPools.clear();
+
+    for (auto&& arena : m_frameArenas)
+        EVSafeFreeObject(arena);
+    m_frameArenas.clear();
+
+    EVSafeFreeObject(m_uniformRing);
+
     if (m_drawCmdBuffs)
         Tools::FreeCommandBuffers(*m_device, *m_cmdPool, &m_drawCmdBuffs, m_countDCB);
 
+    this->DestroyWorkerPools();
+
+    EVSafeFreeObject(m_computeCmdPool);
+    EVSafeFreeObject(m_transferCmdPool);
+
     EVSafeFreeObject(m_swapchain);
     EVSafeFreeObject(m_surface);
     EVSafeFreeObject(m_cmdPool);
@@ -333,11 +473,63 @@ bool EvoVulkan::Core::VulkanKernel::ReCreateFrameBuffers() {
         return false;
     }
 
-    this->m_multisample->ReCreate(m_swapchain->GetSurfaceWidth(), m_swapchain->GetSurfaceHeight());
+    const uint32_t countImages = m_swapchain->GetCountImages();
 
-    for (auto & m_frameBuffer : m_frameBuffers)
-        vkDestroyFramebuffer(*m_device, m_frameBuffer, nullptr);
-    m_frameBuffers.clear();
+    if (m_countDCB != countImages && m_drawCmdBuffs) {
+        VK_LOG("VulkanKernel::ReCreateFrameBuffers() : count images has been changed from " +
+               std::to_string(m_countDCB) + " to " + std::to_string(countImages));
+    }
+
+    /// frames in flight can still execute the old draw command buffers, they are freed when the frames are completed
+    if (m_drawCmdBuffs) {
+        this->DeferredDestroy([device = m_device, pool = m_cmdPool, cmdBuffs = m_drawCmdBuffs, count = m_countDCB]() mutable {
+            Tools::FreeCommandBuffers(*device, *pool, &cmdBuffs, count);
+        });
+        this->m_drawCmdBuffs = nullptr;
+    }
+
+    this->m_countDCB     = countImages;
+    this->m_drawCmdBuffs = Tools::AllocateCommandBuffers(
+            *m_device,
+            Tools::Initializers::CommandBufferAllocateInfo(*m_cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_countDCB));
+
+    if (!m_drawCmdBuffs) {
+        VK_ERROR("VulkanKernel::ReCreateFrameBuffers() : failed to allocate draw command buffers!");
+        this->m_countDCB = 0;
+        return false;
+    }
+
+    /// secondaries are executed by the old draw command buffers, they are replaced the same way
+    if (!m_workerPools.empty()) {
+        this->RetireSecondaryCmdBuffs(m_secondaryCmdBuffs);
+
+        if (!AllocateSecondaryCmdBuffs(m_secondaryCmdBuffs, m_countDCB)) {
+            VK_ERROR("VulkanKernel::ReCreateFrameBuffers() : failed to re-allocate secondary command buffers!");
+            return false;
+        }
+
+        for (auto&& pass : m_recordPasses) {
+            const uint32_t countPassImages = pass.m_target ? pass.m_target->GetCountFrames() : m_countDCB;
+
+            this->RetireSecondaryCmdBuffs(pass.m_cmdBuffs);
+
+            if (!AllocateSecondaryCmdBuffs(pass.m_cmdBuffs, countPassImages)) {
+                VK_ERROR("VulkanKernel::ReCreateFrameBuffers() : failed to re-allocate pass command buffers!");
+                return false;
+            }
+
+            pass.m_dirty.assign(countPassImages, true);
+        }
+    }
+
+    /// the same for framebuffers of the old swapchain views
+    if (!m_frameBuffers.empty()) {
+        this->DeferredDestroy([device = m_device, frameBuffers = std::move(m_frameBuffers)]() {
+            for (auto&& frameBuffer : frameBuffers)
+                vkDestroyFramebuffer(*device, frameBuffer, nullptr);
+        });
+        m_frameBuffers.clear();
+    }
 
     std::vector<VkImageView> attachments = {};
     attachments.resize(m_renderPass.m_countAttachments);
@@ -395,7 +587,21 @@ EvoVulkan::Core::RenderResult EvoVulkan::Core::VulkanKernel::NextFrame() {
     //    viewChanged();
     //}
 
-    return this->Render();
+    /// the thread which renders may be changed by StartRenderThread()
+    Tools::HeapGuard::SetGuarded(true);
+
+    const uint64_t allocations = Tools::HeapGuard::Allocations;
+    const uint64_t frame       = m_frameCounter;
+
+    const RenderResult result = this->Render();
+
+    if (frame >= m_heapGuardFrom && Tools::HeapGuard::Allocations != allocations) {
+        ++m_heapGuardViolations;
+        VK_WARN("VulkanKernel::NextFrame() : steady-state frame has allocated from the heap " +
+            std::to_string(Tools::HeapGuard::Allocations - allocations) + " times!");
+    }
+
+    return result;
 
     //camera.update(frameTimer);
     //if (camera.moving())
@@ -403,14 +609,57 @@ EvoVulkan::Core::RenderResult EvoVulkan::Core::VulkanKernel::NextFrame() {
 }
 
 EvoVulkan::Core::FrameResult EvoVulkan::Core::VulkanKernel::PrepareFrame() {
+    this->PaceFrame();
+
+    /// wait until the gpu has finished the frame which used this slot before
+    vkWaitForFences(*m_device, 1, &m_waitFences[m_currentFrame], VK_TRUE, UINT64_MAX);
+
+    this->m_syncs = m_frameSyncs[m_currentFrame];
+
+    for (auto&& framebuffer : m_queueFramebuffers)
+        framebuffer->SetFrame(m_currentFrame);
+
+    /// the previous frame has been skipped, its copies are reset with the pool
+    if (m_readbackCmd != VK_NULL_HANDLE) {
+        m_readback->Discard(m_frameCounter);
+        m_readbackCmd = VK_NULL_HANDLE;
+    }
+
+    /// command buffers of this slot are completed, reuse them without allocations
+    if (auto&& frameCmdPool = m_frameCmdPools[m_currentFrame]; frameCmdPool.m_used[0] + frameCmdPool.m_used[1] > 0) {
+        frameCmdPool.m_pool->Reset();
+        frameCmdPool.m_used = {};
+    }
+
+    m_frameArenas[m_currentFrame]->Reset();
+
+    if (m_uniformRing)
+        m_uniformRing->BeginFrame(m_currentFrame);
+
+    /// the frame which used this slot before is the newest completed one
+    if (m_frameCounter >= m_maxFramesInFlight) {
+        m_deletionQueue.Collect(m_frameCounter - m_maxFramesInFlight);
+
+        if (m_readback)
+            m_readback->Update(m_frameCounter - m_maxFramesInFlight);
+    }
+
+    /// the window has reported its new size, stop presenting the suboptimal swapchain
+    if (m_swapchainSuboptimal && HasNewSize())
+        return FrameResult::OutOfDate;
+
     // Acquire the next image from the swap chain
     VkResult result = m_swapchain->AcquireNextImage(m_syncs.m_presentComplete, &m_currentBuffer);
-    // Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE) or no longer optimal for presentation (SUBOPTIMAL)
-    if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
+    // Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE)
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
         //windowResize();
         VK_LOG("VulkanKernel::PrepareFrame() : window has been resized!");
+        this->m_swapchainOutOfDate = true;
         return FrameResult::OutOfDate;
     }
+    // The image is acquired and still can be presented if it's no longer optimal for presentation (SUBOPTIMAL)
+    else if (result == VK_SUBOPTIMAL_KHR)
+        this->m_swapchainSuboptimal = true;
     else if (result != VK_SUCCESS) {
         VK_ERROR("VulkanKernel::PrepareFrame() : failed to acquire next image! Reason: " +
             Tools::Convert::result_to_description(result));
@@ -420,93 +669,228 @@ EvoVulkan::Core::FrameResult EvoVulkan::Core::VulkanKernel::PrepareFrame() {
         return FrameResult::Error;
     }
 
+    /// the acquired image may still be in use by an older frame (count images != count frames in flight)
+    if (m_imagesInFlight[m_currentBuffer] != VK_NULL_HANDLE && m_imagesInFlight[m_currentBuffer] != m_waitFences[m_currentFrame])
+        vkWaitForFences(*m_device, 1, &m_imagesInFlight[m_currentBuffer], VK_TRUE, UINT64_MAX);
+
+    m_imagesInFlight[m_currentBuffer] = m_waitFences[m_currentFrame];
+
+    /// additional windows, out of date ones are re-created and the collapsed ones skip the frame
+    for (auto&& target : m_presentTargets) {
+        if (target->IsOutOfDate()) {
+            if (!target->ReSetup(m_frameCounter)) {
+                VK_ERROR("VulkanKernel::PrepareFrame() : failed to re-setup present target!");
+                return FrameResult::Error;
+            }
+
+            if (!target->IsOutOfDate() && !BuildTargetCmdBuffers(target)) {
+                VK_ERROR("VulkanKernel::PrepareFrame() : failed to build present target command buffers!");
+                return FrameResult::Error;
+            }
+
+            this->RestartHeapGuardWarmup();
+        }
+
+        result = target->Acquire(m_currentFrame, m_waitFences[m_currentFrame], m_frameCounter, m_maxFramesInFlight);
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR) {
+            VK_ERROR("VulkanKernel::PrepareFrame() : failed to acquire present target image! Reason: " +
+                Tools::Convert::result_to_description(result));
+            return FrameResult::Error;
+        }
+    }
+
+    vkResetFences(*m_device, 1, &m_waitFences[m_currentFrame]);
+
     return FrameResult::Success;
-    //vkWaitForFences(*m_device, 1, &m_waitFences[m_currentBuffer], VK_TRUE, UINT64_MAX);
-    //vkResetFences(*m_device, 1, &m_waitFences[m_currentBuffer]);
 }
 
 EvoVulkan::Core::FrameResult EvoVulkan::Core::VulkanKernel::SubmitFrame() {
-    VkResult result = m_swapchain->QueuePresent(m_device->GetGraphicsQueue(), m_currentBuffer, m_syncs.m_renderComplete);
+    m_targetSubmits.clear();
+    for (auto&& target : m_presentTargets)
+        if (target->IsAcquired())
+            m_targetSubmits.emplace_back(target->GetSubmitInfo());
+
+    const bool presentTargets = !m_targetSubmits.empty();
+    VkSemaphore renderComplete = m_syncs.m_renderComplete;
+
+    /// copies wait for the rendered frame, the present waits for the copies
+    const VkPipelineStageFlags readbackStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+    if (m_readbackCmd != VK_NULL_HANDLE) {
+        if (vkEndCommandBuffer(m_readbackCmd) == VK_SUCCESS) {
+            VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+            submitInfo.waitSemaphoreCount   = 1;
+            submitInfo.pWaitSemaphores      = &m_syncs.m_renderComplete;
+            submitInfo.pWaitDstStageMask    = &readbackStage;
+            submitInfo.commandBufferCount   = 1;
+            submitInfo.pCommandBuffers      = &m_readbackCmd;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores    = &m_readbackSemaphores[m_currentFrame];
+
+            m_targetSubmits.emplace_back(submitInfo);
+            renderComplete = m_readbackSemaphores[m_currentFrame];
+        }
+        else {
+            VK_ERROR("VulkanKernel::SubmitFrame() : failed to end readback command buffer!");
+            m_readback->Discard(m_frameCounter);
+        }
+    }
+
+    /// additional windows go with the fence submit, the fence will be signaled when all previously submitted work of this frame completes
+    VkResult result = vkQueueSubmit(
+            m_device->GetGraphicsQueue(),
+            static_cast<uint32_t>(m_targetSubmits.size()),
+            m_targetSubmits.data(),
+            m_waitFences[m_currentFrame]);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("VulkanKernel::SubmitFrame() : failed to submit frame fence! Reason: " +
+                 Tools::Convert::result_to_description(result));
+
+        if (result == VK_ERROR_DEVICE_LOST)
+            return FrameResult::DeviceLost;
+
+        return FrameResult::Error;
+    }
+
+    this->m_readbackCmd  = VK_NULL_HANDLE;
+    this->m_currentFrame = (m_currentFrame + 1) % m_maxFramesInFlight;
+    ++m_frameCounter;
+
+    if (!presentTargets)
+        result = m_swapchain->QueuePresent(m_device->GetGraphicsQueue(), m_currentBuffer, renderComplete);
+    else
+        result = this->QueuePresentAll(renderComplete);
+
+    if (m_latchedInputTime != 0) {
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        this->m_inputLatency        = static_cast<double>(now - m_latchedInputTime) / 1e6;
+        this->m_averageInputLatency = m_averageInputLatency == 0.0 ? m_inputLatency : m_averageInputLatency * 0.9 + m_inputLatency * 0.1;
+        this->m_latchedInputTime    = 0;
+    }
+    if (result == VK_SUBOPTIMAL_KHR)
+        this->m_swapchainSuboptimal = true;
+
     if (!((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))) {
         if (result == VK_ERROR_OUT_OF_DATE_KHR) {
             // Swap chain is no longer compatible with the surface and needs to be recreated
             //windowResize();
             VK_LOG("VulkanKernel::SubmitFrame() : window has been resized!");
+            this->m_swapchainOutOfDate = true;
             return FrameResult::OutOfDate;
         } else {
             VK_ERROR("VulkanKernel::SubmitFrame() : failed to queue present! Reason: " +
                      Tools::Convert::result_to_description(result));
 
+            if (result == VK_ERROR_DEVICE_LOST)
+                return FrameResult::DeviceLost;
+
             return FrameResult::Error;
         }
     }
-    result = vkQueueWaitIdle(m_device->GetGraphicsQueue());
-    if (result != VK_SUCCESS) {
-        VK_ERROR("VulkanKernel::SubmitFrame() : failed to queue wait idle! Reason: " +
-                 Tools::Convert::result_to_description(result));
-
-        if (result == VK_ERROR_DEVICE_LOST)
-            return FrameResult::DeviceLost;
-
-        return FrameResult::Error;
-    }
 
     return FrameResult::Success;
 }
 
 bool EvoVulkan::Core::VulkanKernel::ResizeWindow() {
-    VK_LOG("VulkanKernel::ResizeWindow() : waiting for a change in the size of the client window...");
+    if (!m_isPostInitialized) {
+        VK_ERROR("VulkanKernel::ResizeWindow() : kernel is not complete!");
+        return false;
+    }
 
-    // ждем пока управляющая сторона передаст размеры окна, иначе будет рассинхрон
-    while(true) {
+    {
+        /// events may be polled by the thread which renders, so sizes are never waited for
         std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_newWidth != -1 && m_newHeight != -1)
-            break;
-    }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_newWidth == -1 || m_newHeight == -1) {
+            /// the old swapchain is presented until the window reports the new size
+            if (!m_swapchainOutOfDate)
+                return true;
 
-    VK_LOG("VulkanKernel::ResizeWindow() : set new sizes: width = " +
-        std::to_string(m_newWidth) + "; height = " + std::to_string(m_newHeight));
+            /// out of date swapchain can't be presented, the surface knows its size before the window event
+            const VkExtent2D extent = m_swapchain->GetCurrentExtent();
+            if (extent.width == 0 || extent.height == 0) {
+                VK_LOG("VulkanKernel::ResizeWindow() : size of the surface is undefined, waiting for the window...");
+                return true;
+            }
 
-    if (!m_isPostInitialized) {
-        VK_ERROR("VulkanKernel::ResizeWindow() : kernel is not complete!");
-        return false;
-    }
+            this->ApplySize(static_cast<int32_t>(extent.width), static_cast<int32_t>(extent.height));
+        }
 
-    vkDeviceWaitIdle(*m_device);
+        /// collapsed window, the swapchain is re-created when it is expanded
+        if (m_newWidth == 0 || m_newHeight == 0)
+            return true;
 
-    this->m_width  = m_newWidth;
-    this->m_height = m_newHeight;
+        VK_LOG("VulkanKernel::ResizeWindow() : set new sizes: width = " +
+            std::to_string(m_newWidth) + "; height = " + std::to_string(m_newHeight));
+
+        this->m_width  = m_newWidth;
+        this->m_height = m_newHeight;
 
-    m_newWidth = -1;
-    m_newHeight = -1;
+        m_newWidth = -1;
+        m_newHeight = -1;
+    }
 
     if (!m_swapchain->SurfaceIsAvailable())
         return true;
 
+    /// frames in flight aren't waited for, everything they can use is retired to the deletion queue
     if (!m_swapchain->ReSetup(m_width, m_height)) {
         VK_ERROR("VulkanKernel::ResizeWindow() : failed to re-setup swapchain!");
         return false;
     }
 
+    for (auto&& retired : m_swapchain->TakeRetired()) {
+        this->DeferredDestroy([swapchain = m_swapchain, retired = std::move(retired)]() mutable {
+            swapchain->DestroyRetired(retired);
+        });
+    }
+
     //if (!m_depthStencil->ReCreate(m_width, m_height)) {
     //    VK_ERROR("VulkanKernel::ResizeWindow() : failed to re-create depth stencil!");
     //    return false;
    // }
 
+    auto&& multisample = Types::MultisampleTarget::Create(
+            m_device,
+            m_allocator,
+            m_swapchain,
+            m_swapchain->GetSurfaceWidth(),
+            m_swapchain->GetSurfaceHeight(),
+            { this->m_swapchain->GetColorFormat() },
+            m_device->MultisampleEnabled());
+    if (!multisample) {
+        VK_ERROR("VulkanKernel::ResizeWindow() : failed to re-create multisample!");
+        return false;
+    }
+
+    this->DeferredFree(m_multisample);
+    this->m_multisample = multisample;
+
+    this->m_swapchainSuboptimal = false;
+    this->m_swapchainOutOfDate  = false;
+
+    /// images of the new swapchain aren't used by any frame, count images may be changed
+    this->m_imagesInFlight.assign(m_swapchain->GetCountImages(), VK_NULL_HANDLE);
+
     if (!this->ReCreateFrameBuffers()) {
         VK_ERROR("VulkanKernel::ResizeWindow() : failed to re-create frame buffers!");
         return false;
     }
 
+    /// framebuffers have been re-created, cached secondaries refer to the old ones
+    this->MarkAllPassesDirty();
+    this->RestartHeapGuardWarmup();
+
     VK_LOG("VulkanKernel::ResizeWindow() : call custom on-resize function...");
     if (!this->OnResize()) {
         VK_ERROR("VulkanKernel::ResizeWindow() : failed to resize inherited class!");
         return false;
     }
 
-    if (!this->BuildCmdBuffers()) {
+    /// only the passes are re-recorded if the inherited class records with them
+    if (m_recordPasses.empty() ? !this->BuildCmdBuffers() : !this->RecordDirtyPasses(m_passClearValues)) {
         VK_ERROR("VulkanKernel::ResizeWindow() : failed to build command buffer!");
         return false;
     }
@@ -514,25 +898,1317 @@ bool EvoVulkan::Core::VulkanKernel::ResizeWindow() {
     return true;
 }
 
-void EvoVulkan::Core::VulkanKernel::SetMultisampling(const uint32_t &sampleCount) {
-    this->m_multisampling = sampleCount > 1;
-    this->m_sampleCount   = sampleCount;
+bool EvoVulkan::Core::VulkanKernel::SetTimelineFramebuffersQueue(
+        const std::vector<std::pair<Complexes::FrameBuffer*, VkPipelineStageFlags>>& queue,
+        VkPipelineStageFlags swapchainWaitStage)
+{
+    if (!m_device->IsTimelineSemaphoreSupported()) {
+        VK_ERROR("VulkanKernel::SetTimelineFramebuffersQueue() : device isn't support timeline semaphores!");
+        return false;
+    }
+
+    if (m_timeline == VK_NULL_HANDLE) {
+        if ((m_timeline = Tools::CreateTimelineSemaphore(*m_device, m_timelineValue)) == VK_NULL_HANDLE) {
+            VK_ERROR("VulkanKernel::SetTimelineFramebuffersQueue() : failed to create timeline semaphore!");
+            return false;
+        }
+    }
+
+    const uint32_t count = static_cast<uint32_t>(queue.size());
+
+    this->m_countTimelinePasses = count;
+
+    /// offscreen passes use one wait/signal value, the swapchain pass uses two
+    m_timelineSubmits.assign(count + 1, Tools::Initializers::SubmitInfo());
+    m_timelineSubmitInfos.assign(count + 1, VkTimelineSemaphoreSubmitInfo());
+    m_timelineCmdBuffs.assign(count + 1, VK_NULL_HANDLE);
+    m_timelineFramebuffers.assign(count, nullptr);
+    m_timelineWaitStages.assign(count + 2, 0);
+    m_timelineWaitValues.assign(count + 2, 0);
+    m_timelineSignalValues.assign(count + 2, 0);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        m_timelineFramebuffers[i] = queue[i].first;
+        m_timelineWaitStages[i] = queue[i].second;
+
+        auto&& timelineInfo = m_timelineSubmitInfos[i];
+        timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount   = 1;
+        timelineInfo.pWaitSemaphoreValues      = &m_timelineWaitValues[i];
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues    = &m_timelineSignalValues[i];
+
+        auto&& submitInfo = m_timelineSubmits[i];
+        submitInfo.pNext                = &timelineInfo;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &m_timelineCmdBuffs[i];
+        submitInfo.waitSemaphoreCount   = 1;
+        submitInfo.pWaitSemaphores      = &m_timeline;
+        submitInfo.pWaitDstStageMask    = &m_timelineWaitStages[i];
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &m_timeline;
+    }
+
+    m_timelineWaitStages[count]     = swapchainWaitStage;
+    m_timelineWaitStages[count + 1] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+    m_timelineFinalWaits[0]   = m_timeline;
+    m_timelineFinalSignals[0] = m_timeline;
+
+    auto&& timelineInfo = m_timelineSubmitInfos[count];
+    timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount   = 2;
+    timelineInfo.pWaitSemaphoreValues      = &m_timelineWaitValues[count];
+    timelineInfo.signalSemaphoreValueCount = 2;
+    timelineInfo.pSignalSemaphoreValues    = &m_timelineSignalValues[count];
+
+    auto&& submitInfo = m_timelineSubmits[count];
+    submitInfo.pNext                = &timelineInfo;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &m_timelineCmdBuffs[count];
+    submitInfo.waitSemaphoreCount   = 2;
+    submitInfo.pWaitSemaphores      = m_timelineFinalWaits.data();
+    submitInfo.pWaitDstStageMask    = &m_timelineWaitStages[count];
+    submitInfo.signalSemaphoreCount = 2;
+    submitInfo.pSignalSemaphores    = m_timelineFinalSignals.data();
+
+    return true;
 }
 
-void EvoVulkan::Core::VulkanKernel::SetSize(uint32_t width, uint32_t height)  {
-    std::lock_guard<std::mutex> lock(m_mutex);
+void EvoVulkan::Core::VulkanKernel::LateLatch() {
+    /// the newest input which is visible to this frame
+    this->m_latchedInputTime = m_inputSampleTime;
 
-    VK_LOG("VulkanKernel::SetSize() : set new sizes: " + std::to_string(width) + "x" + std::to_string(height));
+    this->OnLateLatch(m_currentFrame);
+}
 
-    this->m_newWidth  = width;
-    this->m_newHeight = height;
+VkResult EvoVulkan::Core::VulkanKernel::SubmitTimelineQueue() {
+    if (m_timelineSubmits.empty()) {
+        VK_ERROR("VulkanKernel::SubmitTimelineQueue() : timeline queue isn't set!");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
 
-    bool oldPause = m_paused;
-    m_paused = m_newHeight == 0 || m_newWidth == 0;
-    if (oldPause != m_paused) {
-        if (m_paused)
-            VK_LOG("VulkanKernel::SetSize() : window has been collapsed!");
-        else
-            VK_LOG("VulkanKernel::SetSize() : window has been expend!");
+    /// the first pass waits for the whole previous frame, because the framebuffers are reused
+    const uint64_t base = m_timelineValue;
+
+    for (uint32_t i = 0; i < m_countTimelinePasses; ++i) {
+        m_timelineWaitValues[i]   = base + i;
+        m_timelineSignalValues[i] = base + i + 1;
+    }
+
+    /// values of binary semaphores are ignored
+    m_timelineWaitValues[m_countTimelinePasses]   = base + m_countTimelinePasses;
+    m_timelineSignalValues[m_countTimelinePasses] = base + m_countTimelinePasses + 1;
+
+    m_timelineFinalWaits[1]   = m_syncs.m_presentComplete;
+    m_timelineFinalSignals[1] = m_syncs.m_renderComplete;
+
+    /// offscreen passes have a command buffer per frame in flight
+    for (uint32_t i = 0; i < m_countTimelinePasses; ++i)
+        m_timelineCmdBuffs[i] = m_timelineFramebuffers[i]->GetCmd(m_currentFrame);
+
+    m_timelineCmdBuffs[m_countTimelinePasses] = m_drawCmdBuffs[m_currentBuffer];
+
+    this->LateLatch();
+
+    auto result = vkQueueSubmit(
+            m_device->GetGraphicsQueue(),
+            static_cast<uint32_t>(m_timelineSubmits.size()),
+            m_timelineSubmits.data(),
+            VK_NULL_HANDLE);
+
+    if (result != VK_SUCCESS) {
+        VK_ERROR("VulkanKernel::SubmitTimelineQueue() : failed to queue submit! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        return result;
+    }
+
+    this->m_timelineValue = base + m_countTimelinePasses + 1;
+
+    return result;
+}
+
+uint64_t EvoVulkan::Core::VulkanKernel::SubmitCompute(
+        const VkCommandBuffer* cmdBuffs,
+        uint32_t count,
+        uint64_t waitTimelineValue,
+        VkPipelineStageFlags waitStage)
+{
+    if (!m_device->IsTimelineSemaphoreSupported()) {
+        VK_ERROR("VulkanKernel::SubmitCompute() : device isn't support timeline semaphores!");
+        return 0;
+    }
+
+    if (m_computeTimeline == VK_NULL_HANDLE) {
+        if ((m_computeTimeline = Tools::CreateTimelineSemaphore(*m_device, m_computeValue)) == VK_NULL_HANDLE) {
+            VK_ERROR("VulkanKernel::SubmitCompute() : failed to create timeline semaphore!");
+            return 0;
+        }
+    }
+
+    if (waitTimelineValue > 0 && m_timeline == VK_NULL_HANDLE) {
+        VK_ERROR("VulkanKernel::SubmitCompute() : framebuffers timeline isn't set!");
+        return 0;
+    }
+
+    const uint64_t signalValue = m_computeValue + 1;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount   = waitTimelineValue > 0 ? 1 : 0;
+    timelineInfo.pWaitSemaphoreValues      = &waitTimelineValue;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues    = &signalValue;
+
+    VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+    submitInfo.pNext                = &timelineInfo;
+    submitInfo.waitSemaphoreCount   = timelineInfo.waitSemaphoreValueCount;
+    submitInfo.pWaitSemaphores      = &m_timeline;
+    submitInfo.pWaitDstStageMask    = &waitStage;
+    submitInfo.commandBufferCount   = count;
+    submitInfo.pCommandBuffers      = cmdBuffs;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &m_computeTimeline;
+
+    auto result = vkQueueSubmit(m_device->GetComputeQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("VulkanKernel::SubmitCompute() : failed to queue submit! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        return 0;
     }
+
+    return this->m_computeValue = signalValue;
+}
+
+VkResult EvoVulkan::Core::VulkanKernel::SubmitAfterCompute(
+        const VkSubmitInfo& submitInfo,
+        uint64_t computeValue,
+        VkPipelineStageFlags stage,
+        VkFence fence)
+{
+    return SubmitAfterTimeline(submitInfo, m_computeTimeline, computeValue, stage, fence, m_computeWaits);
+}
+
+VkResult EvoVulkan::Core::VulkanKernel::SubmitAfterTimeline(
+        const VkSubmitInfo& submitInfo,
+        VkSemaphore timeline,
+        uint64_t value,
+        VkPipelineStageFlags stage,
+        VkFence fence,
+        TimelineWaits& scratch)
+{
+    if (timeline == VK_NULL_HANDLE || value == 0)
+        return vkQueueSubmit(m_device->GetGraphicsQueue(), 1, &submitInfo, fence);
+
+    scratch.m_semaphores.assign(submitInfo.pWaitSemaphores, submitInfo.pWaitSemaphores + submitInfo.waitSemaphoreCount);
+    scratch.m_stages.assign(submitInfo.pWaitDstStageMask, submitInfo.pWaitDstStageMask + submitInfo.waitSemaphoreCount);
+    /// values of binary semaphores are ignored
+    scratch.m_values.assign(submitInfo.waitSemaphoreCount, 0);
+
+    scratch.m_semaphores.emplace_back(timeline);
+    scratch.m_stages.emplace_back(stage);
+    scratch.m_values.emplace_back(value);
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType                   = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(scratch.m_values.size());
+    timelineInfo.pWaitSemaphoreValues    = scratch.m_values.data();
+
+    VkSubmitInfo timelineSubmitInfo = submitInfo;
+    timelineSubmitInfo.pNext              = &timelineInfo;
+    timelineSubmitInfo.waitSemaphoreCount = static_cast<uint32_t>(scratch.m_semaphores.size());
+    timelineSubmitInfo.pWaitSemaphores    = scratch.m_semaphores.data();
+    timelineSubmitInfo.pWaitDstStageMask  = scratch.m_stages.data();
+
+    return vkQueueSubmit(m_device->GetGraphicsQueue(), 1, &timelineSubmitInfo, fence);
+}
+
+bool EvoVulkan::Core::VulkanKernel::IsComputeComplete(uint64_t computeValue) const {
+    if (m_computeTimeline == VK_NULL_HANDLE)
+        return true;
+
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue(*m_device, m_computeTimeline, &value);
+
+    return value >= computeValue;
+}
+
+bool EvoVulkan::Core::VulkanKernel::WaitCompute(uint64_t computeValue, uint64_t timeout) const {
+    if (m_computeTimeline == VK_NULL_HANDLE)
+        return true;
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &m_computeTimeline;
+    waitInfo.pValues        = &computeValue;
+
+    return vkWaitSemaphores(*m_device, &waitInfo, timeout) == VK_SUCCESS;
+}
+
+uint64_t EvoVulkan::Core::VulkanKernel::SubmitTransfer(const VkCommandBuffer* cmdBuffs, uint32_t count) {
+    if (!m_device->IsTimelineSemaphoreSupported()) {
+        VK_ERROR("VulkanKernel::SubmitTransfer() : device isn't support timeline semaphores!");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_transferMutex);
+
+    if (m_transferTimeline == VK_NULL_HANDLE) {
+        if ((m_transferTimeline = Tools::CreateTimelineSemaphore(*m_device, m_transferValue)) == VK_NULL_HANDLE) {
+            VK_ERROR("VulkanKernel::SubmitTransfer() : failed to create timeline semaphore!");
+            return 0;
+        }
+    }
+
+    const uint64_t signalValue = m_transferValue + 1;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues    = &signalValue;
+
+    VkSubmitInfo submitInfo = Tools::Initializers::SubmitInfo();
+    submitInfo.pNext                = &timelineInfo;
+    submitInfo.commandBufferCount   = count;
+    submitInfo.pCommandBuffers      = cmdBuffs;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &m_transferTimeline;
+
+    auto result = vkQueueSubmit(m_device->GetTransferQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("VulkanKernel::SubmitTransfer() : failed to queue submit! Reason: " +
+                 Tools::Convert::result_to_description(result));
+        return 0;
+    }
+
+    return this->m_transferValue = signalValue;
+}
+
+VkResult EvoVulkan::Core::VulkanKernel::SubmitAfterTransfer(
+        const VkSubmitInfo& submitInfo,
+        uint64_t transferValue,
+        VkPipelineStageFlags stage,
+        VkFence fence)
+{
+    return SubmitAfterTimeline(submitInfo, m_transferTimeline, transferValue, stage, fence, m_transferWaits);
+}
+
+bool EvoVulkan::Core::VulkanKernel::IsTransferComplete(uint64_t transferValue) const {
+    if (m_transferTimeline == VK_NULL_HANDLE)
+        return true;
+
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue(*m_device, m_transferTimeline, &value);
+
+    return value >= transferValue;
+}
+
+bool EvoVulkan::Core::VulkanKernel::WaitTransfer(uint64_t transferValue, uint64_t timeout) const {
+    if (m_transferTimeline == VK_NULL_HANDLE)
+        return true;
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &m_transferTimeline;
+    waitInfo.pValues        = &transferValue;
+
+    return vkWaitSemaphores(*m_device, &waitInfo, timeout) == VK_SUCCESS;
+}
+
+void EvoVulkan::Core::VulkanKernel::PaceFrame() {
+    if (m_minFrameTime.count() > 0) {
+        const auto now = std::chrono::steady_clock::now();
+
+        if (m_nextFrameTime > now) {
+            /// the scheduler wakes up too late, sleep only the coarse part and spin the rest
+            constexpr auto spinTime = std::chrono::microseconds(1500);
+            if (m_nextFrameTime - now > spinTime)
+                std::this_thread::sleep_for(m_nextFrameTime - now - spinTime);
+
+            while (std::chrono::steady_clock::now() < m_nextFrameTime)
+                std::this_thread::yield();
+        }
+
+        /// don't accumulate debt after long frames
+        m_nextFrameTime = std::max(m_nextFrameTime + m_minFrameTime, std::chrono::steady_clock::now());
+    }
+
+    /// the next present will be the (last + 1), there must not be more than max latency in the queue
+    if (m_maxFrameLatency > 0 && m_swapchain->IsPresentWaitEnabled()) {
+        const uint64_t lastPresentId = m_swapchain->GetLastPresentId();
+        if (lastPresentId >= m_maxFrameLatency)
+            m_swapchain->WaitForPresent(lastPresentId + 1 - m_maxFrameLatency);
+    }
+}
+
+VkResult EvoVulkan::Core::VulkanKernel::QueuePresentAll(VkSemaphore renderComplete) {
+    m_presentSwapchains.clear();
+    m_presentIndices.clear();
+    m_presentWaits.clear();
+    m_presentIds.clear();
+
+    m_presentSwapchains.emplace_back(*m_swapchain);
+    m_presentIndices.emplace_back(m_currentBuffer);
+    m_presentWaits.emplace_back(renderComplete);
+    m_presentIds.emplace_back(m_swapchain->NextPresentId());
+
+    for (auto&& target : m_presentTargets) {
+        if (!target->IsAcquired())
+            continue;
+
+        m_presentSwapchains.emplace_back(*target->GetSwapchain());
+        m_presentIndices.emplace_back(target->GetCurrentBuffer());
+        m_presentWaits.emplace_back(target->GetRenderComplete());
+        /// frame latency is limited only by the main window
+        m_presentIds.emplace_back(0);
+    }
+
+    m_presentResults.assign(m_presentSwapchains.size(), VK_SUCCESS);
+
+    VkPresentInfoKHR presentInfo   = {};
+    presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = static_cast<uint32_t>(m_presentWaits.size());
+    presentInfo.pWaitSemaphores    = m_presentWaits.data();
+    presentInfo.swapchainCount     = static_cast<uint32_t>(m_presentSwapchains.size());
+    presentInfo.pSwapchains        = m_presentSwapchains.data();
+    presentInfo.pImageIndices      = m_presentIndices.data();
+    presentInfo.pResults           = m_presentResults.data();
+
+#ifdef VK_KHR_present_id
+    VkPresentIdKHR presentIdInfo = {};
+    presentIdInfo.sType          = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+    presentIdInfo.swapchainCount = presentInfo.swapchainCount;
+    presentIdInfo.pPresentIds    = m_presentIds.data();
+
+    if (m_presentIds[0] != 0)
+        presentInfo.pNext = &presentIdInfo;
+#endif
+
+    const VkResult result = vkQueuePresentKHR(m_device->GetGraphicsQueue(), &presentInfo);
+
+    uint32_t index = 1;
+    for (auto&& target : m_presentTargets)
+        if (target->IsAcquired())
+            target->MarkPresented(m_presentResults[index++]);
+
+    /// out of date additional windows don't affect the main one
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR)
+        return result;
+
+    return m_presentResults[0];
+}
+
+EvoVulkan::Complexes::PresentTarget* EvoVulkan::Core::VulkanKernel::AddPresentTarget(
+        const std::function<VkSurfaceKHR(const VkInstance&)>& platformCreate,
+        void* windowHandle,
+        uint32_t width,
+        uint32_t height)
+{
+    if (!m_isPostInitialized || m_headless) {
+        VK_ERROR("VulkanKernel::AddPresentTarget() : kernel must be post-initialized and not headless!");
+        return nullptr;
+    }
+
+    auto&& surface = Tools::CreateSurface(*m_instance, platformCreate, windowHandle);
+    if (!surface || !surface->Init(m_device)) {
+        VK_ERROR("VulkanKernel::AddPresentTarget() : failed to create surface!");
+        EVSafeFreeObject(surface);
+        return nullptr;
+    }
+
+    auto&& target = Complexes::PresentTarget::Create(
+            *m_instance,
+            m_device,
+            m_allocator,
+            m_cmdPool,
+            surface,
+            m_renderPass,
+            m_swapchain->GetColorFormat(),
+            m_multisampling,
+            m_vsync,
+            m_presentMode,
+            m_countSwapchainImages,
+            m_maxFramesInFlight,
+            width,
+            height);
+
+    if (!target) {
+        VK_ERROR("VulkanKernel::AddPresentTarget() : failed to create present target!");
+        return nullptr;
+    }
+
+    if (!BuildTargetCmdBuffers(target)) {
+        VK_ERROR("VulkanKernel::AddPresentTarget() : failed to build command buffers!");
+        EVSafeFreeObject(target);
+        return nullptr;
+    }
+
+    m_presentTargets.emplace_back(target);
+
+    /// the frame loop doesn't reallocate them
+    const size_t countSwapchains = m_presentTargets.size() + 1;
+    m_targetSubmits.reserve(countSwapchains);
+    m_presentSwapchains.reserve(countSwapchains);
+    m_presentIndices.reserve(countSwapchains);
+    m_presentWaits.reserve(countSwapchains);
+    m_presentResults.reserve(countSwapchains);
+    m_presentIds.reserve(countSwapchains);
+
+    return target;
+}
+
+void EvoVulkan::Core::VulkanKernel::RemovePresentTarget(Complexes::PresentTarget* target) {
+    auto&& it = std::find(m_presentTargets.begin(), m_presentTargets.end(), target);
+    if (it == m_presentTargets.end()) {
+        VK_ERROR("VulkanKernel::RemovePresentTarget() : target not found!");
+        return;
+    }
+
+    m_presentTargets.erase(it);
+
+    this->DeferredFree(target);
+}
+
+void EvoVulkan::Core::VulkanKernel::SetHeapGuard(bool enabled, uint32_t warmupFrames) {
+    this->m_heapGuardWarmup = warmupFrames;
+    this->m_heapGuardFrom   = enabled ? m_frameCounter + warmupFrames : UINT64_MAX;
+}
+
+void EvoVulkan::Core::VulkanKernel::RestartHeapGuardWarmup() {
+    if (m_heapGuardFrom != UINT64_MAX)
+        this->m_heapGuardFrom = m_frameCounter + m_heapGuardWarmup;
+}
+
+void EvoVulkan::Core::VulkanKernel::SetPresentMode(VkPresentModeKHR presentMode) {
+    this->m_presentMode = presentMode;
+
+    if (m_swapchain)
+        m_swapchain->SetPresentMode(presentMode);
+}
+
+void EvoVulkan::Core::VulkanKernel::SetSwapchainImages(uint32_t countImages) {
+    this->m_countSwapchainImages = countImages;
+
+    if (m_swapchain)
+        m_swapchain->SetCountImages(countImages);
+}
+
+void EvoVulkan::Core::VulkanKernel::SetFrameRateLimit(double fps) {
+    if (fps <= 0.0)
+        this->m_minFrameTime = std::chrono::nanoseconds(0);
+    else
+        this->m_minFrameTime = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / fps));
+
+    this->m_nextFrameTime = std::chrono::steady_clock::now();
+}
+
+void EvoVulkan::Core::VulkanKernel::SetMultisampling(const uint32_t &sampleCount) {
+    this->m_multisampling = sampleCount > 1;
+    this->m_sampleCount   = sampleCount;
+}
+
+void EvoVulkan::Core::VulkanKernel::SetSize(uint32_t width, uint32_t height)  {
+    VK_LOG("VulkanKernel::SetSize() : set new sizes: " + std::to_string(width) + "x" + std::to_string(height));
+
+    /// the render thread owns the sizes, resize must not be lost
+    if (IsRenderThreadActive()) {
+        FramePacket packet;
+        packet.m_width   = static_cast<int32_t>(width);
+        packet.m_height  = static_cast<int32_t>(height);
+        packet.m_present = false;
+
+        /// the queue is full only while the render thread is behind, it frees a slot with the next frame
+        bool pushed = false;
+        while (!(pushed = PushFramePacket(std::move(packet))) && IsRenderThreadActive())
+            WaitFramePacketSlot(std::chrono::milliseconds(100));
+
+        /// otherwise the render thread has been finished, the size is applied here
+        if (pushed)
+            return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    this->ApplySize(static_cast<int32_t>(width), static_cast<int32_t>(height));
+}
+
+bool EvoVulkan::Core::VulkanKernel::HasNewSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_newWidth != -1 && m_newHeight != -1;
+}
+
+void EvoVulkan::Core::VulkanKernel::ApplySize(int32_t width, int32_t height) {
+    this->m_newWidth  = width;
+    this->m_newHeight = height;
+
+    bool oldPause = m_paused;
+    m_paused = m_newHeight == 0 || m_newWidth == 0;
+    if (oldPause != m_paused) {
+        if (m_paused)
+            VK_LOG("VulkanKernel::SetSize() : window has been collapsed!");
+        else
+            VK_LOG("VulkanKernel::SetSize() : window has been expend!");
+    }
+}
+
+bool EvoVulkan::Core::VulkanKernel::StartRenderThread() {
+    if (!m_isPostInitialized) {
+        VK_ERROR("VulkanKernel::StartRenderThread() : kernel is not complete!");
+        return false;
+    }
+
+    /// a thread finished by errors is still joined by StopRenderThread()
+    if (IsRenderThreadActive() || m_renderThread.joinable()) {
+        VK_ERROR("VulkanKernel::StartRenderThread() : render thread is already running!");
+        return false;
+    }
+
+    VK_LOG("VulkanKernel::StartRenderThread() : start render thread...");
+
+    this->m_renderThreadActive = true;
+    this->m_renderThread = std::thread(&VulkanKernel::RenderThreadLoop, this);
+
+    return true;
+}
+
+void EvoVulkan::Core::VulkanKernel::StopRenderThread() {
+    if (!m_renderThread.joinable())
+        return;
+
+    VK_LOG("VulkanKernel::StopRenderThread() : stop render thread...");
+
+    this->m_renderThreadActive = false;
+
+    /// wake up the render thread if it waits for packets, a full queue doesn't let it wait
+    FramePacket packet;
+    packet.m_present = false;
+    m_framePackets.Push(std::move(packet));
+
+    m_renderThread.join();
+
+    /// packets pushed after the last frame will never be rendered
+    while (m_framePackets.Pop(packet))
+        ApplyFramePacket(packet, false);
+}
+
+bool EvoVulkan::Core::VulkanKernel::PushFramePacket(FramePacket&& packet) {
+    return m_framePackets.Push(std::move(packet));
+}
+
+bool EvoVulkan::Core::VulkanKernel::WaitFramePacketSlot(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_packetMutex);
+
+    return m_packetSlotFreed.wait_for(lock, timeout, [this]() {
+        return !IsRenderThreadActive() || !m_framePackets.Full();
+    }) && IsRenderThreadActive();
+}
+
+void EvoVulkan::Core::VulkanKernel::ApplyFramePacket(FramePacket& packet, bool present) {
+    if (packet.m_width != -1 && packet.m_height != -1)
+        this->ApplySize(packet.m_width, packet.m_height);
+
+    if (packet.m_update)
+        packet.m_update();
+
+    if (present && packet.m_present)
+        this->NextFrame();
+
+    packet = FramePacket();
+}
+
+void EvoVulkan::Core::VulkanKernel::RenderThreadLoop() {
+    FramePacket packet;
+
+    while (IsRenderThreadActive() && !m_hasErrors) {
+        m_framePackets.Wait();
+
+        if (m_framePackets.Pop(packet)) {
+            /// the producer checks the queue under the mutex, so the notification isn't lost
+            { std::lock_guard<std::mutex> lock(m_packetMutex); }
+            m_packetSlotFreed.notify_one();
+
+            ApplyFramePacket(packet, true);
+        }
+    }
+
+    /// the producer mustn't wait for a thread which doesn't take packets anymore
+    {
+        std::lock_guard<std::mutex> lock(m_packetMutex);
+        this->m_renderThreadActive = false;
+    }
+    m_packetSlotFreed.notify_all();
+
+    VK_LOG("VulkanKernel::RenderThreadLoop() : render thread has been finished.");
+}
+
+bool EvoVulkan::Core::VulkanKernel::ReadPixels(uint32_t imageIndex, std::vector<uint8_t>& pixels) {
+    if (!m_swapchain || !m_swapchain->IsHeadless()) {
+        VK_ERROR("VulkanKernel::ReadPixels() : read pixels is supported only in headless mode!");
+        return false;
+    }
+
+    if (imageIndex >= m_swapchain->GetCountImages()) {
+        VK_ERROR("VulkanKernel::ReadPixels() : incorrect image index!");
+        return false;
+    }
+
+    /// images are created in the undefined layout, only the render pass leaves them in the transfer source one
+    if (m_imagesInFlight[imageIndex] == VK_NULL_HANDLE) {
+        VK_ERROR("VulkanKernel::ReadPixels() : image hasn't been rendered yet!");
+        return false;
+    }
+
+    vkWaitForFences(*m_device, 1, &m_imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+
+    const uint32_t width  = m_swapchain->GetSurfaceWidth();
+    const uint32_t height = m_swapchain->GetSurfaceHeight();
+    /// any color format may be set by SetHeadless(), the copy writes texels of its size
+    const VkDeviceSize size = Tools::GetImageSize(m_swapchain->GetColorFormat(), width, height);
+    if (size == 0) {
+        VK_ERROR("VulkanKernel::ReadPixels() : unsupported format " + std::to_string(m_swapchain->GetColorFormat()) + "!");
+        return false;
+    }
+
+    auto&& readback = Types::VmaBuffer::Create(m_allocator, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU, size);
+    if (!readback) {
+        VK_ERROR("VulkanKernel::ReadPixels() : failed to create readback buffer!");
+        return false;
+    }
+
+    auto&& copyCmd = Types::CmdBuffer::BeginSingleTime(m_device, m_cmdPool);
+
+    /// the render pass leaves swapchain image in the transfer source layout
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent                 = { width, height, 1 };
+
+    vkCmdCopyImageToBuffer(*copyCmd, m_swapchain->GetBuffers()[imageIndex].m_image,
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, *readback, 1, &region);
+
+    const bool result = copyCmd->End();
+
+    copyCmd->Destroy();
+    copyCmd->Free();
+
+    if (result) {
+        readback->Invalidate();
+
+        if (auto&& data = readback->MapData()) {
+            pixels.resize(size);
+            memcpy(pixels.data(), data, size);
+            readback->Unmap();
+        }
+        else
+            pixels.clear();
+    }
+
+    readback->Destroy();
+    readback->Free();
+
+    return result && !pixels.empty();
+}
+
+bool EvoVulkan::Core::VulkanKernel::BeginReadback() {
+    if (!m_isPostInitialized) {
+        VK_ERROR("VulkanKernel::BeginReadback() : kernel is not complete!");
+        return false;
+    }
+
+    if (m_readbackSemaphores.empty()) {
+        const VkSemaphoreCreateInfo semaphoreCI = Tools::Initializers::SemaphoreCreateInfo();
+
+        for (uint8_t i = 0; i < m_maxFramesInFlight; ++i) {
+            VkSemaphore semaphore = VK_NULL_HANDLE;
+            if (vkCreateSemaphore(*m_device, &semaphoreCI, nullptr, &semaphore) != VK_SUCCESS) {
+                VK_ERROR("VulkanKernel::BeginReadback() : failed to create readback semaphore!");
+
+                for (auto&& created : m_readbackSemaphores)
+                    vkDestroySemaphore(*m_device, created, nullptr);
+                m_readbackSemaphores.clear();
+
+                return false;
+            }
+
+            m_readbackSemaphores.emplace_back(semaphore);
+        }
+    }
+
+    if (!m_readback && !(m_readback = Complexes::Readback::Create(m_device, m_allocator))) {
+        VK_ERROR("VulkanKernel::BeginReadback() : failed to create readback!");
+        return false;
+    }
+
+    if (m_readbackCmd != VK_NULL_HANDLE)
+        return true;
+
+    if ((m_readbackCmd = AllocateFrameCmdBuffer()) == VK_NULL_HANDLE)
+        return false;
+
+    VkCommandBufferBeginInfo beginInfo = Tools::Initializers::CommandBufferBeginInfo();
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(m_readbackCmd, &beginInfo) != VK_SUCCESS) {
+        VK_ERROR("VulkanKernel::BeginReadback() : failed to begin readback command buffer!");
+        m_readbackCmd = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+bool EvoVulkan::Core::VulkanKernel::ReadbackImage(const Complexes::ReadbackRequest& request, Complexes::ReadbackCallback&& callback) {
+    if (!BeginReadback())
+        return false;
+
+    return m_readback->Record(m_readbackCmd, m_frameCounter, request, std::move(callback));
+}
+
+std::future<EvoVulkan::Complexes::ReadbackResult> EvoVulkan::Core::VulkanKernel::ReadbackImage(const Complexes::ReadbackRequest& request) {
+    if (!BeginReadback()) {
+        std::promise<Complexes::ReadbackResult> promise;
+        promise.set_value(Complexes::ReadbackResult());
+        return promise.get_future();
+    }
+
+    return m_readback->Record(m_readbackCmd, m_frameCounter, request);
+}
+
+EvoVulkan::Complexes::ReadbackRequest EvoVulkan::Core::VulkanKernel::GetSwapchainReadback() const {
+    /// the surface doesn't support copies from its images
+    if (!(m_swapchain->GetImageUsage() & VK_IMAGE_USAGE_TRANSFER_SRC_BIT))
+        return Complexes::ReadbackRequest();
+
+    Complexes::ReadbackRequest request;
+    {
+        request.m_image   = m_swapchain->GetBuffers()[m_currentBuffer].m_image;
+        request.m_format  = m_swapchain->GetColorFormat();
+        request.m_width   = m_swapchain->GetSurfaceWidth();
+        request.m_height  = m_swapchain->GetSurfaceHeight();
+        request.m_layout  = m_swapchain->GetPresentLayout();
+        request.m_convert = Complexes::ConvertBGRAToRGBA;
+    }
+
+    return request;
+}
+
+VkCommandBuffer EvoVulkan::Core::VulkanKernel::AllocateFrameCmdBuffer(VkCommandBufferLevel level) {
+    auto&& frameCmdPool = m_frameCmdPools[m_currentFrame];
+
+    auto&& cmdBuffs = frameCmdPool.m_cmdBuffs[level];
+    auto&& used     = frameCmdPool.m_used[level];
+
+    if (used == cmdBuffs.size()) {
+        VkCommandBuffer cmdBuffer = Types::CmdBuffer::CreateSimple(m_device, frameCmdPool.m_pool, level);
+        if (cmdBuffer == VK_NULL_HANDLE) {
+            VK_ERROR("VulkanKernel::AllocateFrameCmdBuffer() : failed to allocate frame command buffer!");
+            return VK_NULL_HANDLE;
+        }
+
+        cmdBuffs.emplace_back(cmdBuffer);
+    }
+
+    return cmdBuffs[used++];
+}
+
+bool EvoVulkan::Core::VulkanKernel::SetRecordingThreads(uint32_t countThreads) {
+    if (!m_isPostInitialized) {
+        VK_ERROR("VulkanKernel::SetRecordingThreads() : kernel is not complete!");
+        return false;
+    }
+
+    if (countThreads == 0)
+        countThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    VK_LOG("VulkanKernel::SetRecordingThreads() : set " + std::to_string(countThreads) + " recording threads...");
+
+    /// secondary buffers of the old pools can be executed by frames in flight, the pools are destroyed after them
+    this->DestroyWorkerPools(true);
+
+    for (uint32_t i = 0; i < countThreads; ++i) {
+        auto&& pool = Types::CmdPool::Create(m_device);
+        if (!pool) {
+            VK_ERROR("VulkanKernel::SetRecordingThreads() : failed to create worker command pool!");
+            this->DestroyWorkerPools();
+            return false;
+        }
+
+        m_workerPools.emplace_back(pool);
+    }
+
+    /// threads live as long as the pools, batches only wake them up
+    m_recordingThreads.reserve(countThreads - 1);
+    for (uint32_t i = 0; i + 1 < countThreads; ++i)
+        m_recordingThreads.emplace_back(&VulkanKernel::RecordingThreadLoop, this, i, m_recordingBatch);
+
+    if (!AllocateSecondaryCmdBuffs(m_secondaryCmdBuffs, m_countDCB)) {
+        this->DestroyWorkerPools();
+        return false;
+    }
+
+    /// cached passes lost their buffers with the old pools
+    for (auto&& pass : m_recordPasses) {
+        if (!AllocateSecondaryCmdBuffs(pass.m_cmdBuffs, static_cast<uint32_t>(pass.m_dirty.size()))) {
+            this->DestroyWorkerPools();
+            return false;
+        }
+
+        pass.m_dirty.assign(pass.m_dirty.size(), true);
+    }
+
+    return true;
+}
+
+bool EvoVulkan::Core::VulkanKernel::AllocateSecondaryCmdBuffs(std::vector<VkCommandBuffer>& cmdBuffs, uint32_t countImages) {
+    const auto countWorkers = static_cast<uint32_t>(m_workerPools.size());
+
+    cmdBuffs.resize(countImages * countWorkers);
+
+    for (uint32_t i = 0; i < countWorkers; ++i) {
+        auto&& allocInfo = Tools::Initializers::CommandBufferAllocateInfo(*m_workerPools[i], VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1);
+
+        for (uint32_t image = 0; image < countImages; ++image) {
+            if (vkAllocateCommandBuffers(*m_device, &allocInfo, &cmdBuffs[image * countWorkers + i]) != VK_SUCCESS) {
+                VK_ERROR("VulkanKernel::AllocateSecondaryCmdBuffs() : failed to allocate secondary command buffer!");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void EvoVulkan::Core::VulkanKernel::RetireSecondaryCmdBuffs(std::vector<VkCommandBuffer>& cmdBuffs) {
+    if (cmdBuffs.empty())
+        return;
+
+    /// [image * count workers + worker], every worker frees its buffers to its own pool.
+    /// If the pools have been replaced since, the buffers are freed with them
+    this->DeferredDestroy([this, generation = m_workerPoolsGeneration, cmdBuffs = std::move(cmdBuffs)]() {
+        if (generation != m_workerPoolsGeneration)
+            return;
+
+        const auto countWorkers = static_cast<uint32_t>(m_workerPools.size());
+
+        for (uint32_t i = 0; i < cmdBuffs.size(); ++i)
+            vkFreeCommandBuffers(*m_device, *m_workerPools[i % countWorkers], 1, &cmdBuffs[i]);
+    });
+
+    cmdBuffs.clear();
+}
+
+void EvoVulkan::Core::VulkanKernel::DestroyWorkerPools(bool deferred) {
+    {
+        std::lock_guard<std::mutex> lock(m_recordingMutex);
+        this->m_recordingStop = true;
+    }
+
+    m_recordingStart.notify_all();
+
+    for (auto&& thread : m_recordingThreads)
+        thread.join();
+
+    m_recordingThreads.clear();
+    this->m_recordingStop = false;
+
+    /// command buffers are freed with their pools
+    for (auto&& pool : m_workerPools) {
+        if (deferred)
+            this->DeferredFree(pool);
+        else
+            EVSafeFreeObject(pool);
+    }
+
+    m_workerPools.clear();
+    ++m_workerPoolsGeneration;
+    m_secondaryCmdBuffs.clear();
+
+    for (auto&& pass : m_recordPasses)
+        pass.m_cmdBuffs.clear();
+}
+
+bool EvoVulkan::Core::VulkanKernel::RunRecordingWorkers(RecordingTaskFn task, const void* context) {
+    const auto countWorkers = static_cast<uint32_t>(m_workerPools.size());
+
+    if (!m_recordingThreads.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(m_recordingMutex);
+
+            this->m_recordingTask    = task;
+            this->m_recordingContext = context;
+            this->m_recordingSuccess = true;
+            this->m_recordingPending = static_cast<uint32_t>(m_recordingThreads.size());
+
+            ++m_recordingBatch;
+        }
+
+        m_recordingStart.notify_all();
+    }
+
+    /// the calling thread is the last worker, every worker owns its pool, so recording doesn't need synchronization
+    bool success = task(context, countWorkers - 1);
+
+    if (!m_recordingThreads.empty()) {
+        std::unique_lock<std::mutex> lock(m_recordingMutex);
+        m_recordingDone.wait(lock, [this]() { return m_recordingPending == 0; });
+
+        success &= m_recordingSuccess;
+
+        this->m_recordingTask    = nullptr;
+        this->m_recordingContext = nullptr;
+    }
+
+    return success;
+}
+
+void EvoVulkan::Core::VulkanKernel::RecordingThreadLoop(uint32_t worker, uint64_t batch) {
+    /// workers record a part of every frame, their allocations belong to it
+    Tools::HeapGuard::SetGuarded(true);
+
+    while (true) {
+        RecordingTaskFn task    = nullptr;
+        const void*     context = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(m_recordingMutex);
+            m_recordingStart.wait(lock, [this, batch]() { return m_recordingStop || m_recordingBatch != batch; });
+
+            if (m_recordingStop)
+                return;
+
+            batch   = m_recordingBatch;
+            task    = m_recordingTask;
+            context = m_recordingContext;
+        }
+
+        const bool success = task(context, worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_recordingMutex);
+
+            m_recordingSuccess &= success;
+
+            if (--m_recordingPending == 0)
+                m_recordingDone.notify_one();
+        }
+    }
+}
+
+bool EvoVulkan::Core::VulkanKernel::RecordSecondary(
+        VkCommandBuffer cmd,
+        const VkCommandBufferInheritanceInfo& inheritanceInfo,
+        const VkViewport& viewport,
+        const VkRect2D& scissor,
+        const SecondaryRecordFn& record,
+        uint32_t imageIndex, uint32_t first, uint32_t last)
+{
+    VkCommandBufferBeginInfo beginInfo = Tools::Initializers::CommandBufferBeginInfo();
+    beginInfo.flags            = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS)
+        return false;
+
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+    if (first < last)
+        record(cmd, imageIndex, first, last);
+
+    return vkEndCommandBuffer(cmd) == VK_SUCCESS;
+}
+
+bool EvoVulkan::Core::VulkanKernel::RecordCmdBuffersParallel(
+        uint32_t countItems,
+        const SecondaryRecordFn& record,
+        const std::vector<VkClearValue>& clearValues)
+{
+    if (m_workerPools.empty() && !SetRecordingThreads()) {
+        VK_ERROR("VulkanKernel::RecordCmdBuffersParallel() : failed to create recording threads!");
+        return false;
+    }
+
+    /// all draw buffers are re-recorded by the application, the frame isn't a steady state
+    this->RestartHeapGuardWarmup();
+
+    const auto countWorkers = static_cast<uint32_t>(m_workerPools.size());
+    const uint32_t chunk    = (countItems + countWorkers - 1) / countWorkers;
+
+    const VkViewport viewport = GetViewport();
+    const VkRect2D   scissor  = GetScissor();
+
+    auto&& workerRecord = [&](uint32_t worker) -> bool {
+        const uint32_t first = std::min(worker * chunk, countItems);
+        const uint32_t last  = std::min(first + chunk, countItems);
+
+        for (uint32_t image = 0; image < m_countDCB; ++image) {
+            auto&& inheritanceInfo = Tools::Initializers::CommandBufferInheritanceInfo(m_renderPass.m_self, 0, m_frameBuffers[image]);
+
+            if (!RecordSecondary(m_secondaryCmdBuffs[image * countWorkers + worker], inheritanceInfo, viewport, scissor, record, image, first, last))
+                return false;
+        }
+
+        return true;
+    };
+
+    if (!RunRecordingWorkers(workerRecord)) {
+        VK_ERROR("VulkanKernel::RecordCmdBuffersParallel() : failed to record secondary command buffers!");
+        return false;
+    }
+
+    VkCommandBufferBeginInfo cmdBufInfo = Tools::Initializers::CommandBufferBeginInfo();
+
+    auto renderPassBI = Tools::Insert::RenderPassBeginInfo(
+            m_width, m_height, m_renderPass.m_self,
+            VK_NULL_HANDLE, clearValues.data(), static_cast<uint32_t>(clearValues.size()));
+
+    for (uint32_t image = 0; image < m_countDCB; ++image) {
+        renderPassBI.framebuffer = m_frameBuffers[image];
+
+        if (vkBeginCommandBuffer(m_drawCmdBuffs[image], &cmdBufInfo) != VK_SUCCESS) {
+            VK_ERROR("VulkanKernel::RecordCmdBuffersParallel() : failed to begin draw command buffer!");
+            return false;
+        }
+
+        vkCmdBeginRenderPass(m_drawCmdBuffs[image], &renderPassBI, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        vkCmdExecuteCommands(m_drawCmdBuffs[image], countWorkers, &m_secondaryCmdBuffs[image * countWorkers]);
+
+        vkCmdEndRenderPass(m_drawCmdBuffs[image]);
+
+        if (vkEndCommandBuffer(m_drawCmdBuffs[image]) != VK_SUCCESS) {
+            VK_ERROR("VulkanKernel::RecordCmdBuffersParallel() : failed to end draw command buffer!");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int32_t EvoVulkan::Core::VulkanKernel::AddRecordPass(
+        Complexes::FrameBuffer* target,
+        uint32_t countItems,
+        const SecondaryRecordFn& record,
+        bool everyFrame)
+{
+    if (m_workerPools.empty() && !SetRecordingThreads()) {
+        VK_ERROR("VulkanKernel::AddRecordPass() : failed to create recording threads!");
+        return -1;
+    }
+
+    RecordPass pass;
+    {
+        pass.m_record     = record;
+        pass.m_countItems = countItems;
+        pass.m_target     = target;
+        /// offscreen framebuffer has a command buffer per frame in flight
+        pass.m_dirty      = std::vector<bool>(target ? target->GetCountFrames() : m_countDCB, true);
+        pass.m_everyFrame = everyFrame;
+    }
+
+    if (!AllocateSecondaryCmdBuffs(pass.m_cmdBuffs, static_cast<uint32_t>(pass.m_dirty.size()))) {
+        VK_ERROR("VulkanKernel::AddRecordPass() : failed to allocate pass command buffers!");
+        return -1;
+    }
+
+    m_recordPasses.emplace_back(std::move(pass));
+
+    return static_cast<int32_t>(m_recordPasses.size()) - 1;
+}
+
+void EvoVulkan::Core::VulkanKernel::MarkPassDirty(uint32_t pass) {
+    if (pass >= m_recordPasses.size()) {
+        VK_ERROR("VulkanKernel::MarkPassDirty() : incorrect pass index!");
+        return;
+    }
+
+    auto&& dirty = m_recordPasses[pass].m_dirty;
+    dirty.assign(dirty.size(), true);
+}
+
+void EvoVulkan::Core::VulkanKernel::MarkPassDirty(uint32_t pass, uint32_t imageIndex) {
+    if (pass >= m_recordPasses.size()) {
+        VK_ERROR("VulkanKernel::MarkPassDirty() : incorrect pass index!");
+        return;
+    }
+
+    auto&& dirty = m_recordPasses[pass].m_dirty;
+    dirty[std::min<uint32_t>(imageIndex, dirty.size() - 1)] = true;
+}
+
+void EvoVulkan::Core::VulkanKernel::SetPassTarget(uint32_t pass, Complexes::FrameBuffer* target) {
+    if (pass >= m_recordPasses.size()) {
+        VK_ERROR("VulkanKernel::SetPassTarget() : incorrect pass index!");
+        return;
+    }
+
+    auto&& recordPass = m_recordPasses[pass];
+    const uint32_t countImages = target ? target->GetCountFrames() : m_countDCB;
+
+    recordPass.m_target = target;
+
+    /// buffers of the old target can be executed by frames in flight
+    if (countImages != recordPass.m_dirty.size()) {
+        this->RetireSecondaryCmdBuffs(recordPass.m_cmdBuffs);
+
+        if (!AllocateSecondaryCmdBuffs(recordPass.m_cmdBuffs, countImages))
+            VK_ERROR("VulkanKernel::SetPassTarget() : failed to allocate pass command buffers!");
+    }
+
+    recordPass.m_dirty.assign(countImages, true);
+}
+
+void EvoVulkan::Core::VulkanKernel::SetPassCountItems(uint32_t pass, uint32_t countItems) {
+    if (pass >= m_recordPasses.size()) {
+        VK_ERROR("VulkanKernel::SetPassCountItems() : incorrect pass index!");
+        return;
+    }
+
+    if (m_recordPasses[pass].m_countItems != countItems) {
+        m_recordPasses[pass].m_countItems = countItems;
+        this->MarkPassDirty(pass);
+    }
+}
+
+void EvoVulkan::Core::VulkanKernel::MarkAllPassesDirty() {
+    for (uint32_t i = 0; i < m_recordPasses.size(); ++i)
+        this->MarkPassDirty(i);
+}
+
+bool EvoVulkan::Core::VulkanKernel::RecordDirtyPasses(const std::vector<VkClearValue>& clearValues) {
+    if (&clearValues != &m_passClearValues)
+        this->m_passClearValues = clearValues;
+
+    uint32_t countJobs = 0;
+    bool steady = true;
+
+    for (auto&& pass : m_recordPasses) {
+        const auto countDirty = static_cast<uint32_t>(std::count(pass.m_dirty.begin(), pass.m_dirty.end(), true));
+
+        countJobs += countDirty;
+        steady &= pass.m_everyFrame || countDirty == 0;
+    }
+
+    if (countJobs == 0)
+        return true;
+
+    /// passes which are recorded every frame only reuse their command buffers, the frame arena and the workers
+    if (!steady)
+        this->RestartHeapGuardWarmup();
+
+    auto&& arena = GetFrameArena();
+
+    /// (pass, image) pairs which have to be re-recorded
+    auto&& jobs = std::span(arena->Allocate<std::pair<uint32_t, uint32_t>>(countJobs), countJobs);
+    countJobs = 0;
+
+    for (uint32_t i = 0; i < m_recordPasses.size(); ++i)
+        for (uint32_t image = 0; image < m_recordPasses[i].m_dirty.size(); ++image)
+            if (m_recordPasses[i].m_dirty[image])
+                jobs[countJobs++] = std::make_pair(i, image);
+
+    const auto countWorkers = static_cast<uint32_t>(m_workerPools.size());
+
+    const bool recorded = RunRecordingWorkers([&](uint32_t worker) -> bool {
+        for (auto&& [passIndex, image] : jobs) {
+            const RecordPass& pass = m_recordPasses[passIndex];
+
+            const uint32_t chunk = (pass.m_countItems + countWorkers - 1) / countWorkers;
+            const uint32_t first = std::min(worker * chunk, pass.m_countItems);
+            const uint32_t last  = std::min(first + chunk, pass.m_countItems);
+
+            auto&& inheritanceInfo = pass.m_target ?
+                    Tools::Initializers::CommandBufferInheritanceInfo(pass.m_target->GetRenderPass().m_self, 0, *pass.m_target) :
+                    Tools::Initializers::CommandBufferInheritanceInfo(m_renderPass.m_self, 0, m_frameBuffers[image]);
+
+            const VkViewport viewport = pass.m_target ? pass.m_target->GetViewport() : GetViewport();
+            const VkRect2D   scissor  = pass.m_target ? pass.m_target->GetScissor()   : GetScissor();
+
+            if (!RecordSecondary(pass.m_cmdBuffs[image * countWorkers + worker], inheritanceInfo, viewport, scissor, pass.m_record, image, first, last))
+                return false;
+        }
+
+        return true;
+    });
+
+    if (!recorded) {
+        VK_ERROR("VulkanKernel::RecordDirtyPasses() : failed to record secondary command buffers!");
+        return false;
+    }
+
+    /// primary buffers only execute cached secondaries, re-record those whose passes have been changed
+    auto&& dirtyImages  = std::span(arena->Allocate<bool>(m_countDCB), m_countDCB);
+    /// (target, frame in flight) pairs
+    auto&& dirtyTargets = std::span(arena->Allocate<std::pair<Complexes::FrameBuffer*, uint32_t>>(jobs.size()), jobs.size());
+    uint32_t countDirtyTargets = 0;
+
+    std::fill(dirtyImages.begin(), dirtyImages.end(), false);
+
+    for (auto&& [passIndex, image] : jobs) {
+        auto&& target = m_recordPasses[passIndex].m_target;
+        const auto targetFrame = std::make_pair(target, image);
+
+        if (!target)
+            dirtyImages[image] = true;
+        else if (std::find(dirtyTargets.begin(), dirtyTargets.begin() + countDirtyTargets, targetFrame) == dirtyTargets.begin() + countDirtyTargets)
+            dirtyTargets[countDirtyTargets++] = targetFrame;
+    }
+
+    auto&& executePasses = [this, countWorkers](VkCommandBuffer primary, Complexes::FrameBuffer* target, uint32_t image) {
+        for (auto&& pass : m_recordPasses)
+            if (pass.m_target == target)
+                vkCmdExecuteCommands(primary, countWorkers, &pass.m_cmdBuffs[image * countWorkers]);
+    };
+
+    VkCommandBufferBeginInfo cmdBufInfo = Tools::Initializers::CommandBufferBeginInfo();
+
+    auto renderPassBI = Tools::Insert::RenderPassBeginInfo(
+            m_width, m_height, m_renderPass.m_self,
+            VK_NULL_HANDLE, clearValues.data(), static_cast<uint32_t>(clearValues.size()));
+
+    for (uint32_t image = 0; image < m_countDCB; ++image) {
+        if (!dirtyImages[image])
+            continue;
+
+        renderPassBI.framebuffer = m_frameBuffers[image];
+
+        if (vkBeginCommandBuffer(m_drawCmdBuffs[image], &cmdBufInfo) != VK_SUCCESS) {
+            VK_ERROR("VulkanKernel::RecordDirtyPasses() : failed to begin draw command buffer!");
+            return false;
+        }
+
+        vkCmdBeginRenderPass(m_drawCmdBuffs[image], &renderPassBI, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        executePasses(m_drawCmdBuffs[image], nullptr, image);
+        vkCmdEndRenderPass(m_drawCmdBuffs[image]);
+
+        if (vkEndCommandBuffer(m_drawCmdBuffs[image]) != VK_SUCCESS) {
+            VK_ERROR("VulkanKernel::RecordDirtyPasses() : failed to end draw command buffer!");
+            return false;
+        }
+    }
+
+    for (auto&& [target, frame] : dirtyTargets.first(countDirtyTargets)) {
+        auto&& targetBI = target->BeginRenderPass(const_cast<VkClearValue*>(target->GetClearValues()), target->GetCountClearValues());
+        const VkCommandBuffer targetCmd = target->GetCmd(frame);
+
+        if (vkBeginCommandBuffer(targetCmd, &cmdBufInfo) != VK_SUCCESS) {
+            VK_ERROR("VulkanKernel::RecordDirtyPasses() : failed to begin target command buffer!");
+            return false;
+        }
+
+        vkCmdBeginRenderPass(targetCmd, &targetBI, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        executePasses(targetCmd, target, frame);
+        vkCmdEndRenderPass(targetCmd);
+
+        if (vkEndCommandBuffer(targetCmd) != VK_SUCCESS) {
+            VK_ERROR("VulkanKernel::RecordDirtyPasses() : failed to end target command buffer!");
+            return false;
+        }
+    }
+
+    for (auto&& pass : m_recordPasses)
+        pass.m_dirty.assign(pass.m_dirty.size(), false);
+
+    return true;
 }
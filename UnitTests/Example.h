@@ -19,10 +19,12 @@
 #include <GLFW/glfw3.h>
 
 #include <EvoVulkan/Types/Texture.h>
+#include <EvoVulkan/Tools/MipChain.h>
 
 #include <stbi.h>
 
 #include <array>
+#include <chrono>
 
 #include <EvoVulkan/VulkanKernel.h>
 
@@ -57,6 +59,12 @@ struct PPUniformBuffer {
     float gamma;
 };
 
+/// dynamic offsets of the uniform ring which are written by a frame in flight
+struct FrameUniformOffsets {
+    uint32_t view;
+    uint32_t skybox;
+};
+
 struct VertexUV {
     float position[3];
     float uv[2];
@@ -76,10 +84,12 @@ struct mesh {
     ModelUniformBuffer       m_ubo           = {};
     uint64_t                 m_countIndices  = 0;
 
-    __forceinline void Draw(const VkCommandBuffer& cmd, const VkPipelineLayout& layout) const {
+    /// dynamic offsets select uniforms of the frame in flight, one per dynamic binding of the set
+    __forceinline void Draw(const VkCommandBuffer& cmd, const VkPipelineLayout& layout,
+                            uint32_t countDynamicOffsets = 0, const uint32_t* dynamicOffsets = nullptr) const {
         VkDeviceSize offsets[1] = {0};
 
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &m_descriptorSet.m_self, 0, NULL);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &m_descriptorSet.m_self, countDynamicOffsets, dynamicOffsets);
         vkCmdBindVertexBuffers(cmd, 0, 1, &m_vertexBuffer->m_buffer, offsets);
         vkCmdBindIndexBuffer(cmd, m_indexBuffer->m_buffer, 0, VK_INDEX_TYPE_UINT32);
 
@@ -107,7 +117,8 @@ public:
     Complexes::Shader*          m_geometry            = nullptr;
     Complexes::Shader*          m_skyboxShader        = nullptr;
 
-    Types::Buffer*              m_viewUniformBuffer   = nullptr;
+    /// view and skybox uniforms are pushed into the uniform ring every frame, see UpdateUBO()
+    std::vector<FrameUniformOffsets> m_frameUniforms  = { };
 
     Complexes::Shader*          m_postProcessing      = nullptr;
     Core::DescriptorSet         m_PPDescriptorSet     = { };
@@ -124,12 +135,38 @@ public:
 
     Complexes::FrameBuffer*     m_offscreen           = nullptr;
 
+    /// meshes and skybox into the offscreen framebuffer, post processing into the swapchain
+    int32_t                     m_offscreenPass       = -1;
+    int32_t                     m_postProcessPass     = -1;
+
+    /// model matrices of the meshes, a slot of all meshes per frame in flight, see DispatchModels()
+    VkBuffer                    m_modelsBuffer        = VK_NULL_HANDLE;
+    VmaAllocation               m_modelsAllocation    = VK_NULL_HANDLE;
+    uint8_t*                    m_modelsMapped        = nullptr;
+
+    /// compute pass of the model matrices, VK_NULL_HANDLE - they are written by the CPU
+    VkDescriptorSetLayout       m_modelsSetLayout     = VK_NULL_HANDLE;
+    VkPipelineLayout            m_modelsLayout        = VK_NULL_HANDLE;
+    VkPipeline                  m_modelsPipeline      = VK_NULL_HANDLE;
+    Core::DescriptorSet         m_modelsDescriptorSet = { };
+    std::vector<VkCommandBuffer> m_modelsCmdBuffs     = { };
+    /// compute timeline value of the current frame, 0 - nothing to wait
+    uint64_t                    m_modelsValue         = 0;
+
+    std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now();
+
+    /// the swapchain and offscreen images are read back by the next frame, see RequestScreenshot()
+    bool                        m_screenshot          = false;
+
     mesh meshes[3];
     mesh skybox;
 public:
     void Render() override {
-        if (this->PrepareFrame() == Core::FrameResult::OutOfDate)
+        /// the image isn't acquired, the frame is skipped
+        if (this->PrepareFrame() == Core::FrameResult::OutOfDate) {
             this->m_hasErrors = !this->ResizeWindow();
+            return;
+        }
 
         /*// Command buffer to be submitted to the queue
         m_submitInfo.commandBufferCount = 1;
@@ -143,12 +180,30 @@ public:
         }*/
 
 
+        /// the compute queue runs the dispatch while the previous frame is still rasterized
+        if (!DispatchModels(GetCurrentFrameIndex())) {
+            VK_ERROR("renderFunction() : failed to dispatch model matrices!");
+            return;
+        }
+
+        this->LateLatch();
+
+        /// offsets in the uniform ring are new every frame, only the secondaries of this frame are re-recorded
+        this->MarkPassDirty(m_offscreenPass, GetCurrentFrameIndex());
+        if (!RecordDirtyPasses(m_passClearValues)) {
+            VK_ERROR("renderFunction() : failed to record offscreen pass!");
+            return;
+        }
+
+        m_offscreen->SetFrame(GetCurrentFrameIndex());
+
         m_submitInfo.commandBufferCount = 1;
 
         m_submitInfo.pWaitSemaphores    = &m_syncs.m_presentComplete;
         m_submitInfo.pSignalSemaphores  = &m_offscreen->m_semaphore;
         m_submitInfo.pCommandBuffers    = &m_offscreen->m_cmdBuff;
-        auto result = vkQueueSubmit(m_device->GetGraphicsQueue(), 1, &m_submitInfo, VK_NULL_HANDLE);
+        /// only vertex shaders of the geometry wait for the matrices
+        auto result = SubmitAfterCompute(m_submitInfo, m_modelsValue, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
         if (result != VK_SUCCESS) {
             VK_ERROR("renderFunction() : failed to submit first queue!");
             return;
@@ -163,11 +218,25 @@ public:
             return;
         }
 
+        if (m_screenshot && !ReadbackScreenshot())
+            VK_ERROR("renderFunction() : failed to read back screenshot!");
+        m_screenshot = false;
+
         if (this->SubmitFrame() == Core::FrameResult::OutOfDate)
             this->m_hasErrors = !this->ResizeWindow();
     }
 
-    void UpdateUBO() {
+    void OnLateLatch(uint32_t frameIndex) override {
+        UpdateUBO(frameIndex);
+    }
+
+    /// uniform buffers hold a slot per frame in flight, slots of other frames may be read by the GPU
+    [[nodiscard]] VkDeviceSize GetUniformStride(VkDeviceSize size) const {
+        const VkDeviceSize alignment = m_device->GetUniformBufferAlignment();
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    void UpdateUBO(uint32_t frameIndex) {
         glm::mat4 projectionMatrix = glm::perspective(
                 glm::radians(
                         1000.f), // The vertical Field of View, in radians: the amount of "zoom". Think "camera lens". Usually between 90° (extra wide) and 30° (quite zoomed in)
@@ -226,21 +295,21 @@ public:
                 projectionMatrix,
                 glm::translate(view, glm::vec3(x, y, z))
         };
-        this->m_viewUniformBuffer->CopyToDevice(&viewUbo, sizeof(ViewUniformBuffer));
+        const auto viewAllocation = GetUniformRing()->Push(viewUbo);
 
-        int i = 0;
-        for (auto & _mesh : meshes) {
+        /// same matrices as models.comp, if the compute pass isn't available
+        const float time = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_startTime).count();
+
+        for (uint32_t i = 0; m_modelsPipeline == VK_NULL_HANDLE && i < std::size(meshes); ++i) {
             glm::mat4 model = glm::mat4(1);
             model = glm::translate(model, glm::vec3(i * 2.5, 0, 5 * i));
            // model *= glm::mat4(glm::angleAxis(glm::radians(f), glm::vec3(0, 1, 0)));
 
-            model *= glm::mat4(glm::angleAxis(glm::radians(10.f * (float)i), glm::vec3(0, 1, 0)));
-
-            i++;
+            model *= glm::mat4(glm::angleAxis(glm::radians(10.f * (float)i) + time * 0.5f, glm::vec3(0, 1, 0)));
 
-            _mesh.m_ubo = { model };
+            meshes[i].m_ubo = { model };
 
-            _mesh.m_uniformBuffer->CopyToDevice(&_mesh.m_ubo, sizeof(ModelUniformBuffer));
+            memcpy(m_modelsMapped + GetModelOffset(frameIndex, i), &meshes[i].m_ubo, sizeof(ModelUniformBuffer));
         }
 
         SkyboxUniformBuffer ubo = {
@@ -249,7 +318,14 @@ public:
                 glm::vec3(x, y, z)
         };
 
-        skybox.m_uniformBuffer->CopyToDevice(&ubo, sizeof(SkyboxUniformBuffer));
+        const auto skyboxAllocation = GetUniformRing()->Push(ubo);
+
+        if (!viewAllocation.Valid() || !skyboxAllocation.Valid()) {
+            VK_ERROR("Example::UpdateUBO() : uniform ring is full!");
+            return;
+        }
+
+        m_frameUniforms[frameIndex] = { viewAllocation.m_offset, skyboxAllocation.m_offset };
     }
 
     void LoadSkybox() {
@@ -290,22 +366,18 @@ public:
                 indices.data());
 
         skybox.m_descriptorSet = this->m_descriptorManager->AllocateDescriptorSets(m_skyboxShader->GetDescriptorSetLayout(), {
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
         });
         skybox.m_countIndices = indices.size();
         skybox.m_vertexBuffer = m_skyboxVerticesBuff;
         skybox.m_indexBuffer  = m_skyboxIndicesBuff;
         skybox.m_descrManager = m_descriptorManager;
 
-        skybox.m_uniformBuffer = EvoVulkan::Types::Buffer::Create(
-                m_device,
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-                sizeof(SkyboxUniformBuffer));
+        auto skyboxDescriptor = GetUniformRing()->GetDescriptorInfo(sizeof(SkyboxUniformBuffer));
 
         std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
-                Tools::Initializers::WriteDescriptorSet(skybox.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0,
-                                                        &skybox.m_uniformBuffer->m_descriptor),
+                Tools::Initializers::WriteDescriptorSet(skybox.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0,
+                                                        &skyboxDescriptor),
                 Tools::Initializers::WriteDescriptorSet(skybox.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
                                                         m_cubeMap->GetDescriptorRef()),
         };
@@ -413,25 +485,410 @@ public:
             h = sz.second;
         }
 
-        auto cmpBuffer = Compress(w, h, pixels);
+        /// levels are generated on the CPU, BC1 can't be blitted. Compress() takes whole blocks only
+        Tools::MipChainInfo mipInfo;
+        mipInfo.m_filter    = Tools::MipFilter::Kaiser;
+        mipInfo.m_srgb      = true;
+        mipInfo.m_mipLevels = 1;
+
+        while ((w >> mipInfo.m_mipLevels) % 4 == 0 && (h >> mipInfo.m_mipLevels) % 4 == 0 && (w >> mipInfo.m_mipLevels) > 0 && (h >> mipInfo.m_mipLevels) > 0)
+            ++mipInfo.m_mipLevels;
+
+        Tools::MipChain mipChain;
+        if (!Tools::GenerateMipChain(pixels, w, h, mipInfo, mipChain)) {
+            VK_ERROR("Example::LoadTexture() : failed to generate mip chain!");
+            return false;
+        }
+
+        std::vector<uint8_t> cmpLevels;
+        std::vector<Tools::MipLevel> levels;
+
+        for (uint32_t i = 0; i < mipChain.m_levels.size(); ++i) {
+            auto&& level = mipChain.m_levels[i];
+            auto cmpLevel = Compress(level.m_width, level.m_height, const_cast<uint8_t*>(mipChain.GetLevelData(i)));
+
+            //! BC1 - 8 bytes per 4x4 block
+            const VkDeviceSize size = (level.m_width / 4) * (level.m_height / 4) * 8;
+            levels.emplace_back(Tools::MipLevel { level.m_width, level.m_height, cmpLevels.size(), size });
+            cmpLevels.insert(cmpLevels.end(), cmpLevel, cmpLevel + size);
+
+            free(cmpLevel);
+        }
 
         //S3TC_DXT1
         //for (uint32_t i = 0; i < 40; i++)
           //  m_texture = Types::Texture::LoadWithoutMip(m_device, m_cmdPool, pixels, VK_FORMAT_R8G8B8A8_SRGB, w, h);
         //m_texture = Types::Texture::LoadWithoutMip(m_device, m_descriptorManager, m_cmdPool, cmpBuffer, VK_FORMAT_R8G8B8A8_SRGB, w, h, VK_FILTER_LINEAR);
-        m_texture = Types::Texture::LoadWithoutMip(m_device, m_descriptorManager, m_cmdPool, cmpBuffer, VK_FORMAT_BC1_RGBA_SRGB_BLOCK, w, h, VK_FILTER_LINEAR);
+        m_texture = Types::Texture::LoadLevels(m_device, m_allocator, m_descriptorManager, m_cmdPool, cmpLevels.data(), levels, VK_FORMAT_BC1_RGBA_SRGB_BLOCK, VK_FILTER_LINEAR);
            // m_texture = Types::Texture::LoadWithoutMip(m_device, m_cmdPool, pixels, VK_FORMAT_BC7_UNORM_BLOCK, w, h);
             //m_texture = Types::Texture::LoadCompressed(m_device, m_descriptorManager, m_cmdPool, pixels, VK_FORMAT_BC1_RGB_UNORM_BLOCK, w, h);
             //m_texture = Types::Texture::LoadAutoMip(m_device, m_cmdPool, pixels, VK_FORMAT_R8G8B8A8_SRGB, w, h, 3);
 
+        stbi_image_free(pixels);
+
         if (!m_texture)
             return false;
 
-        free(cmpBuffer);
+        return true;
+    }
+
+    /// loads small textures by the staging path and by the host image copy, logs time of both
+    bool BenchmarkTextureUpload(uint32_t count = 256, uint32_t size = 64) {
+        std::vector<uint8_t> pixels(size * size * 4, 127);
+
+        auto&& measure = [&](VkDeviceSize hostLimit) -> double {
+            m_device->SetHostImageCopyLimit(hostLimit);
+
+            std::vector<Types::Texture*> textures;
+            textures.reserve(count);
+
+            const auto begin = std::chrono::steady_clock::now();
+
+            for (uint32_t i = 0; i < count; ++i) {
+                auto texture = Types::Texture::LoadWithoutMip(m_device, m_allocator, m_descriptorManager, m_cmdPool,
+                        pixels.data(), VK_FORMAT_R8G8B8A8_UNORM, size, size, VK_FILTER_LINEAR, false, m_transferCmdPool);
+                if (!texture)
+                    break;
+                textures.emplace_back(texture);
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+
+            for (auto&& texture : textures) {
+                texture->Destroy();
+                texture->Free();
+            }
+
+            if (textures.size() != count)
+                return -1.0;
+
+            return std::chrono::duration<double, std::milli>(end - begin).count();
+        };
+
+        const VkDeviceSize hostLimit = m_device->GetHostImageCopyLimit();
+
+        const double staging = measure(0);
+        const double host = m_device->IsHostImageCopyEnabled() ? measure(VK_WHOLE_SIZE) : -1.0;
+
+        m_device->SetHostImageCopyLimit(hostLimit);
+
+        if (staging < 0.0) {
+            VK_ERROR("Example::BenchmarkTextureUpload() : failed to load textures!");
+            return false;
+        }
+
+        VK_LOG("Example::BenchmarkTextureUpload() : " + std::to_string(count) + " textures " +
+               std::to_string(size) + "x" + std::to_string(size) +
+               "\n\tStaging: " + std::to_string(staging) + " ms" +
+               "\n\tHost image copy: " + (host < 0.0 ? std::string("unsupported") : std::to_string(host) + " ms"));
+
+        return true;
+    }
+
+    /// creates small uniform buffers, far more than maxMemoryAllocationCount, and logs the time and the used memory
+    bool BenchmarkBufferCount(uint32_t count = 100000) {
+        std::vector<Types::Buffer*> buffers;
+        buffers.reserve(count);
+
+        const auto begin = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < count; ++i) {
+            auto buffer = Types::Buffer::Create(m_device, m_allocator, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 16);
+            if (!buffer)
+                break;
+            buffers.emplace_back(buffer);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const uint64_t usage = m_allocator->GetGPUMemoryUsage();
+        const bool created = buffers.size() == count;
+
+        for (auto&& buffer : buffers)
+            EVSafeFreeObject(buffer);
+
+        if (!created) {
+            VK_ERROR("Example::BenchmarkBufferCount() : failed to create buffers!");
+            return false;
+        }
+
+        VK_LOG("Example::BenchmarkBufferCount() : " + std::to_string(count) + " buffers" +
+               "\n\tTime: " + std::to_string(std::chrono::duration<double, std::milli>(end - begin).count()) + " ms" +
+               "\n\tMemory: " + std::to_string(usage / 1024) + " KB");
+
+        return true;
+    }
+
+    /**
+     * @brief Records binds of per object uniforms: a descriptor set and a buffer per object against one dynamic
+     *        set of the uniform ring with an offset per object, logs time of both
+     *
+     * @note Uses the skybox layout, so it's called after SetupShader(). Nothing is drawn or submitted.
+     */
+    bool BenchmarkUniformRing(uint32_t count = 1000, uint32_t frames = 100) {
+        auto&& ring = GetUniformRing();
+        if (!ring || !m_skyboxShader) {
+            VK_ERROR("Example::BenchmarkUniformRing() : uniform ring is disabled or shaders aren't set up!");
+            return false;
+        }
+
+        const VkDescriptorSetLayout setLayout = m_skyboxShader->GetDescriptorSetLayout();
+        const VkPipelineLayout      layout    = m_skyboxShader->GetPipelineLayout();
+
+        auto&& allocateSet = [&](VkDescriptorBufferInfo* descriptor) -> Core::DescriptorSet {
+            auto set = m_descriptorManager->AllocateDescriptorSets(setLayout, {
+                    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+            });
+
+            if (set.m_self != VK_NULL_HANDLE) {
+                auto writer = Tools::Initializers::WriteDescriptorSet(set.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0, descriptor);
+                vkUpdateDescriptorSets(*m_device, 1, &writer, 0, nullptr);
+            }
+
+            return set;
+        };
+
+        //!=============================================================================================================
+
+        const auto setupBegin = std::chrono::steady_clock::now();
+
+        std::vector<Types::Buffer*>      buffers;
+        std::vector<Core::DescriptorSet> sets;
+        buffers.reserve(count);
+        sets.reserve(count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            auto buffer = Types::Buffer::Create(m_device, m_allocator, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, sizeof(SkyboxUniformBuffer));
+            if (!buffer)
+                break;
+            buffers.emplace_back(buffer);
+
+            buffer->SetupDescriptor(sizeof(SkyboxUniformBuffer));
+
+            auto set = allocateSet(&buffer->m_descriptor);
+            if (set.m_self == VK_NULL_HANDLE)
+                break;
+            sets.emplace_back(set);
+        }
+
+        const auto setupEnd = std::chrono::steady_clock::now();
+
+        auto ringDescriptor = ring->GetDescriptorInfo(sizeof(SkyboxUniformBuffer));
+        auto ringSet        = allocateSet(&ringDescriptor);
+
+        //!=============================================================================================================
+
+        VkCommandBuffer cmds[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+        auto allocInfo = Tools::Initializers::CommandBufferAllocateInfo(*m_cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 2);
+
+        const bool prepared = sets.size() == count && ringSet.m_self != VK_NULL_HANDLE &&
+                vkAllocateCommandBuffers(*m_device, &allocInfo, cmds) == VK_SUCCESS;
+
+        SkyboxUniformBuffer ubo = { glm::mat4(1), glm::mat4(1), glm::vec3(0) };
+        const uint32_t zero = 0;
+
+        uint32_t pushed = 0;
+        double setsTime = 0.0, ringTime = 0.0;
+
+        if (prepared) {
+            VkCommandBufferBeginInfo beginInfo = Tools::Initializers::CommandBufferBeginInfo();
+
+            vkBeginCommandBuffer(cmds[0], &beginInfo);
+            vkBeginCommandBuffer(cmds[1], &beginInfo);
+
+            const auto begin = std::chrono::steady_clock::now();
+
+            for (uint32_t frame = 0; frame < frames; ++frame)
+                for (uint32_t i = 0; i < count; ++i) {
+                    buffers[i]->CopyToDevice(&ubo, sizeof(SkyboxUniformBuffer));
+                    vkCmdBindDescriptorSets(cmds[0], VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &sets[i].m_self, 1, &zero);
+                }
+
+            const auto middle = std::chrono::steady_clock::now();
+
+            for (uint32_t frame = 0; frame < frames; ++frame) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    auto&& allocation = ring->Push(ubo);
+                    if (!allocation.Valid())
+                        break;
+
+                    vkCmdBindDescriptorSets(cmds[1], VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &ringSet.m_self, 1, &allocation.m_offset);
+                    ++pushed;
+                }
+
+                /// the segment of the current frame is rewound, nothing is submitted
+                ring->BeginFrame(GetCurrentFrameIndex());
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+
+            vkEndCommandBuffer(cmds[0]);
+            vkEndCommandBuffer(cmds[1]);
+
+            setsTime = std::chrono::duration<double, std::milli>(middle - begin).count();
+            ringTime = std::chrono::duration<double, std::milli>(end - middle).count();
+        }
+
+        //!=============================================================================================================
+
+        if (cmds[0] != VK_NULL_HANDLE)
+            vkFreeCommandBuffers(*m_device, *m_cmdPool, 2, cmds);
+
+        if (ringSet.m_self != VK_NULL_HANDLE)
+            m_descriptorManager->FreeDescriptorSet(ringSet);
+
+        for (auto&& set : sets)
+            m_descriptorManager->FreeDescriptorSet(set);
+
+        for (auto&& buffer : buffers)
+            EVSafeFreeObject(buffer);
+
+        if (!prepared || pushed != count * frames) {
+            VK_ERROR("Example::BenchmarkUniformRing() : failed to create descriptor sets or the ring is too small!");
+            return false;
+        }
+
+        VK_LOG("Example::BenchmarkUniformRing() : " + std::to_string(count) + " objects, " + std::to_string(frames) + " frames" +
+               "\n\tSets setup: " + std::to_string(std::chrono::duration<double, std::milli>(setupEnd - setupBegin).count()) + " ms" +
+               "\n\tSets: " + std::to_string(setsTime / frames) + " ms per frame" +
+               "\n\tRing: " + std::to_string(ringTime / frames) + " ms per frame");
+
+        return true;
+    }
+
+    /// records draw command buffers with many draws on one worker and on all cores, logs time of both
+    bool BenchmarkParallelRecording(uint32_t count = 100000) {
+        std::vector<VkClearValue> clearValues = {
+                { .color = {{0.5f, 0.5f, 0.5f, 1.0f}} },
+                { .color = {{0.5f, 0.5f, 0.5f, 1.0f}} },
+                { .depthStencil = { 1.0f, 0 } }
+        };
+
+        auto&& record = [this](VkCommandBuffer cmd, uint32_t imageIndex, uint32_t first, uint32_t last) {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_postProcessing);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_postProcessing->GetPipelineLayout(), 0, 1, &m_PPDescriptorSet.m_self, 0, NULL);
+
+            for (uint32_t i = first; i < last; ++i)
+                vkCmdDraw(cmd, 3, 1, 0, 0);
+        };
+
+        auto&& measure = [&](uint32_t countThreads) -> double {
+            if (!SetRecordingThreads(countThreads))
+                return -1.0;
+
+            const auto begin = std::chrono::steady_clock::now();
+
+            if (!RecordCmdBuffersParallel(count, record, clearValues))
+                return -1.0;
+
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        };
+
+        const uint32_t countThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        const double single   = measure(1);
+        const double parallel = measure(countThreads);
+
+        /// draw command buffers hold the benchmark draws, record passes are dirty and re-record them
+        if (!SetRecordingThreads() || single < 0.0 || parallel < 0.0) {
+            VK_ERROR("Example::BenchmarkParallelRecording() : failed to record command buffers!");
+            return false;
+        }
+
+        VK_LOG("Example::BenchmarkParallelRecording() : " + std::to_string(count) + " draws" +
+               "\n\t1 thread: " + std::to_string(single) + " ms" +
+               "\n\t" + std::to_string(countThreads) + " threads: " + std::to_string(parallel) + " ms");
+
+        return true;
+    }
+
+    /// loads textures with full mip chains generated by blits and by the compute generator, logs time of both
+    bool BenchmarkMipGeneration(const std::string& shaders, const std::string& cache, uint32_t count = 16, uint32_t size = 1024) {
+        auto generator = CreateMipGenerator(shaders + "/mipmaps.comp", cache);
+        if (!generator) {
+            VK_ERROR("Example::BenchmarkMipGeneration() : failed to create mip generator!");
+            return false;
+        }
+
+        std::vector<uint8_t> pixels(size * size * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<uint8_t>(i * 31);
+
+        auto&& measure = [&](Complexes::MipGenerator* mipGenerator) -> double {
+            std::vector<Types::Texture*> textures;
+            textures.reserve(count);
+
+            const auto begin = std::chrono::steady_clock::now();
+
+            for (uint32_t i = 0; i < count; ++i) {
+                auto texture = Types::Texture::LoadAutoMip(m_device, m_allocator, m_descriptorManager, m_cmdPool,
+                        pixels.data(), VK_FORMAT_R8G8B8A8_SRGB, size, size, VK_FILTER_LINEAR, false, m_transferCmdPool, mipGenerator);
+                if (!texture)
+                    break;
+                textures.emplace_back(texture);
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+
+            for (auto&& texture : textures) {
+                texture->Destroy();
+                texture->Free();
+            }
+
+            if (textures.size() != count)
+                return -1.0;
+
+            return std::chrono::duration<double, std::milli>(end - begin).count();
+        };
+
+        const double blit    = measure(nullptr);
+        const double compute = measure(generator);
+
+        generator->Destroy();
+        generator->Free();
+
+        if (blit < 0.0 || compute < 0.0) {
+            VK_ERROR("Example::BenchmarkMipGeneration() : failed to load textures!");
+            return false;
+        }
+
+        VK_LOG("Example::BenchmarkMipGeneration() : " + std::to_string(count) + " textures " +
+               std::to_string(size) + "x" + std::to_string(size) +
+               "\n\tBlit: " + std::to_string(blit) + " ms" +
+               "\n\tCompute: " + std::to_string(compute) + " ms");
 
         return true;
     }
 
+    void RequestScreenshot() { m_screenshot = true; }
+
+    /// reads back the rendered frame and the offscreen color without waiting, logs the latency of both
+    bool ReadbackScreenshot() {
+        const auto begin = std::chrono::steady_clock::now();
+
+        auto&& callback = [begin](const std::string& name) -> Complexes::ReadbackCallback {
+            return [begin, name](Complexes::ReadbackResult&& result) {
+                if (!result.m_success) {
+                    VK_ERROR("Example::ReadbackScreenshot() : failed to read back " + name + "!");
+                    return;
+                }
+
+                VK_LOG("Example::ReadbackScreenshot() : " + name + " " +
+                       std::to_string(result.m_width) + "x" + std::to_string(result.m_height) +
+                       "\n\tLatency: " + std::to_string(std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - begin).count()) + " ms");
+            };
+        };
+
+        /// the request is empty if the surface doesn't support copies from its images
+        const auto swapchain = GetSwapchainReadback();
+        if (swapchain.m_image != VK_NULL_HANDLE && !ReadbackImage(swapchain, callback("swapchain")))
+            return false;
+
+        return ReadbackImage(Complexes::ReadbackRequest::Attachment(m_offscreen, 0), callback("offscreen"));
+    }
+
     bool UpdatePP() {
         auto colors = m_offscreen->AllocateColorTextureReferences();
 
@@ -469,11 +926,17 @@ public:
     }
 
     bool SetupUniforms() {
-        m_viewUniformBuffer = EvoVulkan::Types::Buffer::Create(
-                m_device,
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, // | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                sizeof(ViewUniformBuffer));
+        if (!GetUniformRing()) {
+            VK_ERROR("VulkanExample::SetupUniforms() : uniform ring is disabled!");
+            return false;
+        }
+
+        m_frameUniforms.resize(GetFramesInFlight(), { 0, 0 });
+
+        auto viewDescriptor = GetUniformRing()->GetDescriptorInfo(sizeof(ViewUniformBuffer));
+
+        if (!SetupModels())
+            return false;
 
         // geometry
 
@@ -481,7 +944,7 @@ public:
             _mesh.m_descrManager = m_descriptorManager;
 
             _mesh.m_descriptorSet = this->m_descriptorManager->AllocateDescriptorSets(m_geometry->GetDescriptorSetLayout(), {
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
             });
             if (_mesh.m_descriptorSet.m_self == VK_NULL_HANDLE) {
                 VK_ERROR("VulkanExample::SetupDescriptors() : failed to allocate descriptor sets!");
@@ -490,22 +953,19 @@ public:
 
             //!=============================================================================================================
 
-            _mesh.m_uniformBuffer = EvoVulkan::Types::Buffer::Create(
-                    m_device,
-                    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, // | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                    sizeof(ModelUniformBuffer));
-
             // Setup a descriptor image info for the current texture to be used as a combined image sampler
             auto textureDescriptor = m_texture->GetDescriptorRef();
 
+            /// all meshes read the models buffer, dynamic offsets select the matrix
+            VkDescriptorBufferInfo modelDescriptor = { m_modelsBuffer, 0, sizeof(ModelUniformBuffer) };
+
             std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
                     // Binding 0 : Vertex shader uniform buffer
-                    Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0,
-                                                            &_mesh.m_uniformBuffer->m_descriptor),
+                    Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0,
+                                                            &modelDescriptor),
 
-                    Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1,
-                                                            &m_viewUniformBuffer->m_descriptor),
+                    Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
+                                                            &viewDescriptor),
 
                     //Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2,
                     //                                        textureDescriptor)
@@ -536,10 +996,10 @@ public:
                                  {"geometry.frag", VK_SHADER_STAGE_FRAGMENT_BIT},
                          },
                          {
-                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                                                                                  VK_SHADER_STAGE_VERTEX_BIT, 0),
 
-                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                                                                                  VK_SHADER_STAGE_VERTEX_BIT, 1),
 
                                  Tools::Initializers::DescriptorSetLayoutBinding(
@@ -579,7 +1039,7 @@ public:
                                  {"skybox.frag", VK_SHADER_STAGE_FRAGMENT_BIT},
                          },
                          {
-                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                                                                                  VK_SHADER_STAGE_VERTEX_BIT, 0),
 
                                  Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
@@ -642,9 +1102,168 @@ public:
                 VK_TRUE
         );
 
+        return SetupModelsPipeline("J:\\C++\\GameEngine\\Engine\\Dependences\\Framework\\Depends\\EvoVulkan\\Resources\\Shaders", "J://C++/EvoVulkan/Resources/Cache");
+    }
+
+    [[nodiscard]] VkDeviceSize GetModelOffset(uint32_t frameIndex, uint32_t mesh) const {
+        return (frameIndex * std::size(meshes) + mesh) * GetUniformStride(sizeof(ModelUniformBuffer));
+    }
+
+    /// compute pipeline of models.comp, the matrices are written by the CPU without timeline semaphores
+    bool SetupModelsPipeline(const std::string& shaders, const std::string& cache) {
+        if (!m_device->IsTimelineSemaphoreSupported()) {
+            VK_WARN("Example::SetupModelsPipeline() : timeline semaphores aren't supported, model matrices are written by the CPU!");
+            return true;
+        }
+
+        auto&& binding = Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 0);
+        auto&& setLayoutCI = Tools::Initializers::DescriptorSetLayoutCreateInfo(&binding, 1);
+        if (vkCreateDescriptorSetLayout(*m_device, &setLayoutCI, nullptr, &m_modelsSetLayout) != VK_SUCCESS) {
+            VK_ERROR("Example::SetupModelsPipeline() : failed to create descriptor set layout!");
+            return false;
+        }
+
+        const VkPushConstantRange pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT, 0, 4 * sizeof(uint32_t) };
+
+        auto pipelineLayoutCI = Tools::Initializers::PipelineLayoutCreateInfo(&m_modelsSetLayout, 1);
+        pipelineLayoutCI.pushConstantRangeCount = 1;
+        pipelineLayoutCI.pPushConstantRanges    = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(*m_device, &pipelineLayoutCI, nullptr, &m_modelsLayout) != VK_SUCCESS) {
+            VK_ERROR("Example::SetupModelsPipeline() : failed to create pipeline layout!");
+            return false;
+        }
+
+        const std::string out = cache + "/models.comp.spv";
+
+        system(std::string(Complexes::Shader::GetGlslCompiler() + " -c ")
+                .append(shaders + "/models.comp").append(" -o " + out).c_str());
+
+        auto shaderModule = Tools::LoadShaderModule(out.c_str(), *m_device);
+        if (shaderModule == VK_NULL_HANDLE) {
+            VK_ERROR("Example::SetupModelsPipeline() : failed to load shader module! \n\tPath: " + out);
+            return false;
+        }
+
+        auto pipelineCI = Tools::Initializers::ComputePipelineCreateInfo(m_modelsLayout);
+        pipelineCI.stage = Tools::Initializers::PipelineShaderStageCreateInfo(shaderModule, VK_SHADER_STAGE_COMPUTE_BIT);
+
+        auto result = vkCreateComputePipelines(*m_device, GetPipelineCache(), 1, &pipelineCI, nullptr, &m_modelsPipeline);
+
+        vkDestroyShaderModule(*m_device, shaderModule, nullptr);
+
+        if (result != VK_SUCCESS) {
+            VK_ERROR("Example::SetupModelsPipeline() : failed to create compute pipeline!");
+            m_modelsPipeline = VK_NULL_HANDLE;
+            return false;
+        }
+
+        this->m_modelsCmdBuffs.resize(GetFramesInFlight());
+
+        auto&& allocInfo = Tools::Initializers::CommandBufferAllocateInfo(*GetComputeCmdPool(), VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_modelsCmdBuffs.size());
+        if (vkAllocateCommandBuffers(*m_device, &allocInfo, m_modelsCmdBuffs.data()) != VK_SUCCESS) {
+            VK_ERROR("Example::SetupModelsPipeline() : failed to allocate compute command buffers!");
+            m_modelsCmdBuffs.clear();
+            return false;
+        }
+
         return true;
     }
 
+    bool SetupModels() {
+        auto&& queues = m_device->GetQueues();
+
+        /// written by the compute family and read by the graphics one, there are no ownership transfers
+        const uint32_t families[2] = { queues->GetGraphicsIndex(), queues->GetComputeIndex() };
+
+        auto bufferCI = Tools::Initializers::BufferCreateInfo(
+                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                GetModelOffset(GetFramesInFlight(), 0));
+
+        if (families[0] != families[1]) {
+            bufferCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            bufferCI.queueFamilyIndexCount = 2;
+            bufferCI.pQueueFamilyIndices   = families;
+        }
+
+        /// host visible for the CPU fallback, the vertex shaders read it from device local memory if they can
+        VmaAllocationCreateInfo allocCI = {};
+        allocCI.flags          = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocCI.usage          = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        allocCI.requiredFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        allocCI.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        VmaAllocationInfo allocInfo = {};
+
+        if (vmaCreateBuffer(*m_allocator, &bufferCI, &allocCI, &m_modelsBuffer, &m_modelsAllocation, &allocInfo) != VK_SUCCESS) {
+            VK_ERROR("Example::SetupModels() : failed to create models buffer!");
+            return false;
+        }
+
+        this->m_modelsMapped = static_cast<uint8_t*>(allocInfo.pMappedData);
+
+        if (m_modelsPipeline == VK_NULL_HANDLE)
+            return true;
+
+        this->m_modelsDescriptorSet = this->m_descriptorManager->AllocateDescriptorSets(m_modelsSetLayout, {
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+        });
+        if (m_modelsDescriptorSet.m_self == VK_NULL_HANDLE) {
+            VK_ERROR("Example::SetupModels() : failed to allocate descriptor set!");
+            return false;
+        }
+
+        VkDescriptorBufferInfo modelsDescriptor = { m_modelsBuffer, 0, VK_WHOLE_SIZE };
+
+        auto&& writeDescriptorSet = Tools::Initializers::WriteDescriptorSet(
+                m_modelsDescriptorSet.m_self, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &modelsDescriptor);
+        vkUpdateDescriptorSets(*m_device, 1, &writeDescriptorSet, 0, NULL);
+
+        return true;
+    }
+
+    /**
+     * @brief Writes model matrices of the frame on the compute queue
+     *
+     * @note The command buffer and the slot of the frame were used by the same frame in flight,
+     *       its fence has been waited by PrepareFrame(). The graphics submit waits for m_modelsValue.
+     */
+    bool DispatchModels(uint32_t frameIndex) {
+        if (m_modelsPipeline == VK_NULL_HANDLE)
+            return true;
+
+        auto&& cmd = m_modelsCmdBuffs[frameIndex];
+
+        struct {
+            float    time;
+            uint32_t count;
+            uint32_t first;
+            uint32_t stride;
+        } constants = {
+                std::chrono::duration<float>(std::chrono::steady_clock::now() - m_startTime).count(),
+                static_cast<uint32_t>(std::size(meshes)),
+                static_cast<uint32_t>(GetModelOffset(frameIndex, 0) / sizeof(glm::vec4)),
+                static_cast<uint32_t>(GetUniformStride(sizeof(ModelUniformBuffer)) / sizeof(glm::vec4))
+        };
+
+        VkCommandBufferBeginInfo cmdBufInfo = Tools::Initializers::CommandBufferBeginInfo();
+        cmdBufInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(cmd, &cmdBufInfo);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_modelsPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_modelsLayout, 0, 1, &m_modelsDescriptorSet.m_self, 0, NULL);
+        vkCmdPushConstants(cmd, m_modelsLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+        vkCmdDispatch(cmd, (constants.count + 63) / 64, 1, 1);
+
+        if (vkEndCommandBuffer(cmd) != VK_SUCCESS) {
+            VK_ERROR("Example::DispatchModels() : failed to end command buffer!");
+            return false;
+        }
+
+        /// doesn't wait for graphics, the queue overlaps with rasterization of the previous frame
+        return (m_modelsValue = SubmitCompute(&cmd, 1)) != 0;
+    }
+
     bool GenerateGeometry() {
         // Setup vertices for a single uv-mapped quad made from two triangles
         std::vector<VertexUV> vertices =
@@ -731,32 +1350,6 @@ public:
     }
 
     bool BuildCmdBuffers() override {
-        std::vector<VkClearValue> clearValues = {
-                VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // color
-                VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // resolve
-
-                VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // color
-                VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // resolve
-
-                VkClearValue{ .depthStencil = { 1.0f, 0 } } // depth
-        };
-
-        if (!m_multisampling) {
-            clearValues = {
-                    VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // color
-                    VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // color
-
-                    VkClearValue{ .depthStencil = { 1.0f, 0 } } // depth
-            };
-        }
-
-        VkRenderPassBeginInfo renderPassBeginInfo = m_offscreen->BeginRenderPass(&clearValues[0], clearValues.size());
-
-        m_offscreen->BeginCmd();
-        vkCmdBeginRenderPass(m_offscreen->GetCmd(), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        m_offscreen->SetViewportAndScissor();
-
         for (auto & _mesh : meshes) {
             std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
                     Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2,
@@ -765,58 +1358,59 @@ public:
             vkUpdateDescriptorSets(*m_device, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, NULL);
         }
 
-        {
-            vkCmdBindPipeline(m_offscreen->GetCmd(), VK_PIPELINE_BIND_POINT_GRAPHICS, *m_geometry);
-
-            for (auto & _mesh : meshes)
-                _mesh.Draw(m_offscreen->GetCmd(), m_geometry->GetPipelineLayout());
-        }
-
-        {
-            vkCmdBindPipeline(m_offscreen->m_cmdBuff, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_skyboxShader);
-
-            skybox.Draw(m_offscreen->m_cmdBuff, m_skyboxShader->GetPipelineLayout());
-        }
-
-        m_offscreen->End();
-
-        UpdatePP();
+        if (!UpdatePP())
+            return false;
 
-        return BuildCmdBuffersPostProcess();
-    }
+        if (m_offscreenPass < 0 && !AddPasses())
+            return false;
 
-    bool BuildCmdBuffersPostProcess() {
-        VkCommandBufferBeginInfo cmdBufInfo = Tools::Initializers::CommandBufferBeginInfo();
+        /// descriptor sets have been updated, the kernel re-records the passes on resize by itself
+        this->MarkAllPassesDirty();
 
-        VkClearValue clearValues[3] {
+        /// clear values of the swapchain render pass, the offscreen pass clears with values of the framebuffer
+        return RecordDirtyPasses({
                 { .color = {{0.5f, 0.5f, 0.5f, 1.0f}} },
                 { .color = {{0.5f, 0.5f, 0.5f, 1.0f}} },
                 { .depthStencil = { 1.0f, 0 } }
-        };
+        });
+    }
 
-        auto renderPassBI = Tools::Insert::RenderPassBeginInfo(
-                m_width, m_height, m_renderPass.m_self,
-                VK_NULL_HANDLE, &clearValues[0], 3);
+    bool AddPasses() {
+        /// items are the meshes and the skybox after them, a worker binds the pipeline of its first item.
+        /// The offscreen pass is recorded per frame in flight, Render() re-records it with the ring offsets of the frame
+        this->m_offscreenPass = AddRecordPass(m_offscreen, std::size(meshes) + 1, [this](VkCommandBuffer cmd, uint32_t frame, uint32_t first, uint32_t last) {
+            const uint32_t viewOffset   = m_frameUniforms[frame].view;
+            const uint32_t skyboxOffset = m_frameUniforms[frame].skybox;
 
-        for (int i = 0; i < 3; i++) {
-            renderPassBI.framebuffer = m_frameBuffers[i];
+            for (uint32_t i = first; i < last; ++i) {
+                if (i < std::size(meshes)) {
+                    if (i == first)
+                        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_geometry);
 
-            vkBeginCommandBuffer(m_drawCmdBuffs[i], &cmdBufInfo);
-            vkCmdBeginRenderPass(m_drawCmdBuffs[i], &renderPassBI, VK_SUBPASS_CONTENTS_INLINE);
+                    const uint32_t geometryOffsets[2] = { static_cast<uint32_t>(GetModelOffset(frame, i)), viewOffset };
 
-            VkViewport viewport = Tools::Initializers::Viewport((float)m_width, (float)m_height, 0.0f, 1.0f);
-            vkCmdSetViewport(m_drawCmdBuffs[i], 0, 1, &viewport);
+                    meshes[i].Draw(cmd, m_geometry->GetPipelineLayout(), 2, geometryOffsets);
+                }
+                else {
+                    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_skyboxShader);
+                    skybox.Draw(cmd, m_skyboxShader->GetPipelineLayout(), 1, &skyboxOffset);
+                }
+            }
+        }, true);
 
-            VkRect2D scissor = Tools::Initializers::Rect2D(m_width, m_height, 0, 0);
-            vkCmdSetScissor(m_drawCmdBuffs[i], 0, 1, &scissor);
+        this->m_postProcessPass = AddRecordPass(nullptr, 1, [this](VkCommandBuffer cmd, uint32_t, uint32_t first, uint32_t last) {
+            if (first == last)
+                return;
 
-            vkCmdBindPipeline(m_drawCmdBuffs[i], VK_PIPELINE_BIND_POINT_GRAPHICS, *m_postProcessing);
-            vkCmdBindDescriptorSets(m_drawCmdBuffs[i], VK_PIPELINE_BIND_POINT_GRAPHICS, m_postProcessing->GetPipelineLayout(), 0, 1, &m_PPDescriptorSet.m_self, 0, NULL);
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_postProcessing);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_postProcessing->GetPipelineLayout(), 0, 1, &m_PPDescriptorSet.m_self, 0, NULL);
 
-            vkCmdDraw(m_drawCmdBuffs[i], 3, 1, 0, 0);
+            vkCmdDraw(cmd, 3, 1, 0, 0);
+        });
 
-            vkCmdEndRenderPass(m_drawCmdBuffs[i]);
-            vkEndCommandBuffer(m_drawCmdBuffs[i]);
+        if (m_offscreenPass < 0 || m_postProcessPass < 0) {
+            VK_ERROR("Example::AddPasses() : failed to add record passes!");
+            return false;
         }
 
         return true;
@@ -836,7 +1430,25 @@ public:
             m_PPDescriptorSet = { VK_NULL_HANDLE, VK_NULL_HANDLE };
         }
 
-        EVSafeFreeObject(m_viewUniformBuffer);
+        if (!m_modelsCmdBuffs.empty())
+            vkFreeCommandBuffers(*m_device, *GetComputeCmdPool(), m_modelsCmdBuffs.size(), m_modelsCmdBuffs.data());
+        m_modelsCmdBuffs.clear();
+
+        if (m_modelsDescriptorSet.m_self != VK_NULL_HANDLE) {
+            this->m_descriptorManager->FreeDescriptorSet(m_modelsDescriptorSet);
+            m_modelsDescriptorSet = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+        }
+
+        if (m_modelsPipeline != VK_NULL_HANDLE)
+            vkDestroyPipeline(*m_device, m_modelsPipeline, nullptr);
+        if (m_modelsLayout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(*m_device, m_modelsLayout, nullptr);
+        if (m_modelsSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(*m_device, m_modelsSetLayout, nullptr);
+
+        if (m_modelsBuffer != VK_NULL_HANDLE)
+            vmaDestroyBuffer(*m_allocator, m_modelsBuffer, m_modelsAllocation);
+        m_modelsBuffer = VK_NULL_HANDLE;
 
         EVSafeFreeObject(m_geometry);
         EVSafeFreeObject(m_postProcessing);
@@ -856,8 +1468,15 @@ public:
     }
 
     bool OnComplete() override {
-        this->m_offscreen = Complexes::FrameBuffer::Create(
+        this->m_offscreen = CreateOffscreen();
+
+        return m_offscreen != nullptr;
+    }
+
+    Complexes::FrameBuffer* CreateOffscreen() {
+        return Complexes::FrameBuffer::Create(
                 m_device,
+                m_allocator,
                 m_descriptorManager,
                 m_swapchain,
                 m_cmdPool,
@@ -872,20 +1491,42 @@ public:
                 },
                 m_width,
                 m_height,
-                1.f);
+                1.f,
+                GetFramesInFlight());
+    }
 
+    bool OnResize() override {
         if (!m_offscreen)
+            return true;
+
+        /// frames in flight still render into the old attachments and sample them, so the framebuffer
+        /// and the post processing set are replaced and released when the frames are completed
+        auto&& offscreen = CreateOffscreen();
+        if (!offscreen) {
+            VK_ERROR("Example::OnResize() : failed to re-create offscreen framebuffer!");
+            return false;
+        }
+
+        this->DeferredFree(m_offscreen);
+        this->m_offscreen = offscreen;
+
+        auto&& descriptorSet = this->m_descriptorManager->AllocateDescriptorSets(m_postProcessing->GetDescriptorSetLayout(), {
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+        });
+        if (descriptorSet.m_self == VK_NULL_HANDLE) {
+            VK_ERROR("Example::OnResize() : failed to allocate post processing descriptor set!");
             return false;
+        }
 
-        return true;
-    }
+        this->DeferredDestroy([descriptorManager = m_descriptorManager, oldSet = m_PPDescriptorSet]() {
+            descriptorManager->FreeDescriptorSet(oldSet);
+        });
+        this->m_PPDescriptorSet = descriptorSet;
 
-    bool OnResize() override {
-        vkQueueWaitIdle(m_device->GetGraphicsQueue());
-        vkDeviceWaitIdle(*m_device);
+        if (m_offscreenPass >= 0)
+            this->SetPassTarget(m_offscreenPass, m_offscreen);
 
-        return m_offscreen ? (this->m_offscreen->ReCreate(m_width, m_height) && UpdatePP()) : true;
-        //return true;
+        return UpdatePP();
     }
 };
 
@@ -96,8 +96,11 @@ private:
     mesh meshes[3];
 public:
     void Render() override {
-        if (this->PrepareFrame() == Core::FrameResult::OutOfDate)
+        /// the image isn't acquired, the frame is skipped
+        if (this->PrepareFrame() == Core::FrameResult::OutOfDate) {
             this->m_hasErrors = !this->ResizeWindow();
+            return;
+        }
 
         // Command buffer to be submitted to the queue
         m_submitInfo.commandBufferCount = 1;
@@ -4,6 +4,11 @@
 
 #include "UnitTests/Example.h"
 
+#include <EvoVulkan/Tools/HeapGuard.h>
+
+/// counts allocations of the frame loop, see VulkanKernel::SetHeapGuard()
+EVK_HEAP_GUARD_OPERATORS
+
 int main() {
     auto* kernel = new VulkanExample();
 
@@ -32,32 +37,45 @@ int main() {
 
     //!=================================================================================================================
 
-    glfwInit();
-
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-
     unsigned int width     = 600;  //1280
     unsigned int height    = 600;  //820
     bool validationEnabled = true;
+    bool renderThread      = false;
+    bool benchmark         = false;
+    /// no window, renders headlessFrames frames and reads the last one back (e.g. lavapipe in CI)
+    bool headless          = false;
+    uint32_t headlessFrames = 300;
 
-    auto window = glfwCreateWindow((int)width, (int)height, "Vulkan application", nullptr, nullptr); //1280, 1024
-    glfwSetWindowSizeCallback(window, [](GLFWwindow* window, int width, int height) {
-        auto kernel = static_cast<Core::VulkanKernel*>(glfwGetWindowUserPointer(window));
-        kernel->SetSize(width, height);
-    });
+    GLFWwindow* window = nullptr;
 
-    //!=================================================================================================================
+    if (!headless) {
+        glfwInit();
 
-    glfwSetWindowUserPointer(window, (void*)kernel);
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+        window = glfwCreateWindow((int)width, (int)height, "Vulkan application", nullptr, nullptr); //1280, 1024
+        glfwSetWindowSizeCallback(window, [](GLFWwindow* window, int width, int height) {
+            auto kernel = static_cast<Core::VulkanKernel*>(glfwGetWindowUserPointer(window));
+            kernel->SetSize(width, height);
+        });
+
+        glfwSetWindowUserPointer(window, (void*)kernel);
+    }
+    else
+        kernel->SetHeadless(true);
+
+    //!=================================================================================================================
 
     kernel->SetValidationLayersEnabled(validationEnabled);
     kernel->SetSize(width, height);
     kernel->SetMultisampling(8);
 
     std::vector<const char*> extensions;
-    extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
-    extensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+    if (!headless) {
+        extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+        extensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+    }
 
     if (validationEnabled)
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -80,9 +98,14 @@ int main() {
             return surfaceKhr;
     };
 
+    std::vector<const char*> deviceExtensions;
+    if (!headless)
+        deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
     if (!kernel->Init(
             surfCreate,
-            { VK_KHR_SWAPCHAIN_EXTENSION_NAME },
+            (void*)window,
+            deviceExtensions,
             true, // sample shading
             true  // vsync
     )) {
@@ -103,15 +126,33 @@ int main() {
     if (!kernel->LoadCubeMap())
         return -1;
 
+    if (benchmark && !kernel->BenchmarkTextureUpload())
+        return -1;
+
+    if (benchmark && !kernel->BenchmarkMipGeneration(
+            R"(J:\C++\GameEngine\Engine\Dependences\Framework\Depends\EvoVulkan\Resources\Shaders)",
+            "J://C++/EvoVulkan/Resources/Cache"))
+    {
+        return -1;
+    }
+
     if (!kernel->SetupShader())
         return -1;
 
     if (!kernel->SetupUniforms())
         return -1;
 
+    /// binds descriptor sets of the skybox layout
+    if (benchmark && !kernel->BenchmarkUniformRing())
+        return -1;
+
     if (!kernel->GenerateGeometry())
         return -1;
 
+    /// the post processing pipeline draws, the command buffers are built after it
+    if (benchmark && !kernel->BenchmarkParallelRecording())
+        return -1;
+
     std::vector<EvoVulkan::Core::DescriptorSet> descriptors;
     for (uint32_t i = 0; i < 100000; i++)
         descriptors.emplace_back(kernel->GetDescriptorManager()->AllocateDescriptorSets(
@@ -121,14 +162,9 @@ int main() {
     for (auto& descriptor : descriptors)
         kernel->GetDescriptorManager()->FreeDescriptorSet(descriptor);
 
-    /*std::array<Types::Buffer*, 4000> buffers = { };
-    for (auto& buffer : buffers) {
-        buffer = Types::Buffer::Create(
-                kernel->GetDevice(),
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-                16);
-    }*/
+    /// small buffers share blocks of the allocator pools, the count isn't limited by maxMemoryAllocationCount
+    if (benchmark && !kernel->BenchmarkBufferCount())
+        return -1;
 
 #ifdef EVOVULKAN_EXAMPLE_H
     kernel->LoadSkybox();
@@ -138,14 +174,60 @@ int main() {
 
     std::cout << kernel->GetDevice()->GetAllocatedHeapsCount() << std::endl;
 
+    /// steady-state frames must not touch the heap, the guard counts allocations of every frame and costs time
+    if (benchmark)
+        kernel->SetHeapGuard(true);
+
+    /// the first frame is read back asynchronously, it's within the heap guard warmup
+    if (benchmark)
+        kernel->RequestScreenshot();
+
+    if (headless) {
+        const auto begin = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < headlessFrames && !kernel->HasErrors(); ++i)
+            kernel->NextFrame();
+
+        const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        std::vector<uint8_t> pixels;
+        const bool succeeded = !kernel->HasErrors() && kernel->ReadPixels(kernel->GetPresentedImageIndex(), pixels);
+
+        if (succeeded)
+            std::cout << headlessFrames << " headless frames: " << time / headlessFrames << " ms per frame, "
+                      << pixels.size() << " bytes read back\n";
+        else
+            std::cout << "Failed to render headless frames!\n";
+
+        kernel->Destroy();
+
+        delete kernel;
+
+        return succeeded ? 0 : -1;
+    }
+
+    if (renderThread && !kernel->StartRenderThread())
+        return -1;
+
     while (!glfwWindowShouldClose(window) && !kernel->HasErrors()) {
         glfwPollEvents();
 
-        kernel->NextFrame();
+        /// uniforms are written by the late latch right before the submission
+        kernel->MarkInputSample();
+
+        if (renderThread) {
+            /// render thread is behind, the packet is dropped and events are polled again when it takes one
+            if (!kernel->PushFramePacket(EvoVulkan::Core::FramePacket()))
+                kernel->WaitFramePacketSlot(std::chrono::milliseconds(16));
+
+            continue;
+        }
 
-        kernel->UpdateUBO();
+        kernel->NextFrame();
     }
 
+    const uint64_t heapGuardViolations = kernel->GetHeapGuardViolations();
+
     kernel->Destroy();
 
     delete kernel;
@@ -153,5 +235,10 @@ int main() {
     glfwDestroyWindow(window);
     glfwTerminate();
 
+    if (benchmark && heapGuardViolations > 0) {
+        std::cout << "Steady-state frames have allocated from the heap " << heapGuardViolations << " times!\n";
+        return -1;
+    }
+
     return 0;
 }
\ No newline at end of file